@@ -415,6 +415,10 @@ Ray Camera::pointsToRay(float x, float y) {
 }
 
 bool Camera::isInside(const AlignedBox& box){
+    return isInside(box, true);
+}
+
+bool Camera::isInside(const AlignedBox& box, bool testNearPlane){
 
     if (box.isNull() || box.isInfinite())
         return false;
@@ -427,6 +431,8 @@ bool Camera::isInside(const AlignedBox& box){
     for (int plane = 0; plane < 6; ++plane){
         if (plane == FRUSTUM_PLANE_FAR && getFar() == 0)
             continue;
+        if (plane == FRUSTUM_PLANE_NEAR && !testNearPlane)
+            continue;
 
         Plane::Side side = frustumPlanes[plane].getSide(centre, halfSize);
         if (side == Plane::NEGATIVE_SIDE){
@@ -532,6 +538,8 @@ void Camera::updateProjectionMatrix(){
 
 void Camera::updateViewProjectionMatrix(){
     viewProjectionMatrix = projectionMatrix * viewMatrix;
+
+    needUpdateFrustumPlanes = true;
 }
 
 void Camera::updateModelMatrix(){
@@ -128,6 +128,8 @@ namespace Supernova {
         Ray pointsToRay(float normalized_x, float normalized_y);
 
         bool isInside(const AlignedBox& box);
+        //Without near plane is like the frustum extruded to infinity behind camera
+        bool isInside(const AlignedBox& box, bool testNearPlane);
         bool isInside(const Vector3& point);
         bool isInside(const Vector3& center, const float& radius);
 
@@ -1,7 +1,6 @@
 #include "DirectionalLight.h"
 #include "math/Angle.h"
 #include "Scene.h"
-#include "util/UniqueToken.h"
 #include <algorithm>
 
 using namespace Supernova;
@@ -179,6 +178,10 @@ int DirectionalLight::getNumShadowCascades(){
     return numShadowCascades;
 }
 
+int DirectionalLight::getNumShadowPasses(){
+    return numShadowCascades;
+}
+
 float DirectionalLight::getShadowSplitLogFactor(){
     return shadowSplitLogFactor;
 }
@@ -220,13 +223,6 @@ bool DirectionalLight::loadShadow(){
             if (cascadeCameraNearFar.size() < (ca+1))
                 cascadeCameraNearFar.push_back(Vector2());
 
-            if (shadowMap.size() < (ca+1)) {
-                shadowMap.push_back(new Texture(shadowMapWidth, shadowMapHeight));
-
-                shadowMap[ca]->setId("shadowMap|" + UniqueToken::get());
-                shadowMap[ca]->setType(S_TEXTURE_DEPTH_FRAME);
-            }
-
         }
 
         updateLightCamera();
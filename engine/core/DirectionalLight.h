@@ -37,6 +37,7 @@ namespace Supernova {
 
         Vector2 getCascadeCameraNearFar(int index);
         int getNumShadowCascades();
+        virtual int getNumShadowPasses();
         float getShadowSplitLogFactor();
 
         virtual void updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatrix, Matrix4* viewProjectionMatrix, Vector3* cameraPosition);
@@ -22,6 +22,8 @@
 //#include "Mesh.h"
 
 #include "audio/SoundManager.h"
+#include "util/AsyncLoader.h"
+#include "util/JobSystem.h"
 #include "system/System.h"
 #include "Input.h"
 
@@ -54,13 +56,30 @@ bool Engine::fixedTimePhysics;
 bool Engine::fixedTimeAnimations;
 
 unsigned long Engine::lastTime = 0;
+unsigned long (*Engine::clockFunction)() = NULL;
 float Engine::updateTimeCount = 0;
+unsigned long Engine::updateSteps = 0;
+
+float Engine::maxFrameDelta = 0.25;
+unsigned int Engine::maxUpdateSteps = 8;
+float Engine::droppedTime = 0;
+float Engine::updateAlpha = 0;
 
 float Engine::deltatime = 0;
+float Engine::frameWorkTime = 0;
 float Engine::framerate = 0;
 
 float Engine::updateTime = 0.03;
 
+float Engine::asyncLoadTimeBudget = 0.004;
+
+bool Engine::renderOnDemand = false;
+bool Engine::redrawRequested = true;
+
+unsigned int Engine::evaluatedSkeletons = 0;
+unsigned int Engine::interpolatedSkeletons = 0;
+unsigned int Engine::skippedSkeletons = 0;
+
 //-----Supernova user events-----
 FunctionSubscribe<void()> Engine::onCanvasLoaded;
 FunctionSubscribe<void()> Engine::onCanvasChanged;
@@ -217,6 +236,87 @@ float Engine::getSceneUpdateTime(){
     }
 }
 
+void Engine::setMaxFrameDelta(unsigned int maxFrameDeltaMS){
+    Engine::maxFrameDelta = maxFrameDeltaMS / 1000.0f;
+}
+
+float Engine::getMaxFrameDelta(){
+    return Engine::maxFrameDelta;
+}
+
+void Engine::setMaxUpdateSteps(unsigned int maxUpdateSteps){
+    Engine::maxUpdateSteps = maxUpdateSteps;
+}
+
+unsigned int Engine::getMaxUpdateSteps(){
+    return Engine::maxUpdateSteps;
+}
+
+float Engine::getDroppedTime(){
+    return Engine::droppedTime;
+}
+
+float Engine::getUpdateAlpha(){
+    return Engine::updateAlpha;
+}
+
+unsigned long Engine::getUpdateSteps(){
+    return Engine::updateSteps;
+}
+
+void Engine::setClockFunction(unsigned long (*clockFunction)()){
+    Engine::clockFunction = clockFunction;
+    lastTime = getClockTime();
+}
+
+unsigned long Engine::getClockTime(){
+    if (clockFunction)
+        return clockFunction();
+
+    auto now = std::chrono::steady_clock::now();
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+}
+
+void Engine::setAsyncLoadTimeBudget(unsigned int timeBudgetMS){
+    Engine::asyncLoadTimeBudget = timeBudgetMS / 1000.0f;
+}
+
+float Engine::getAsyncLoadTimeBudget(){
+    return Engine::asyncLoadTimeBudget;
+}
+
+void Engine::setAsyncLoadThreads(unsigned int numThreads){
+    AsyncLoader::setNumThreads(numThreads);
+}
+
+unsigned int Engine::getAsyncLoadThreads(){
+    return AsyncLoader::getNumThreads();
+}
+
+void Engine::setRenderOnDemand(bool renderOnDemand){
+    Engine::renderOnDemand = renderOnDemand;
+    requestRedraw();
+}
+
+bool Engine::isRenderOnDemand(){
+    return Engine::renderOnDemand;
+}
+
+void Engine::requestRedraw(){
+    Engine::redrawRequested = true;
+}
+
+unsigned int Engine::getEvaluatedSkeletons(){
+    return Engine::evaluatedSkeletons;
+}
+
+unsigned int Engine::getInterpolatedSkeletons(){
+    return Engine::interpolatedSkeletons;
+}
+
+unsigned int Engine::getSkippedSkeletons(){
+    return Engine::skippedSkeletons;
+}
 
 int Engine::getPlatform(){
     
@@ -243,6 +343,10 @@ float Engine::getDeltatime(){
     return deltatime;
 }
 
+float Engine::getFrameWorkTime(){
+    return frameWorkTime;
+}
+
 void Engine::systemStart(){
 
     Engine::setCanvasSize(1000,480);
@@ -255,8 +359,10 @@ void Engine::systemStart(){
     Engine::setDefaultResampleToPOTTexture(true);
     Engine::setFixedTimeSceneUpdate(false);
     
-    auto now = std::chrono::steady_clock::now();
-    lastTime = (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    lastTime = getClockTime();
+    
+    //Job system worker 0 is the main thread
+    JobSystem::init();
     
     LuaBinding::createLuaState();
     LuaBinding::bind();
@@ -266,6 +372,7 @@ void Engine::systemStart(){
 }
 
 void Engine::systemSurfaceCreated(){
+    requestRedraw();
 
     if (Engine::getScene() != NULL){
         (Engine::getScene())->load();
@@ -330,43 +437,77 @@ void Engine::systemSurfaceChanged() {
         (Engine::getScene())->updateCameraSize();
     }
 
+    requestRedraw();
+
     onCanvasChanged.call();
 }
 
-void Engine::systemDraw() {
+bool Engine::systemDraw() {
     
-    auto now = std::chrono::steady_clock::now();
-    unsigned long newTime = (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+    auto workStart = std::chrono::steady_clock::now();
+    unsigned long newTime = getClockTime();
     
     deltatime = (newTime - lastTime) / 1000.0f;
     lastTime = newTime;
     framerate = 1 / (float)deltatime;
+
+    //Render uploads of async loaded resources are done here, in main thread
+    if (AsyncLoader::processCompleted(asyncLoadTimeBudget) > 0)
+        requestRedraw();
     
-    int updateLoops = 0;
-    updateTimeCount += deltatime;
-    while (updateTimeCount >= updateTime && updateLoops <= 100){
+    evaluatedSkeletons = 0;
+    interpolatedSkeletons = 0;
+    skippedSkeletons = 0;
+
+    //Avoids spiral of death: a long frame can not make next frames simulate even more
+    float frameDelta = deltatime;
+    if (frameDelta > maxFrameDelta){
+        droppedTime += frameDelta - maxFrameDelta;
+        frameDelta = maxFrameDelta;
+    }
+
+    unsigned int updateLoops = 0;
+    updateTimeCount += frameDelta;
+    while (updateTimeCount >= updateTime && updateLoops < maxUpdateSteps){
         updateLoops++;
         updateTimeCount -= updateTime;
+        updateSteps++;
 
         Engine::onUpdate.call();
 
         if (isFixedTimeSceneUpdate() && Engine::getScene())
             (Engine::getScene())->update();
     }
-    if (updateLoops > 100){
-        Log::Warn("More than 100 updates in a frame");
+    if (updateTime > 0 && updateTimeCount >= updateTime){
+        float remaining = fmod(updateTimeCount, updateTime);
+        droppedTime += updateTimeCount - remaining;
+        updateTimeCount = remaining;
     }
 
+    updateAlpha = (updateTime > 0) ? (updateTimeCount / updateTime) : 0;
+
     if (!isFixedTimeSceneUpdate() && Engine::getScene())
         (Engine::getScene())->update();
 
     Engine::onDraw.call();
 
-    if (Engine::getScene())
-        (Engine::getScene())->draw();
+    //GLSurfaceView always swaps buffers after draw callback, so Android draws all frames
+    bool drawFrame = true;
+    if (renderOnDemand && getPlatform() != S_PLATFORM_ANDROID)
+        drawFrame = redrawRequested || (Engine::getScene() && (Engine::getScene())->isRedrawRequested());
+
+    if (drawFrame) {
+        redrawRequested = false;
+
+        if (Engine::getScene())
+            (Engine::getScene())->draw();
+
+        frameWorkTime = std::chrono::duration<float>(std::chrono::steady_clock::now() - workStart).count();
+    }
     
     SoundManager::checkActive();
-    
+
+    return drawFrame;
 }
 
 void Engine::systemPause(){
@@ -375,6 +516,12 @@ void Engine::systemPause(){
 
 void Engine::systemResume(){
     SoundManager::resumeAll();
+    requestRedraw();
+}
+
+void Engine::systemShutdown(){
+    AsyncLoader::deInit();
+    JobSystem::deInit();
 }
 
 bool Engine::transformCoordPos(float& x, float& y){
@@ -388,6 +535,8 @@ bool Engine::transformCoordPos(float& x, float& y){
 }
 
 void Engine::systemTouchStart(int pointer, float x, float y){
+    requestRedraw();
+
     if (transformCoordPos(x, y)){
         //-----------------
         Engine::onTouchStart.call(pointer, x, y);
@@ -405,6 +554,8 @@ void Engine::systemTouchStart(int pointer, float x, float y){
 }
 
 void Engine::systemTouchEnd(int pointer, float x, float y){
+    requestRedraw();
+
     if (transformCoordPos(x, y)){
         //-----------------
         Engine::onTouchEnd.call(pointer, x, y);
@@ -422,6 +573,8 @@ void Engine::systemTouchEnd(int pointer, float x, float y){
 }
 
 void Engine::systemTouchDrag(int pointer, float x, float y){
+    requestRedraw();
+
     if (transformCoordPos(x, y)){
         //-----------------
         Engine::onTouchDrag.call(pointer, x, y);
@@ -437,6 +590,8 @@ void Engine::systemTouchDrag(int pointer, float x, float y){
 }
 
 void Engine::systemMouseDown(int button, float x, float y){
+    requestRedraw();
+
     if (transformCoordPos(x, y)){
         //-----------------
         Engine::onMouseDown.call(button, x, y);
@@ -453,6 +608,8 @@ void Engine::systemMouseDown(int button, float x, float y){
     }
 }
 void Engine::systemMouseUp(int button, float x, float y){
+    requestRedraw();
+
     if (transformCoordPos(x, y)){
         //-----------------
         Engine::onMouseUp.call(button, x, y);
@@ -470,6 +627,8 @@ void Engine::systemMouseUp(int button, float x, float y){
 }
 
 void Engine::systemMouseDrag(int button, float x, float y){
+    requestRedraw();
+
     if (transformCoordPos(x, y)){
         //-----------------
         Engine::onMouseDrag.call(button, x, y);
@@ -485,6 +644,8 @@ void Engine::systemMouseDrag(int button, float x, float y){
 }
 
 void Engine::systemMouseMove(float x, float y){
+    requestRedraw();
+
     if (transformCoordPos(x, y)){
         //-----------------
         Engine::onMouseMove.call(x, y);
@@ -494,6 +655,8 @@ void Engine::systemMouseMove(float x, float y){
 }
 
 void Engine::systemKeyDown(int inputKey){
+    requestRedraw();
+
     //-----------------
     Engine::onKeyDown.call(inputKey);
     Input::addKeyPressed(inputKey);
@@ -501,6 +664,8 @@ void Engine::systemKeyDown(int inputKey){
 }
 
 void Engine::systemKeyUp(int inputKey){
+    requestRedraw();
+
     //-----------------
     Engine::onKeyUp.call(inputKey);
     Input::releaseKeyPressed(inputKey);
@@ -508,5 +673,7 @@ void Engine::systemKeyUp(int inputKey){
 }
 
 void Engine::systemTextInput(const char* text){
+    requestRedraw();
+
     onTextInput.call(text);
 }
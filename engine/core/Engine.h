@@ -27,6 +27,8 @@ namespace Supernova {
     };
 
     class Engine {
+
+        friend class Model;
         
     private:
         //-----Supernova config-----
@@ -52,14 +54,33 @@ namespace Supernova {
         static bool fixedTimeAnimations;
 
         static unsigned long lastTime;
+        static unsigned long (*clockFunction)();
         static float updateTimeCount;
+        static unsigned long updateSteps;
+
+        static float maxFrameDelta;
+        static unsigned int maxUpdateSteps;
+        static float droppedTime;
+        static float updateAlpha;
         
         static float deltatime;
+        static float frameWorkTime;
         static float framerate;
         
         static float updateTime;
+
+        static float asyncLoadTimeBudget;
+
+        static bool renderOnDemand;
+        static bool redrawRequested;
+
+        //Skinned models with running animations in current frame
+        static unsigned int evaluatedSkeletons;
+        static unsigned int interpolatedSkeletons;
+        static unsigned int skippedSkeletons;
         
         static bool transformCoordPos(float& x, float& y);
+        static unsigned long getClockTime();
 
     public:
         
@@ -109,19 +130,57 @@ namespace Supernova {
         static float getUpdateTime();
 
         static float getSceneUpdateTime();
+
+        //Longer frames (hitches) are clamped to this delta
+        static void setMaxFrameDelta(unsigned int maxFrameDeltaMS);
+        static float getMaxFrameDelta();
+
+        //Fixed updates in a frame, time of remaining updates is dropped
+        static void setMaxUpdateSteps(unsigned int maxUpdateSteps);
+        static unsigned int getMaxUpdateSteps();
+
+        //Total time not simulated because of frame delta or update steps limit
+        static float getDroppedTime();
+        //Fraction of fixed update time not yet simulated, used to interpolate rendering
+        static float getUpdateAlpha();
+        static unsigned long getUpdateSteps();
+
+        //Milliseconds source of frame time, NULL uses steady clock. Used to test with fake clocks
+        static void setClockFunction(unsigned long (*clockFunction)());
+
+        static void setAsyncLoadTimeBudget(unsigned int timeBudgetMS);
+        static float getAsyncLoadTimeBudget();
+
+        static void setAsyncLoadThreads(unsigned int numThreads);
+        static unsigned int getAsyncLoadThreads();
+
+        //Frames are drawn only when scene changed, input arrived or requestRedraw was called
+        static void setRenderOnDemand(bool renderOnDemand);
+        static bool isRenderOnDemand();
+        static void requestRedraw();
+
+        //Animated skeletons sampled, interpolated by animation LOD or paused when culled in last frame
+        static unsigned int getEvaluatedSkeletons();
+        static unsigned int getInterpolatedSkeletons();
+        static unsigned int getSkippedSkeletons();
         
         static int getPlatform();
         static float getFramerate();
         static float getDeltatime();
+        //Seconds spent in updates and draw of last drawn frame, without waiting for swap
+        static float getFrameWorkTime();
         
         //-----Supernova API functions-----
         static void systemStart();
         static void systemSurfaceCreated();
         static void systemSurfaceChanged();
-        static void systemDraw();
+        //Returns false when frame was not drawn and buffer must not be swapped
+        static bool systemDraw();
 
         static void systemPause();
         static void systemResume();
+        //Joins loader and job threads, called when application is terminating
+        static void systemShutdown();
 
         static void systemTouchStart(int pointer, float x, float y);
         static void systemTouchEnd(int pointer, float x, float y);
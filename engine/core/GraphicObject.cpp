@@ -11,12 +11,19 @@ using namespace Supernova;
 GraphicObject::GraphicObject(): Object(){
     visible = true;
     transparent = false;
+    castShadows = true;
     distanceToCamera = -1;
 
+    needUpdateLocalBounds = true;
+    needUpdateWorldBounds = true;
+
     minBufferSize = 0;
 
+    lightList = NULL;
+
     render = NULL;
     shadowRender = NULL;
+    shadowRenderLoaded = false;
 
     material = NULL;
 
@@ -28,6 +35,9 @@ GraphicObject::GraphicObject(): Object(){
 GraphicObject::~GraphicObject(){
     if (material)
         delete material;
+
+    if (lightList)
+        delete lightList;
 }
 
 void GraphicObject::instanciateMaterial(){
@@ -62,6 +72,8 @@ void GraphicObject::setColor(Vector4 color){
         transparent = true;
     }
     material->setColor(color);
+
+    requestRedraw();
 }
 
 void GraphicObject::setColor(float red, float green, float blue, float alpha){
@@ -84,6 +96,7 @@ void GraphicObject::setTexture(Texture* texture){
         material->setTexture(texture);
 
         textureLoad();
+        requestRedraw();
     }
 }
 
@@ -97,6 +110,7 @@ void GraphicObject::setTexture(std::string texturepath){
         material->setTexturePath(texturepath);
 
         textureLoad();
+        requestRedraw();
     }
 }
 
@@ -112,8 +126,19 @@ Material* GraphicObject::getMaterial(){
     return this->material;
 }
 
+void GraphicObject::updateBuffer(std::string name, size_t offset, size_t size){
+    if (render)
+        render->updateBufferRange(name, offset, size);
+    if (shadowRender)
+        shadowRender->updateBufferRange(name, offset, size);
+
+    requestRedraw();
+}
+
 void GraphicObject::updateBuffer(std::string name){
     if (name == defaultBuffer) {
+        needUpdateLocalBounds = true;
+        needUpdateWorldBounds = true;
         if (render)
             render->setVertexSize(buffers[name]->getCount());
         if (shadowRender)
@@ -123,6 +148,8 @@ void GraphicObject::updateBuffer(std::string name){
         render->updateBuffer(name, buffers[name]->getSize(), buffers[name]->getData());
     if (shadowRender)
         shadowRender->updateBuffer(name, buffers[name]->getSize(), buffers[name]->getData());
+
+    requestRedraw();
 }
 
 Matrix4 GraphicObject::getNormalMatrix(){
@@ -134,13 +161,93 @@ unsigned int GraphicObject::getMinBufferSize(){
 }
 
 void GraphicObject::setVisible(bool visible){
-    this->visible = visible;
+    if (this->visible != visible){
+        this->visible = visible;
+        if (scene)
+            scene->shadowCastersVersion++;
+        requestRedraw();
+    }
 }
 
 bool GraphicObject::isVisible(){
     return visible;
 }
 
+void GraphicObject::setCastShadows(bool castShadows){
+    if (this->castShadows != castShadows){
+        this->castShadows = castShadows;
+        if (scene)
+            scene->shadowCastersVersion++;
+    }
+}
+
+bool GraphicObject::isCastShadows(){
+    return castShadows;
+}
+
+void GraphicObject::updateLocalBounds(){
+    localBounds.setNull();
+
+    if (buffers.count(defaultBuffer) == 0)
+        return;
+
+    Buffer* buffer = buffers[defaultBuffer];
+    Attribute* attVertex = buffer->getAttribute(S_VERTEXATTRIBUTE_VERTICES);
+    if (!attVertex)
+        return;
+
+    for (unsigned int i = 0; i < buffer->getCount(); i++){
+        localBounds.merge(buffer->getVector3(attVertex, i));
+    }
+}
+
+AlignedBox GraphicObject::getLocalBounds(){
+    if (needUpdateLocalBounds){
+        updateLocalBounds();
+        needUpdateLocalBounds = false;
+        needUpdateWorldBounds = true;
+    }
+
+    return localBounds;
+}
+
+AlignedBox GraphicObject::getWorldBounds(){
+    AlignedBox box = getLocalBounds();
+
+    if (needUpdateWorldBounds){
+        worldBounds = box;
+        worldBounds.transformAffine(modelMatrix);
+        needUpdateWorldBounds = false;
+    }
+
+    return worldBounds;
+}
+
+bool GraphicObject::isInsideShadowCamera(){
+    if (!scene->shadowCastersCulling)
+        return true;
+
+    AlignedBox box = getWorldBounds();
+    //Unknown bounds
+    if (box.isNull() || box.isInfinite())
+        return true;
+
+    //Directional light casters between light and cascade still cast inside it
+    return scene->getCamera()->isInside(box, !scene->drawIsDirectionalShadow);
+}
+
+void GraphicObject::updateLightList(){
+    if (!lightList || !scene)
+        return;
+
+    AlignedBox box = getWorldBounds();
+    if (box.isNull() || box.isInfinite()){
+        lightList->update(&scene->lightData, getWorldPosition(), 0);
+    }else{
+        lightList->update(&scene->lightData, box.getCenter(), box.getHalfSize().length());
+    }
+}
+
 void GraphicObject::updateDistanceToCamera(){
     distanceToCamera = (this->cameraPosition - this->getWorldPosition()).length();
 }
@@ -159,22 +266,43 @@ void GraphicObject::updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatri
 }
 
 void GraphicObject::updateModelMatrix(){
+    //Last evaluated bounds, as drawn in cached shadow maps
+    AlignedBox previousBounds = worldBounds;
+
     Object::updateModelMatrix();
     
     this->normalMatrix.identity();
 
+    needUpdateWorldBounds = true;
+
+    if (scene && castShadows && visible)
+        scene->updateShadowCaster(this, previousBounds);
+
     updateDistanceToCamera();
 }
 
+bool GraphicObject::isInsideScissor(){
+    //Scissor of a parent is active only while its children are drawn in tree order
+    SceneRender* sceneRender = scene->getSceneRender();
+    return (sceneRender && sceneRender->isEnabledScissor());
+}
+
 bool GraphicObject::draw(){
 
     bool drawReturn = false;
 
     if (scene && scene->isDrawingShadow()){
-        renderDraw(true);
+        if (castShadows && visible){
+            if (!isInsideShadowCamera())
+                scene->shadowCulledCasters++;
+            else if (renderDraw(true))
+                scene->shadowDrawCalls++;
+        }
     }else{
         if (transparent && scene && scene->useDepth && distanceToCamera >= 0){
             scene->transparentQueue.insert(std::make_pair(distanceToCamera, this));
+        }else if (visible && scene && scene->useDepth && scene->opaqueSorting && scissor.isZero() && !isInsideScissor() && distanceToCamera >= 0){
+            scene->opaqueQueue.insert(std::make_pair(distanceToCamera, this));
         }else{
             if (visible)
                 renderDraw(false);
@@ -257,6 +385,7 @@ bool GraphicObject::renderLoad(bool shadow){
         render->addProperty(S_PROPERTY_MODELMATRIX, S_PROPERTYDATA_MATRIX4, 1, &modelMatrix);
         render->addProperty(S_PROPERTY_NORMALMATRIX, S_PROPERTYDATA_MATRIX4, 1, &normalMatrix);
         render->addProperty(S_PROPERTY_MVPMATRIX, S_PROPERTYDATA_MATRIX4, 1, &modelViewProjectionMatrix);
+        //Replaced by scene camera when object is in a scene
         render->addProperty(S_PROPERTY_CAMERAPOS, S_PROPERTYDATA_FLOAT3, 1, &cameraPosition);
 
         if (material) {
@@ -270,7 +399,18 @@ bool GraphicObject::renderLoad(bool shadow){
 
             render->setSceneRender(scene->getSceneRender());
 
-            scene->addLightProperties(render);
+            scene->addCameraProperties(render);
+            if (scene->getMaxLightsPerObject() > 0){
+                if (!lightList)
+                    lightList = new LightList();
+                scene->addLightProperties(render, lightList);
+            }else{
+                if (lightList){
+                    delete lightList;
+                    lightList = NULL;
+                }
+                scene->addLightProperties(render);
+            }
             scene->addFogProperties(render);
         }
 
@@ -297,12 +437,16 @@ bool GraphicObject::renderLoad(bool shadow){
         shadowRender->addProperty(S_PROPERTY_CAMERAPOS, S_PROPERTYDATA_FLOAT3, 1, &cameraPosition);
 
         if (scene){
-            shadowRender->addProperty(S_PROPERTY_SHADOWLIGHT_POS, S_PROPERTYDATA_FLOAT3, 1, &scene->drawShadowLightPos);
-            shadowRender->addProperty(S_PROPERTY_SHADOWCAMERA_NEARFAR, S_PROPERTYDATA_FLOAT2, 1, &scene->drawShadowCameraNearFar);
-            shadowRender->addProperty(S_PROPERTY_ISPOINTSHADOW, S_PROPERTYDATA_INT1, 1, &scene->drawIsPointShadow);
+            shadowRender->setSceneRender(scene->getSceneRender());
+
+            shadowRender->addGlobalProperty(S_PROPERTY_SHADOWLIGHT_POS, S_PROPERTYDATA_FLOAT3, 1, &scene->drawShadowLightPos);
+            shadowRender->addGlobalProperty(S_PROPERTY_SHADOWCAMERA_NEARFAR, S_PROPERTYDATA_FLOAT2, 1, &scene->drawShadowCameraNearFar);
+            shadowRender->addGlobalProperty(S_PROPERTY_ISPOINTSHADOW, S_PROPERTYDATA_INT1, 1, &scene->drawIsPointShadow);
         }
 
-        return shadowRender->load();
+        shadowRenderLoaded = shadowRender->load();
+
+        return shadowRenderLoaded;
 
     }
 }
@@ -315,6 +459,8 @@ bool GraphicObject::renderDraw(bool shadow){
 
     if (!shadow) {
 
+        updateLightList();
+
         render->prepareDraw();
         render->draw();
         render->finishDraw();
@@ -330,12 +476,17 @@ bool GraphicObject::renderDraw(bool shadow){
     return true;
 }
 
+bool GraphicObject::hasDepthRender(){
+    return shadowRender && shadowRenderLoaded;
+}
+
 void GraphicObject::destroy(){
     if (render)
         render->destroy();
 
     if (shadowRender)
         shadowRender->destroy();
+    shadowRenderLoaded = false;
 
     Object::destroy();
 }
@@ -12,6 +12,8 @@
 #include "buffer/InterleavedBuffer.h"
 #include "buffer/IndexBuffer.h"
 #include "render/ObjectRender.h"
+#include "math/AlignedBox.h"
+#include "util/LightList.h"
 
 namespace Supernova {
 
@@ -24,6 +26,7 @@ namespace Supernova {
     protected:
         ObjectRender* render;
         ObjectRender* shadowRender;
+        bool shadowRenderLoaded;
 
         Material* material;
 
@@ -36,10 +39,19 @@ namespace Supernova {
 
         bool visible;
         bool transparent;
+        bool castShadows;
         float distanceToCamera;
 
+        AlignedBox localBounds;
+        AlignedBox worldBounds;
+        bool needUpdateLocalBounds;
+        bool needUpdateWorldBounds;
+
         unsigned int minBufferSize;
 
+        //Only when scene limits lights per object
+        LightList* lightList;
+
         bool instanciateRender();
         bool instanciateShadowRender();
 
@@ -48,6 +60,15 @@ namespace Supernova {
         void updateDistanceToCamera();
 
         void updateBuffer(std::string name);
+        //Only bytes in range changed, buffer size is the same
+        void updateBuffer(std::string name, size_t offset, size_t size);
+
+        //Infinite bounds when vertices are changed in shader, never culled
+        virtual void updateLocalBounds();
+        bool isInsideShadowCamera();
+        //Objects drawn inside scissor of a parent are not sorted
+        bool isInsideScissor();
+        void updateLightList();
 
         virtual bool textureLoad();
 
@@ -61,6 +82,12 @@ namespace Supernova {
         void setVisible(bool visible);
         bool isVisible();
 
+        void setCastShadows(bool castShadows);
+        bool isCastShadows();
+
+        AlignedBox getLocalBounds();
+        AlignedBox getWorldBounds();
+
         unsigned int getMinBufferSize();
 
         void setColor(Vector4 color);
@@ -78,6 +105,8 @@ namespace Supernova {
 
         virtual bool renderLoad(bool shadow);
         virtual bool renderDraw(bool shadow);
+        //Shadow render is also used for depth pre-pass
+        bool hasDepthRender();
         
         virtual bool draw();
         virtual bool load();
@@ -19,7 +19,14 @@ Light::Light(){
     this->shadowMapHeight = 1024;
     this->shadowBias = 0.001;
 
-    this->shadowMap.clear();
+    this->shadowUpdatePolicy = S_SHADOW_UPDATE_ALWAYS;
+    this->shadowUpdateInterval = 2;
+    this->shadowFrames = 0;
+    this->shadowCastersVersion = 0;
+    this->shadowDirty = true;
+    this->lightDataDirty = true;
+
+    this->shadowAtlasSize = 0;
     this->lightCameras.clear();
     this->depthVPMatrix.clear();
 }
@@ -34,10 +41,6 @@ Light::~Light() {
     }
     lightCameras.clear();
 
-    if (shadowMap.size() > 0)
-        for (int i = 0; i < shadowMap.size(); i++)
-            delete shadowMap[i];
-
     destroy();
 }
 
@@ -61,6 +64,10 @@ float Light::getPower(){
     return power;
 }
 
+float Light::getRange(){
+    return 100 * power;
+}
+
 float Light::getSpotAngle(){
     return spotAngle;
 }
@@ -81,28 +88,57 @@ Camera* Light::getLightCamera(int index){
     return lightCameras[index];
 }
 
-Texture* Light::getShadowMap(){
-    return shadowMap[0];
+Rect Light::getShadowTile(int pass){
+    if (pass < shadowTiles.size())
+        return shadowTiles[pass];
+
+    return Rect(0, 0, 0, 0);
 }
 
-Texture* Light::getShadowMap(int index){
-    return shadowMap[index];
+Vector4 Light::getShadowAtlasRect(int index){
+    Rect tile = getShadowTile(index);
+    if (shadowAtlasSize == 0)
+        return Vector4(0, 0, 0, 0);
+
+    return Vector4(tile.getX() / shadowAtlasSize, tile.getY() / shadowAtlasSize, tile.getWidth() / shadowAtlasSize, tile.getHeight() / shadowAtlasSize);
+}
+
+bool Light::setShadowTile(int index, Rect tile, int atlasSize){
+    if (shadowTiles.size() < (index+1))
+        shadowTiles.resize(index+1, Rect(0, 0, 0, 0));
+
+    if (shadowTiles[index] != tile || shadowAtlasSize != atlasSize){
+        shadowTiles[index] = tile;
+        shadowAtlasSize = atlasSize;
+        invalidateShadow();
+        return true;
+    }
+
+    return false;
 }
 
 Matrix4 Light::getDepthVPMatrix(){
-    return depthVPMatrix[0];
+    return getDepthVPMatrix(0);
 }
 
 Matrix4 Light::getDepthVPMatrix(int index){
+    //Cached shadow maps must be sampled with matrix used to render them
+    if (index < renderedDepthVPMatrix.size())
+        return renderedDepthVPMatrix[index];
+
     return depthVPMatrix[index];
 }
 
 void Light::setPower(float power){
     this->power = power;
+    lightDataDirty = true;
+    requestRedraw();
 }
 
 void Light::setColor(Vector3 color){
     this->color = color;
+    lightDataDirty = true;
+    requestRedraw();
 }
 
 void Light::setShadow(bool useShadow){
@@ -113,9 +149,19 @@ void Light::setShadow(bool useShadow){
     }
 }
 
+void Light::setShadowMapSize(int shadowMapSize){
+    this->shadowMapWidth = shadowMapSize;
+    this->shadowMapHeight = shadowMapSize;
+}
+
+int Light::getShadowMapSize(){
+    return shadowMapWidth;
+}
+
 void Light::setShadowBias(float shadowBias){
     if (this->shadowBias != shadowBias){
         this->shadowBias = shadowBias;
+        lightDataDirty = true;
         if (loaded)
             load();
     }
@@ -129,8 +175,76 @@ float Light::getShadowBias(){
     return shadowBias;
 }
 
-void Light::updateLightCamera(){
+void Light::setShadowUpdatePolicy(int shadowUpdatePolicy){
+    this->shadowUpdatePolicy = shadowUpdatePolicy;
+    invalidateShadow();
+}
+
+int Light::getShadowUpdatePolicy(){
+    return shadowUpdatePolicy;
+}
+
+void Light::setShadowUpdateInterval(unsigned int shadowUpdateInterval){
+    if (shadowUpdateInterval == 0)
+        shadowUpdateInterval = 1;
+    this->shadowUpdateInterval = shadowUpdateInterval;
+}
+
+unsigned int Light::getShadowUpdateInterval(){
+    return shadowUpdateInterval;
+}
+
+void Light::invalidateShadow(){
+    shadowDirty = true;
+    lightDataDirty = true;
+    shadowPassRendered.clear();
+}
+
+int Light::getNumShadowPasses(){
+    return (int)lightCameras.size();
+}
+
+bool Light::isShadowPassUpdate(int pass, bool roundRobinTurn, unsigned long castersVersion){
+    if (pass >= shadowPassRendered.size() || !shadowPassRendered[pass])
+        return true;
+
+    if (shadowUpdatePolicy == S_SHADOW_UPDATE_INTERVAL)
+        return ((shadowFrames % shadowUpdateInterval) == 0);
+
+    if (shadowUpdatePolicy == S_SHADOW_UPDATE_ROUNDROBIN)
+        return roundRobinTurn;
+
+    if (shadowUpdatePolicy == S_SHADOW_UPDATE_ONCHANGE)
+        return (shadowDirty || shadowCastersVersion != castersVersion);
+
+    return true;
+}
+
+void Light::setShadowPassRendered(int pass){
+    if (shadowPassRendered.size() <= pass)
+        shadowPassRendered.resize(pass + 1, false);
+    shadowPassRendered[pass] = true;
 
+    if (pass < depthVPMatrix.size()){
+        if (renderedDepthVPMatrix.size() <= pass)
+            renderedDepthVPMatrix.resize(pass + 1);
+        renderedDepthVPMatrix[pass] = depthVPMatrix[pass];
+        lightDataDirty = true;
+    }
+}
+
+void Light::endShadowUpdate(bool updatedAll, unsigned long castersVersion){
+    if (updatedAll){
+        shadowDirty = false;
+        shadowCastersVersion = castersVersion;
+    }
+
+    shadowFrames++;
+}
+
+void Light::updateLightCamera(){
+    shadowDirty = true;
+    lightDataDirty = true;
 }
 
 void Light::updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatrix, Matrix4* viewProjectionMatrix, Vector3* cameraPosition){
@@ -142,6 +256,7 @@ void Light::updateModelMatrix(){
     Object::updateModelMatrix();
 
     worldTarget = modelMatrix * (target - position);
+    lightDataDirty = true;
 
     if (useShadow && loaded){
         updateLightCamera();
@@ -149,11 +264,10 @@ void Light::updateModelMatrix(){
 }
 
 bool Light::loadShadow(){
-    if (useShadow){
-        if (shadowMap.size() > 0)
-            for (int i = 0; i < shadowMap.size(); i++)
-                shadowMap[i]->load();
-    }
+    //Shadow atlas is created again
+    shadowPassRendered.clear();
+    renderedDepthVPMatrix.clear();
+    lightDataDirty = true;
 
     return true;
 }
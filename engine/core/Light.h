@@ -5,14 +5,40 @@
 #define S_DIRECTIONAL_LIGHT 2
 #define S_SPOT_LIGHT 3
 
+#define S_SHADOW_UPDATE_ALWAYS 0
+#define S_SHADOW_UPDATE_INTERVAL 1
+#define S_SHADOW_UPDATE_ROUNDROBIN 2
+#define S_SHADOW_UPDATE_ONCHANGE 3
+
 #include "Object.h"
 #include "Texture.h"
 #include "Camera.h"
+#include "math/Rect.h"
 
 namespace Supernova {
 
     class Light: public Object {
 
+        friend class Scene;
+        friend class LightData;
+
+    private:
+
+        //Shadow passes already rendered and matrices used to render them
+        std::vector<bool> shadowPassRendered;
+        std::vector<Matrix4> renderedDepthVPMatrix;
+
+        unsigned long shadowFrames;
+        unsigned long shadowCastersVersion;
+        bool shadowDirty;
+
+        bool isShadowPassUpdate(int pass, bool roundRobinTurn, unsigned long castersVersion);
+        void setShadowPassRendered(int pass);
+        void endShadowUpdate(bool updatedAll, unsigned long castersVersion);
+
+        //Returns true when tile is moved and shadow map needs to be drawn again
+        bool setShadowTile(int index, Rect tile, int atlasSize);
+
     protected:
 
         Vector3 color;
@@ -27,7 +53,6 @@ namespace Supernova {
         int type;
 
         bool useShadow;
-        std::vector<Texture*> shadowMap;
         std::vector<Camera*> lightCameras;
         std::vector<Matrix4> depthVPMatrix;
         float shadowBias;
@@ -35,6 +60,16 @@ namespace Supernova {
         int shadowMapWidth;
         int shadowMapHeight;
 
+        //Tiles in scene shadow atlas
+        std::vector<Rect> shadowTiles;
+        int shadowAtlasSize;
+
+        int shadowUpdatePolicy;
+        unsigned int shadowUpdateInterval;
+
+        //Values must be copied again to scene LightData
+        bool lightDataDirty;
+
         virtual void updateLightCamera();
 
     public:
@@ -48,13 +83,17 @@ namespace Supernova {
         Vector3 getTarget();
         Vector3 getDirection();
         float getPower();
+        //Distance where light is assigned to objects and shadow camera ends
+        float getRange();
         float getSpotAngle();
         float getSpotOuterAngle();
         bool isUseShadow();
         Camera* getLightCamera();
         Camera* getLightCamera(int index);
-        Texture* getShadowMap();
-        Texture* getShadowMap(int index);
+        //Pixels where shadow pass is drawn in shadow atlas
+        virtual Rect getShadowTile(int pass);
+        //Offset in xy and scale in zw to sample shadow atlas
+        virtual Vector4 getShadowAtlasRect(int index);
         Matrix4 getDepthVPMatrix();
         Matrix4 getDepthVPMatrix(int index);
         float getShadowBias();
@@ -66,6 +105,22 @@ namespace Supernova {
         void setShadow(bool useShadow);
         void setShadowBias(float shadowBias);
 
+        //Biggest tile requested in shadow atlas, smaller when light covers less of screen
+        void setShadowMapSize(int shadowMapSize);
+        int getShadowMapSize();
+
+        //S_SHADOW_UPDATE_*, cached shadow maps keep last rendered result
+        void setShadowUpdatePolicy(int shadowUpdatePolicy);
+        int getShadowUpdatePolicy();
+        //Frames between updates for S_SHADOW_UPDATE_INTERVAL
+        void setShadowUpdateInterval(unsigned int shadowUpdateInterval);
+        unsigned int getShadowUpdateInterval();
+        //Forces shadow map update on next frame
+        void invalidateShadow();
+
+        //Cube faces or cascades rendered for shadow map
+        virtual int getNumShadowPasses();
+
         virtual void updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatrix, Matrix4* viewProjectionMatrix, Vector3* cameraPosition);
         virtual void updateModelMatrix();
 
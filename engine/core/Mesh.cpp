@@ -15,6 +15,8 @@ Mesh::Mesh(): GraphicObject(){
 }
 
 Mesh::~Mesh(){
+    cancelLoadAsync();
+
     destroy();
     removeAllSubmeshes();
 
@@ -129,7 +131,7 @@ void Mesh::updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatrix, Matrix
 void Mesh::updateModelMatrix(){
     GraphicObject::updateModelMatrix();
     
-    this->normalMatrix = modelMatrix.inverse().transpose();
+    this->normalMatrix = modelMatrix.affineInverse().transpose();
 
     //sortTransparentSubmeshes();
 }
@@ -153,6 +155,19 @@ bool Mesh::textureLoad(){
     return true;
 }
 
+bool Mesh::preload(){
+    if (!GraphicObject::preload())
+        return false;
+
+    for (size_t i = 0; i < submeshes.size(); i++) {
+        Texture* texture = submeshes[i]->getMaterial()->getTexture();
+        if (texture && !texture->preload())
+            return false;
+    }
+
+    return true;
+}
+
 bool Mesh::renderLoad(bool shadow){
 
     if (!shadow){
@@ -234,6 +249,8 @@ bool Mesh::renderDraw(bool shadow){
 
     if (!shadow) {
 
+        updateLightList();
+
         render->prepareDraw();
 
         if (submeshes.size() == 1){
@@ -278,7 +295,7 @@ bool Mesh::load(){
         return false;
     }
 
-    if (scene && scene->isLoadedShadow()) {
+    if (scene && (scene->isLoadedShadow() || scene->isDepthPrePass())) {
         if (!renderLoad(true)){
             loaded = false;
             return false;
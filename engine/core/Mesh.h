@@ -31,6 +31,7 @@ namespace Supernova {
         bool resizeSubmeshes(unsigned int count, Material* material = NULL);
 
         virtual bool textureLoad();
+        virtual bool preload();
         //void sortTransparentSubmeshes();
         
     public:
@@ -7,9 +7,14 @@
 #include <istream>
 #include <sstream>
 #include "Log.h"
+#include "Engine.h"
+#include "Scene.h"
+#include "Camera.h"
 #include "render/ObjectRender.h"
 #include <algorithm>
 #include <float.h>
+#include <cmath>
+#include <cstring>
 #include "tiny_obj_loader.h"
 #include "tiny_gltf.h"
 #include "util/ReadSModel.h"
@@ -21,6 +26,9 @@
 #include "action/keyframe/TranslateTracks.h"
 #include "action/keyframe/RotateTracks.h"
 #include "action/keyframe/ScaleTracks.h"
+#include "util/BonePartition.h"
+#include "math/SIMD.h"
+#include "math/Angle.h"
 #include "action/keyframe/MorphTracks.h"
 
 using namespace Supernova;
@@ -30,7 +38,26 @@ Model::Model(): Mesh() {
     submeshes.push_back(new Submesh());
 
     skeleton = NULL;
+    compactSkeleton = false;
+    paletteSubmeshes = 0;
+    cpuMorphTargets = false;
+    cpuMorph = false;
+    animationCompression = false;
+    animationTolerance = 0.001;
+    animationAngleTolerance = Angle::radToDefault(0.001);
+
+    animationLOD = false;
+    animationLODDistances[0] = 20;
+    animationLODDistances[1] = 40;
+    animationLODDistances[2] = 80;
+    pauseAnimationWhenCulled = false;
+    animationCulled = false;
+    animationLODStep = 1;
+    animationLODFrame = 1;
+    animationLODInterpolating = false;
+    jointsBoundsMargin = -1;
     gltfModel = NULL;
+    gltfReaded = false;
 
     skinning = false;
     morphTargets = false;
@@ -49,9 +76,16 @@ Model::Model(const char * path): Model() {
 }
 
 Model::~Model() {
+    cancelLoadAsync();
+
     if (gltfModel)
         delete gltfModel;
 
+    for (size_t i = 0; i < paletteBuffers.size(); i++)
+        delete paletteBuffers[i];
+
+    clearCPUMorphs();
+
     clearAnimations();
 }
 
@@ -142,6 +176,334 @@ bool Model::loadGLTFBuffer(int bufferViewIndex){
     return false;
 }
 
+//Accessor data is not aligned to component size
+template<typename T>
+static double readAccessorValue(const unsigned char* value){
+    T result;
+    memcpy(&result, value, sizeof(T));
+    return result;
+}
+
+static double readAccessorComponent(const unsigned char* value, int componentType){
+    if (componentType == TINYGLTF_COMPONENT_TYPE_BYTE){
+        return readAccessorValue<int8_t>(value);
+    }else if (componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE){
+        return readAccessorValue<uint8_t>(value);
+    }else if (componentType == TINYGLTF_COMPONENT_TYPE_SHORT){
+        return readAccessorValue<int16_t>(value);
+    }else if (componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT){
+        return readAccessorValue<uint16_t>(value);
+    }else if (componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT){
+        return readAccessorValue<uint32_t>(value);
+    }else if (componentType == TINYGLTF_COMPONENT_TYPE_FLOAT){
+        return readAccessorValue<float>(value);
+    }
+
+    return 0;
+}
+
+std::vector<double> Model::getAccessorValues(int accessorIndex){
+    std::vector<double> values;
+
+    const tinygltf::Accessor &accessor = gltfModel->accessors[accessorIndex];
+
+    int elements = 1;
+    if (accessor.type != TINYGLTF_TYPE_SCALAR) {
+        elements = accessor.type;
+    }
+
+    int componentSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+    if (componentSize <= 0)
+        return values;
+
+    //Accessor without buffer view is initialized with zeros
+    values.resize(accessor.count * elements, 0);
+
+    if (accessor.bufferView >= 0){
+        const tinygltf::BufferView &bufferView = gltfModel->bufferViews[accessor.bufferView];
+        int byteStride = accessor.ByteStride(bufferView);
+        if (byteStride <= 0)
+            return std::vector<double>();
+
+        const unsigned char* data = &gltfModel->buffers[bufferView.buffer].data.at(0) + bufferView.byteOffset + accessor.byteOffset;
+
+        for (size_t c = 0; c < accessor.count; c++){
+            for (int e = 0; e < elements; e++){
+                values[c * elements + e] = readAccessorComponent(data + (c * byteStride) + (e * componentSize), accessor.componentType);
+            }
+        }
+    }
+
+    if (accessor.sparse.isSparse){
+        const tinygltf::BufferView &indicesView = gltfModel->bufferViews[accessor.sparse.indices.bufferView];
+        const tinygltf::BufferView &valuesView = gltfModel->bufferViews[accessor.sparse.values.bufferView];
+
+        const unsigned char* indicesData = &gltfModel->buffers[indicesView.buffer].data.at(0) + indicesView.byteOffset + accessor.sparse.indices.byteOffset;
+        const unsigned char* valuesData = &gltfModel->buffers[valuesView.buffer].data.at(0) + valuesView.byteOffset + accessor.sparse.values.byteOffset;
+
+        int indexSize = tinygltf::GetComponentSizeInBytes(accessor.sparse.indices.componentType);
+
+        for (int s = 0; s < accessor.sparse.count; s++){
+            size_t c = (size_t)readAccessorComponent(indicesData + (s * indexSize), accessor.sparse.indices.componentType);
+            if (c >= accessor.count)
+                continue;
+
+            for (int e = 0; e < elements; e++){
+                values[c * elements + e] = readAccessorComponent(valuesData + ((s * elements + e) * componentSize), accessor.componentType);
+            }
+        }
+    }
+
+    return values;
+}
+
+void Model::splitBonePalettes(int meshIndex){
+    const tinygltf::Mesh &mesh = gltfModel->meshes[meshIndex];
+
+    for (size_t i = 0; i < mesh.primitives.size() && i < submeshes.size(); i++) {
+        const tinygltf::Primitive &primitive = mesh.primitives[i];
+
+        if (primitive.indices < 0 || !primitive.attributes.count("JOINTS_0") || !primitive.attributes.count("WEIGHTS_0"))
+            continue;
+
+        std::vector<double> indexValues = getAccessorValues(primitive.indices);
+        std::vector<double> joints = getAccessorValues(primitive.attributes.at("JOINTS_0"));
+        std::vector<double> weights = getAccessorValues(primitive.attributes.at("WEIGHTS_0"));
+
+        if (joints.size() != weights.size() || joints.size() % 4 != 0){
+            Log::Error("Cannot split bones of submesh %i: joints and weights must have 4 values", i);
+            continue;
+        }
+
+        size_t vertexCount = joints.size() / 4;
+
+        //Zero weight joints do not use palette slots
+        std::vector<int> vertexBones(joints.size());
+        for (size_t j = 0; j < joints.size(); j++)
+            vertexBones[j] = (weights[j] > 0 && joints[j] < bonesMatrix.size()) ? (int)joints[j] : -1;
+
+        std::vector<unsigned int> indices(indexValues.begin(), indexValues.end());
+
+        std::vector<BonePartition::Batch> batches = BonePartition::partition(indices, vertexBones, S_MAX_BONES);
+
+        std::vector<int> slots(bonesMatrix.size());
+
+        for (size_t b = 0; b < batches.size(); b++){
+            Submesh* submesh = submeshes[i];
+            if (b > 0){
+                submesh = new Submesh(submeshes[i]->getMaterial());
+                submesh->attributes = submeshes[i]->attributes;
+                submeshes.push_back(submesh);
+                paletteSubmeshes++;
+            }
+
+            std::string name = "palette" + std::to_string(i) + "_" + std::to_string(b);
+
+            IndexBuffer* indexBuffer = new IndexBuffer();
+            for (size_t k = 0; k < batches[b].indices.size(); k++)
+                indexBuffer->addUInt(S_INDEXATTRIBUTE, batches[b].indices[k]);
+
+            buffers[name + "_indices"] = indexBuffer;
+            paletteBuffers.push_back(indexBuffer);
+            submesh->setIndices(name + "_indices", batches[b].indices.size());
+
+            std::fill(slots.begin(), slots.end(), 0);
+            for (size_t s = 0; s < batches[b].bones.size(); s++)
+                slots[batches[b].bones[s]] = (int)s;
+
+            //Joints of all vertices, only vertices of batch triangles are read
+            InterleavedBuffer* jointsBuffer = new InterleavedBuffer();
+            jointsBuffer->addAttribute(S_VERTEXATTRIBUTE_BONEIDS, 4);
+            jointsBuffer->setRenderAttributes(false);
+            for (size_t v = 0; v < vertexCount; v++){
+                int* bones = &vertexBones[v * 4];
+                jointsBuffer->addVector4(S_VERTEXATTRIBUTE_BONEIDS, Vector4(
+                        (bones[0] >= 0) ? slots[bones[0]] : 0,
+                        (bones[1] >= 0) ? slots[bones[1]] : 0,
+                        (bones[2] >= 0) ? slots[bones[2]] : 0,
+                        (bones[3] >= 0) ? slots[bones[3]] : 0));
+            }
+
+            buffers[name + "_joints"] = jointsBuffer;
+            paletteBuffers.push_back(jointsBuffer);
+            submesh->addAttribute(name + "_joints", S_VERTEXATTRIBUTE_BONEIDS, 4, DataType::FLOAT, 4 * sizeof(float), 0);
+
+            submesh->paletteBones = batches[b].bones;
+            submesh->bonesMatrix.resize(batches[b].bones.size());
+        }
+    }
+}
+
+void Model::clearBonePalettes(){
+    for (size_t i = 0; i < paletteSubmeshes && submeshes.size() > 0; i++){
+        delete submeshes.back();
+        submeshes.pop_back();
+    }
+    paletteSubmeshes = 0;
+
+    for (size_t i = 0; i < submeshes.size(); i++){
+        submeshes[i]->paletteBones.clear();
+        submeshes[i]->bonesMatrix.clear();
+    }
+
+    for (size_t i = 0; i < paletteBuffers.size(); i++)
+        delete paletteBuffers[i];
+    paletteBuffers.clear();
+}
+
+void Model::loadCPUMorph(int submeshIndex, int meshIndex, int primitiveIndex){
+    const tinygltf::Primitive &primitive = gltfModel->meshes[meshIndex].primitives[primitiveIndex];
+
+    if (primitive.targets.size() == 0 || !primitive.attributes.count("POSITION"))
+        return;
+
+    std::vector<double> positions = getAccessorValues(primitive.attributes.at("POSITION"));
+    std::vector<double> normals;
+    if (primitive.attributes.count("NORMAL"))
+        normals = getAccessorValues(primitive.attributes.at("NORMAL"));
+
+    size_t vertexCount = positions.size() / 3;
+    bool hasNormals = (normals.size() == positions.size());
+
+    //Position and normal are 4 floats each, so they are summed with SIMD
+    CPUMorph* morph = new CPUMorph();
+    morph->bufferName = "morph" + std::to_string(submeshIndex);
+    morph->base.resize(vertexCount * 8, 0);
+
+    for (size_t v = 0; v < vertexCount; v++){
+        for (int c = 0; c < 3; c++){
+            morph->base[v * 8 + c] = positions[v * 3 + c];
+            if (hasNormals)
+                morph->base[v * 8 + 4 + c] = normals[v * 3 + c];
+        }
+    }
+    morph->values = morph->base;
+
+    for (size_t t = 0; t < primitive.targets.size(); t++){
+        const std::map<std::string, int> &attributes = primitive.targets[t];
+
+        std::vector<double> targetPositions;
+        std::vector<double> targetNormals;
+        if (attributes.count("POSITION"))
+            targetPositions = getAccessorValues(attributes.at("POSITION"));
+        if (hasNormals && attributes.count("NORMAL"))
+            targetNormals = getAccessorValues(attributes.at("NORMAL"));
+
+        //Only vertices moved by target are kept
+        MorphTarget target;
+        target.firstVertex = 0;
+        target.lastVertex = 0;
+
+        for (size_t v = 0; v < vertexCount; v++){
+            float delta[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+            bool moved = false;
+
+            for (int c = 0; c < 3; c++){
+                if (targetPositions.size() == positions.size())
+                    delta[c] = targetPositions[v * 3 + c];
+                if (targetNormals.size() == normals.size())
+                    delta[4 + c] = targetNormals[v * 3 + c];
+                moved = moved || delta[c] != 0 || delta[4 + c] != 0;
+            }
+
+            if (moved){
+                if (target.vertices.empty())
+                    target.firstVertex = (unsigned int)v;
+                target.lastVertex = (unsigned int)v;
+
+                target.vertices.push_back((unsigned int)v);
+                target.deltas.insert(target.deltas.end(), delta, delta + 8);
+            }
+        }
+
+        morph->targets.push_back(target);
+    }
+
+    morph->appliedWeights.resize(morph->targets.size(), 0);
+
+    morph->buffer = new ExternalBuffer();
+    morph->buffer->setData((unsigned char*)&morph->values.front(), morph->values.size() * sizeof(float));
+    buffers[morph->bufferName] = morph->buffer;
+
+    submeshes[submeshIndex]->addAttribute(morph->bufferName, S_VERTEXATTRIBUTE_VERTICES, 3, DataType::FLOAT, 8 * sizeof(float), 0);
+    if (hasNormals)
+        submeshes[submeshIndex]->addAttribute(morph->bufferName, S_VERTEXATTRIBUTE_NORMALS, 3, DataType::FLOAT, 8 * sizeof(float), 4 * sizeof(float));
+
+    cpuMorphs.push_back(morph);
+
+    morphTargets = true;
+}
+
+void Model::clearCPUMorphs(){
+    for (size_t i = 0; i < cpuMorphs.size(); i++){
+        delete cpuMorphs[i]->buffer;
+        delete cpuMorphs[i];
+    }
+    cpuMorphs.clear();
+}
+
+void Model::updateCPUMorphs(){
+    for (size_t m = 0; m < cpuMorphs.size(); m++){
+        CPUMorph* morph = cpuMorphs[m];
+
+        //Vertices of targets with changed weight
+        size_t first = morph->base.size();
+        size_t last = 0;
+        for (size_t t = 0; t < morph->targets.size(); t++){
+            float weight = (t < morphWeights.size()) ? morphWeights[t] : 0;
+            if (weight != morph->appliedWeights[t] && !morph->targets[t].vertices.empty()){
+                first = std::min(first, (size_t)morph->targets[t].firstVertex);
+                last = std::max(last, (size_t)morph->targets[t].lastVertex);
+            }
+        }
+
+        if (first > last)
+            continue;
+
+        //Range is restored from base and non zero targets are added again
+        memcpy(&morph->values[first * 8], &morph->base[first * 8], (last - first + 1) * 8 * sizeof(float));
+
+        for (size_t t = 0; t < morph->targets.size(); t++){
+            const MorphTarget &target = morph->targets[t];
+
+            float weight = (t < morphWeights.size()) ? morphWeights[t] : 0;
+            morph->appliedWeights[t] = weight;
+
+            if (weight == 0 || target.vertices.empty() || target.lastVertex < first || target.firstVertex > last)
+                continue;
+
+            size_t k = std::lower_bound(target.vertices.begin(), target.vertices.end(), (unsigned int)first) - target.vertices.begin();
+
+#ifdef SUPERNOVA_SIMD
+            SIMD::float4 w = SIMD::splat(weight);
+            for (; k < target.vertices.size() && target.vertices[k] <= last; k++){
+                float* value = &morph->values[target.vertices[k] * 8];
+                const float* delta = &target.deltas[k * 8];
+                SIMD::store(value, SIMD::add(SIMD::load(value), SIMD::mul(SIMD::load(delta), w)));
+                SIMD::store(value + 4, SIMD::add(SIMD::load(value + 4), SIMD::mul(SIMD::load(delta + 4), w)));
+            }
+#else
+            for (; k < target.vertices.size() && target.vertices[k] <= last; k++){
+                float* value = &morph->values[target.vertices[k] * 8];
+                const float* delta = &target.deltas[k * 8];
+                for (int c = 0; c < 8; c++)
+                    value[c] += delta[c] * weight;
+            }
+#endif
+        }
+
+        updateBuffer(morph->bufferName, first * 8 * sizeof(float), (last - first + 1) * 8 * sizeof(float));
+    }
+}
+
+void Model::updateBonePalettes(){
+    for (size_t i = 0; i < submeshes.size(); i++){
+        Submesh* submesh = submeshes[i];
+        for (size_t s = 0; s < submesh->paletteBones.size(); s++)
+            submesh->bonesMatrix[s] = bonesMatrix[submesh->paletteBones[s]];
+    }
+}
+
 std::string Model::getBufferName(int bufferViewIndex){
     const tinygltf::BufferView &bufferView = gltfModel->bufferViews[bufferViewIndex];
 
@@ -152,9 +514,8 @@ std::string Model::getBufferName(int bufferViewIndex){
 
 }
 
-Bone* Model::generateSketetalStructure(int nodeIndex, int skinIndex){
-    tinygltf::Node node = gltfModel->nodes[nodeIndex];
-    tinygltf::Skin skin = gltfModel->skins[skinIndex];
+int Model::getSkinJoint(int nodeIndex, int skinIndex){
+    const tinygltf::Skin& skin = gltfModel->skins[skinIndex];
 
     int index = -1;
 
@@ -163,21 +524,27 @@ Bone* Model::generateSketetalStructure(int nodeIndex, int skinIndex){
             index = j;
     }
 
-    Matrix4 offsetMatrix;
+    return index;
+}
 
-    if (skin.inverseBindMatrices >= 0) {
+bool Model::getInverseBindMatrix(int skinIndex, int jointIndex, Matrix4& offsetMatrix){
+    const tinygltf::Skin& skin = gltfModel->skins[skinIndex];
+
+    offsetMatrix = Matrix4();
+
+    if (skin.inverseBindMatrices >= 0 && jointIndex >= 0) {
 
         tinygltf::Accessor accessor = gltfModel->accessors[skin.inverseBindMatrices];
         tinygltf::BufferView bufferView = gltfModel->bufferViews[accessor.bufferView];
 
         float *matrices = (float *) (&gltfModel->buffers[bufferView.buffer].data.at(0) +
                                      bufferView.byteOffset + accessor.byteOffset +
-                                     (16 * sizeof(float) * index));
+                                     (16 * sizeof(float) * jointIndex));
 
         if (accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT || accessor.type != TINYGLTF_TYPE_MAT4) {
             Log::Error("Skeleton error: Unknown inverse bind matrix data type");
 
-            return NULL;
+            return false;
         }
 
         offsetMatrix = Matrix4(
@@ -188,13 +555,69 @@ Bone* Model::generateSketetalStructure(int nodeIndex, int skinIndex){
 
     }
 
+    return true;
+}
+
+void Model::getNodeTransform(int nodeIndex, Vector3& position, Quaternion& rotation, Vector3& scale){
+    const tinygltf::Node& node = gltfModel->nodes[nodeIndex];
+
+    //glTF properties are empty when node has default values
+    position = Vector3(0, 0, 0);
+    rotation = Quaternion();
+    scale = Vector3(1, 1, 1);
+
+    if (node.translation.size() == 3)
+        position = Vector3(node.translation[0], node.translation[1], node.translation[2]);
+    if (node.rotation.size() == 4)
+        rotation = Quaternion(node.rotation[3], node.rotation[0], node.rotation[1], node.rotation[2]);
+    if (node.scale.size() == 3)
+        scale = Vector3(node.scale[0], node.scale[1], node.scale[2]);
+}
+
+void Model::generateCompactSkeleton(int nodeIndex, int skinIndex, int parentJoint){
+    const tinygltf::Node& node = gltfModel->nodes[nodeIndex];
+
+    int index = getSkinJoint(nodeIndex, skinIndex);
+
+    Matrix4 offsetMatrix;
+    if (!getInverseBindMatrix(skinIndex, index, offsetMatrix))
+        return;
+
+    Vector3 position;
+    Quaternion rotation;
+    Vector3 scale;
+    getNodeTransform(nodeIndex, position, rotation, scale);
+
+    int joint = skeletonPose.addJoint(parentJoint, index, node.name, position, rotation, scale, offsetMatrix);
+    jointsIdMapping[nodeIndex] = joint;
+
+    //Depth-first keeps parents before children
+    for (size_t i = 0; i < node.children.size(); i++){
+        generateCompactSkeleton(node.children[i], skinIndex, joint);
+    }
+}
+
+Bone* Model::generateSketetalStructure(int nodeIndex, int skinIndex){
+    tinygltf::Node node = gltfModel->nodes[nodeIndex];
+
+    int index = getSkinJoint(nodeIndex, skinIndex);
+
+    Matrix4 offsetMatrix;
+    if (!getInverseBindMatrix(skinIndex, index, offsetMatrix))
+        return NULL;
+
+    Vector3 position;
+    Quaternion rotation;
+    Vector3 scale;
+    getNodeTransform(nodeIndex, position, rotation, scale);
+
     Bone* bone = new Bone();
 
     bone->setIndex(index);
     bone->setName(node.name);
-    bone->setBindPosition(Vector3(node.translation[0], node.translation[1], node.translation[2]));
-    bone->setBindRotation(Quaternion(node.rotation[3], node.rotation[0], node.rotation[1], node.rotation[2]));
-    bone->setBindScale(Vector3(node.scale[0], node.scale[1], node.scale[2]));
+    bone->setBindPosition(position);
+    bone->setBindRotation(rotation);
+    bone->setBindScale(scale);
     bone->moveToBind();
 
     bone->setOffsetMatrix(offsetMatrix);
@@ -211,7 +634,7 @@ Bone* Model::generateSketetalStructure(int nodeIndex, int skinIndex){
     return bone;
 }
 
-bool Model::loadGLTF(const char* filename) {
+bool Model::readGLTF(const char* filename) {
 
     if (!gltfModel)
         gltfModel = new tinygltf::Model();
@@ -220,10 +643,6 @@ bool Model::loadGLTF(const char* filename) {
     std::string err;
     std::string warn;
 
-    int meshIndex = 0;
-
-    buffers.clear();
-
     loader.SetFsCallbacks({&fileExists, &tinygltf::ExpandFilePath, &readWholeFile, nullptr, nullptr});
     //loader.SetFsCallbacks({nullptr, nullptr, nullptr, nullptr, nullptr});
 
@@ -251,10 +670,45 @@ bool Model::loadGLTF(const char* filename) {
         return false;
     }
 
+    gltfReaded = true;
+
+    return true;
+}
+
+bool Model::loadGLTF(const char* filename) {
+
+    if (!gltfReaded && !readGLTF(filename))
+        return false;
+
+    //Next load reads the file again
+    gltfReaded = false;
+
+    int meshIndex = 0;
+
+    clearBonePalettes();
+    clearCPUMorphs();
+    buffers.clear();
+
+    gltfBounds.setNull();
+    jointsBoundsMargin = -1;
+    needUpdateLocalBounds = true;
+
     tinygltf::Mesh mesh = gltfModel->meshes[meshIndex];
 
     resizeSubmeshes(mesh.primitives.size());
 
+    //Targets that do not fit in vertex attributes are evaluated in CPU
+    cpuMorph = cpuMorphTargets;
+    for (size_t i = 0; i < mesh.primitives.size(); i++) {
+        bool normals = false;
+        for (size_t t = 0; t < mesh.primitives[i].targets.size(); t++) {
+            if (mesh.primitives[i].targets[t].count("NORMAL"))
+                normals = true;
+        }
+        if (mesh.primitives[i].targets.size() > (normals ? 4 : 8))
+            cpuMorph = true;
+    }
+
     for (size_t i = 0; i < mesh.primitives.size(); i++) {
 
         tinygltf::Primitive primitive = mesh.primitives[i];
@@ -358,6 +812,11 @@ bool Model::loadGLTF(const char* filename) {
             if (attrib.first.compare("POSITION") == 0){
                 defaultBuffer = bufferName;
                 attType = S_VERTEXATTRIBUTE_VERTICES;
+
+                if (accessor.minValues.size() == 3 && accessor.maxValues.size() == 3){
+                    gltfBounds.merge(Vector3(accessor.minValues[0], accessor.minValues[1], accessor.minValues[2]));
+                    gltfBounds.merge(Vector3(accessor.maxValues[0], accessor.maxValues[1], accessor.maxValues[2]));
+                }
             }
             if (attrib.first.compare("NORMAL") == 0){
                 attType = S_VERTEXATTRIBUTE_NORMALS;
@@ -385,91 +844,98 @@ bool Model::loadGLTF(const char* filename) {
         bool morphNormals = false;
 
         int morphIndex = 0;
-        for (auto &morphs : primitive.targets) {
-            for (auto &attribMorph : morphs) {
+        if (cpuMorph) {
+            loadCPUMorph(i, meshIndex, i);
+        } else {
+            for (auto &morphs : primitive.targets) {
+                for (auto &attribMorph : morphs) {
 
-                morphTargets = true;
+                    morphTargets = true;
 
-                tinygltf::Accessor accessor = gltfModel->accessors[attribMorph.second];
-                int byteStride = accessor.ByteStride(gltfModel->bufferViews[accessor.bufferView]);
-                std::string bufferName = getBufferName(accessor.bufferView);
+                    tinygltf::Accessor accessor = gltfModel->accessors[attribMorph.second];
+                    int byteStride = accessor.ByteStride(gltfModel->bufferViews[accessor.bufferView]);
+                    std::string bufferName = getBufferName(accessor.bufferView);
 
-                loadGLTFBuffer(accessor.bufferView);
+                    loadGLTFBuffer(accessor.bufferView);
 
-                int elements = 1;
-                if (accessor.type != TINYGLTF_TYPE_SCALAR) {
-                    elements = accessor.type;
-                }
+                    int elements = 1;
+                    if (accessor.type != TINYGLTF_TYPE_SCALAR) {
+                        elements = accessor.type;
+                    }
 
-                DataType dataType;
-
-                if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_BYTE){
-                    dataType = DataType::BYTE;
-                }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE){
-                    dataType = DataType::UNSIGNED_BYTE;
-                }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_SHORT){
-                    dataType = DataType::SHORT;
-                }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT){
-                    dataType = DataType::UNSIGNED_SHORT;
-                }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT){
-                    dataType = DataType::UNSIGNED_INT;
-                }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT){
-                    dataType = DataType::FLOAT;
-                }else{
-                    Log::Error("Unknown data type %i of morph target %s", accessor.componentType, attribMorph.first.c_str());
-                    continue;
-                }
+                    DataType dataType;
+
+                    if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_BYTE){
+                        dataType = DataType::BYTE;
+                    }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE){
+                        dataType = DataType::UNSIGNED_BYTE;
+                    }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_SHORT){
+                        dataType = DataType::SHORT;
+                    }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT){
+                        dataType = DataType::UNSIGNED_SHORT;
+                    }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT){
+                        dataType = DataType::UNSIGNED_INT;
+                    }else if (accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT){
+                        dataType = DataType::FLOAT;
+                    }else{
+                        Log::Error("Unknown data type %i of morph target %s", accessor.componentType, attribMorph.first.c_str());
+                        continue;
+                    }
 
-                int attType = -1;
-                if (attribMorph.first.compare("POSITION") == 0){
-                    if (morphIndex == 0){
-                        attType = S_VERTEXATTRIBUTE_MORPHTARGET0;
-                    } else if (morphIndex == 1){
-                        attType = S_VERTEXATTRIBUTE_MORPHTARGET1;
-                    } else if (morphIndex == 2){
-                        attType = S_VERTEXATTRIBUTE_MORPHTARGET2;
-                    } else if (morphIndex == 3){
-                        attType = S_VERTEXATTRIBUTE_MORPHTARGET3;
+                    int attType = -1;
+                    if (attribMorph.first.compare("POSITION") == 0){
+                        if (morphIndex == 0){
+                            attType = S_VERTEXATTRIBUTE_MORPHTARGET0;
+                        } else if (morphIndex == 1){
+                            attType = S_VERTEXATTRIBUTE_MORPHTARGET1;
+                        } else if (morphIndex == 2){
+                            attType = S_VERTEXATTRIBUTE_MORPHTARGET2;
+                        } else if (morphIndex == 3){
+                            attType = S_VERTEXATTRIBUTE_MORPHTARGET3;
+                        }
+                        if (!morphNormals){
+                            if (morphIndex == 4){
+                                attType = S_VERTEXATTRIBUTE_MORPHTARGET4;
+                            } else if (morphIndex == 5){
+                                attType = S_VERTEXATTRIBUTE_MORPHTARGET5;
+                            } else if (morphIndex == 6){
+                                attType = S_VERTEXATTRIBUTE_MORPHTARGET6;
+                            } else if (morphIndex == 7){
+                                attType = S_VERTEXATTRIBUTE_MORPHTARGET7;
+                            }
+                        }
                     }
-                    if (!morphNormals){
-                        if (morphIndex == 4){
-                            attType = S_VERTEXATTRIBUTE_MORPHTARGET4;
-                        } else if (morphIndex == 5){
-                            attType = S_VERTEXATTRIBUTE_MORPHTARGET5;
-                        } else if (morphIndex == 6){
-                            attType = S_VERTEXATTRIBUTE_MORPHTARGET6;
-                        } else if (morphIndex == 7){
-                            attType = S_VERTEXATTRIBUTE_MORPHTARGET7;
+                    if (attribMorph.first.compare("NORMAL") == 0){
+                        morphNormals = true;
+                        if (morphIndex == 0){
+                            attType = S_VERTEXATTRIBUTE_MORPHNORMAL0;
+                        } else if (morphIndex == 1){
+                            attType = S_VERTEXATTRIBUTE_MORPHNORMAL1;
+                        } else if (morphIndex == 2){
+                            attType = S_VERTEXATTRIBUTE_MORPHNORMAL2;
+                        } else if (morphIndex == 3){
+                            attType = S_VERTEXATTRIBUTE_MORPHNORMAL3;
                         }
                     }
-                }
-                if (attribMorph.first.compare("NORMAL") == 0){
-                    morphNormals = true;
-                    if (morphIndex == 0){
-                        attType = S_VERTEXATTRIBUTE_MORPHNORMAL0;
-                    } else if (morphIndex == 1){
-                        attType = S_VERTEXATTRIBUTE_MORPHNORMAL1;
-                    } else if (morphIndex == 2){
-                        attType = S_VERTEXATTRIBUTE_MORPHNORMAL2;
-                    } else if (morphIndex == 3){
-                        attType = S_VERTEXATTRIBUTE_MORPHNORMAL3;
+                    if (attribMorph.first.compare("TANGENT") == 0){
                     }
-                }
-                if (attribMorph.first.compare("TANGENT") == 0){
-                }
 
-                if (attType > -1) {
-                    buffers[bufferName]->setRenderAttributes(false);
-                    submeshes[i]->addAttribute(bufferName, attType, elements, dataType, byteStride, accessor.byteOffset);
+                    if (attType > -1) {
+                        buffers[bufferName]->setRenderAttributes(false);
+                        submeshes[i]->addAttribute(bufferName, attType, elements, dataType, byteStride, accessor.byteOffset);
+                    }
                 }
+                morphIndex++;
             }
-            morphIndex++;
         }
 
         int morphWeightSize = 8;
         if (morphNormals){
             morphWeightSize = 4;
         }
+        if (cpuMorph){
+            morphWeightSize = (int)std::max(primitive.targets.size(), mesh.weights.size());
+        }
 
         if (morphTargets){
             morphWeights.resize(morphWeightSize);
@@ -526,13 +992,25 @@ bool Model::loadGLTF(const char* filename) {
 
         bonesNameMapping.clear();
         bonesIdMapping.clear();
+        jointsIdMapping.clear();
+        skeletonPose.clear();
 
-        skeleton = generateSketetalStructure(skeletonRoot, skinIndex);
+        if (compactSkeleton) {
+            generateCompactSkeleton(skeletonRoot, skinIndex, -1);
 
-        if (skeleton) {
-            bonesMatrix.resize(skin.joints.size());
-            addObject(skeleton);
+            if (skeletonPose.size() > 0)
+                bonesMatrix.resize(skin.joints.size());
+        }else{
+            skeleton = generateSketetalStructure(skeletonRoot, skinIndex);
+
+            if (skeleton) {
+                bonesMatrix.resize(skin.joints.size());
+                addObject(skeleton);
+            }
         }
+
+        if (bonesMatrix.size() > S_MAX_BONES)
+            splitBonePalettes(meshIndex);
     }
 
     clearAnimations();
@@ -611,16 +1089,25 @@ bool Model::loadGLTF(const char* filename) {
                     for (int c = 0; c < accessorIn.count; c++) {
                         std::vector<float> weightsAc;
                         for (int m = 0; m < morphNum; m++) {
-                            weightsAc.push_back(values[morphNum * c] + m);
+                            weightsAc.push_back(values[(morphNum * c) + m]);
                         }
                         ((MorphTracks *) track)->addKeyframe(timeValues[c], weightsAc);
                     }
                 }
 
                 if (track) {
+                    if (animationCompression && !track->isCompressed()) {
+                        if (channel.target_path.compare("rotation") == 0)
+                            track->compress(Angle::defaultToRad(animationAngleTolerance));
+                        else
+                            track->compress(animationTolerance);
+                    }
                     track->setDuration(trackEndTIme - trackStartTime);
                     if (bonesIdMapping.count(channel.target_node)) {
                         anim->addActionFrame(trackStartTime, track, bonesIdMapping[channel.target_node]);
+                    } else if (jointsIdMapping.count(channel.target_node)) {
+                        track->setPoseTarget(skeletonPose.getPose(), jointsIdMapping[channel.target_node]);
+                        anim->addActionFrame(trackStartTime, track, this);
                     } else {
                         anim->addActionFrame(trackStartTime, track, this);
                     }
@@ -816,6 +1303,8 @@ Animation* Model::findAnimation(std::string name){
 }
 
 void Model::clearAnimations(){
+    clearAnimationLayers();
+
     for (int i = 0; i < animations.size(); i++){
         delete animations[i];
     }
@@ -856,15 +1345,577 @@ void Model::setMorphWeight(std::string name, float value){
     }
 }
 
+void Model::setCPUMorphTargets(bool cpuMorphTargets){
+    this->cpuMorphTargets = cpuMorphTargets;
+}
+
+bool Model::isCPUMorphTargets(){
+    return cpuMorphTargets;
+}
+
 void Model::updateBone(int boneIndex, Matrix4 skinning){
     if (boneIndex >= 0 && boneIndex < bonesMatrix.size())
         bonesMatrix[boneIndex] = skinning;
 }
 
+void Model::setCompactSkeleton(bool compactSkeleton){
+    this->compactSkeleton = compactSkeleton;
+}
+
+bool Model::isCompactSkeleton(){
+    return compactSkeleton;
+}
+
+void Model::setAnimationCompression(bool animationCompression){
+    this->animationCompression = animationCompression;
+}
+
+bool Model::isAnimationCompression(){
+    return animationCompression;
+}
+
+void Model::setAnimationTolerance(float animationTolerance){
+    this->animationTolerance = animationTolerance;
+}
+
+float Model::getAnimationTolerance(){
+    return animationTolerance;
+}
+
+void Model::setAnimationAngleTolerance(float animationAngleTolerance){
+    this->animationAngleTolerance = animationAngleTolerance;
+}
+
+float Model::getAnimationAngleTolerance(){
+    return animationAngleTolerance;
+}
+
+void Model::setAnimationLOD(bool animationLOD){
+    this->animationLOD = animationLOD;
+
+    animationCulled = false;
+    animationLODStep = 1;
+    animationLODFrame = 1;
+    animationLODInterpolating = false;
+}
+
+bool Model::isAnimationLOD(){
+    return animationLOD;
+}
+
+void Model::setAnimationLODDistances(float half, float quarter, float eighth){
+    animationLODDistances[0] = half;
+    animationLODDistances[1] = quarter;
+    animationLODDistances[2] = eighth;
+}
+
+void Model::setPauseAnimationWhenCulled(bool pauseAnimationWhenCulled){
+    this->pauseAnimationWhenCulled = pauseAnimationWhenCulled;
+}
+
+bool Model::isPauseAnimationWhenCulled(){
+    return pauseAnimationWhenCulled;
+}
+
+void Model::setAnimationBounds(Vector3 min, Vector3 max){
+    animationBounds.setExtents(min, max);
+}
+
+void Model::clearAnimationBounds(){
+    animationBounds.setNull();
+}
+
+AlignedBox Model::getAnimationBounds(){
+    return animationBounds;
+}
+
+int Model::getAnimationLODStep(){
+    if (!animationLOD)
+        return 1;
+
+    if (animationCulled)
+        return 8;
+
+    //Unknown distance before first camera update
+    if (distanceToCamera < 0)
+        return 1;
+
+    int step = 1;
+    for (int i = 0; i < 3; i++){
+        if (distanceToCamera >= animationLODDistances[i])
+            step = 2 << i;
+    }
+
+    return step;
+}
+
+Skeleton* Model::getSkeletonPose(){
+    return &skeletonPose;
+}
+
+bool Model::attachToBone(std::string boneName, Object* object){
+    int joint = skeletonPose.findJoint(boneName);
+
+    if (joint < 0){
+        Log::Error("Bone %s not exist in compact skeleton", boneName.c_str());
+        return false;
+    }
+
+    if (object->getParent() != this)
+        addObject(object);
+
+    skeletonPose.addAttachment(object, joint);
+    skeletonPose.updateAttachments();
+
+    return true;
+}
+
+void Model::detachFromBone(Object* object){
+    skeletonPose.removeAttachment(object);
+}
+
+void Model::setAnimationPoseTarget(Animation* animation, Pose* pose){
+    for (size_t i = 0; i < animation->getNumActionFrames(); i++){
+        KeyframeTrack* track = dynamic_cast<KeyframeTrack*>(animation->getActionFrame(i).action);
+
+        if (track && track->getPoseTarget())
+            track->setPoseTarget(pose, track->getJointTarget());
+    }
+}
+
+int Model::findAnimationLayer(Animation* animation){
+    for (size_t i = 0; i < animationLayers.size(); i++){
+        if (animationLayers[i]->animation == animation)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+int Model::addAnimationLayer(Animation* animation, float weight, bool additive){
+    if (!animation)
+        return -1;
+
+    int index = findAnimationLayer(animation);
+    if (index >= 0)
+        return index;
+
+    AnimationLayer* layer = new AnimationLayer();
+    layer->animation = animation;
+    layer->pose.resize(skeletonPose.size());
+    layer->weight = weight;
+    layer->targetWeight = weight;
+    layer->fadeSpeed = 0;
+    layer->stopOnFadeOut = false;
+    layer->additive = additive;
+
+    setAnimationPoseTarget(animation, &layer->pose);
+
+    animationLayers.push_back(layer);
+
+    return (int)animationLayers.size() - 1;
+}
+
+void Model::removeAnimationLayer(int layer){
+    if (layer < 0 || layer >= animationLayers.size()){
+        Log::Error("Animation layer %i not exist", layer);
+        return;
+    }
+
+    setAnimationPoseTarget(animationLayers[layer]->animation, skeletonPose.getPose());
+
+    delete animationLayers[layer];
+    animationLayers.erase(animationLayers.begin() + layer);
+
+    if (animationLayers.size() == 0)
+        skeletonPose.moveToBind();
+}
+
+void Model::clearAnimationLayers(){
+    while (animationLayers.size() > 0)
+        removeAnimationLayer((int)animationLayers.size() - 1);
+}
+
+size_t Model::getNumAnimationLayers(){
+    return animationLayers.size();
+}
+
+void Model::setLayerWeight(int layer, float weight){
+    if (layer >= 0 && layer < animationLayers.size()){
+        animationLayers[layer]->weight = weight;
+        animationLayers[layer]->targetWeight = weight;
+        animationLayers[layer]->fadeSpeed = 0;
+        animationLayers[layer]->pose.changed = true;
+    }
+}
+
+float Model::getLayerWeight(int layer){
+    if (layer >= 0 && layer < animationLayers.size())
+        return animationLayers[layer]->weight;
+
+    return 0;
+}
+
+void Model::setLayerAdditive(int layer, bool additive){
+    if (layer >= 0 && layer < animationLayers.size()){
+        animationLayers[layer]->additive = additive;
+        animationLayers[layer]->pose.changed = true;
+    }
+}
+
+bool Model::isLayerAdditive(int layer){
+    if (layer >= 0 && layer < animationLayers.size())
+        return animationLayers[layer]->additive;
+
+    return false;
+}
+
+void Model::setLayerBoneMask(int layer, std::string boneName, float weight){
+    if (layer < 0 || layer >= animationLayers.size()){
+        Log::Error("Animation layer %i not exist", layer);
+        return;
+    }
+
+    int joint = skeletonPose.findJoint(boneName);
+    if (joint < 0){
+        Log::Error("Bone %s not exist in compact skeleton", boneName.c_str());
+        return;
+    }
+
+    std::vector<float>& boneMask = animationLayers[layer]->boneMask;
+    if (boneMask.empty())
+        boneMask.assign(skeletonPose.size(), 1);
+
+    //Children are after parent in depth-first order
+    boneMask[joint] = weight;
+    for (size_t j = joint + 1; j < skeletonPose.size(); j++){
+        int parent = skeletonPose.getParent((int)j);
+        while (parent > joint)
+            parent = skeletonPose.getParent(parent);
+        if (parent != joint)
+            break;
+        boneMask[j] = weight;
+    }
+
+    animationLayers[layer]->pose.changed = true;
+}
+
+void Model::fadeLayer(int layer, float weight, float duration){
+    if (layer < 0 || layer >= animationLayers.size()){
+        Log::Error("Animation layer %i not exist", layer);
+        return;
+    }
+
+    AnimationLayer* animationLayer = animationLayers[layer];
+    animationLayer->targetWeight = weight;
+    animationLayer->stopOnFadeOut = false;
+
+    if (duration > 0)
+        animationLayer->fadeSpeed = std::fabs(weight - animationLayer->weight) / duration;
+    else
+        animationLayer->fadeSpeed = 0;
+}
+
+void Model::crossfade(Animation* animation, float duration){
+    int index = addAnimationLayer(animation, 0, false);
+    if (index < 0)
+        return;
+
+    for (size_t i = 0; i < animationLayers.size(); i++){
+        if (i != index && !animationLayers[i]->additive){
+            fadeLayer((int)i, 0, duration);
+            animationLayers[i]->stopOnFadeOut = true;
+        }
+    }
+
+    fadeLayer(index, 1, duration);
+
+    if (!animation->isRunning())
+        animation->run();
+}
+
+float Model::getLayerJointWeight(AnimationLayer* layer, size_t joint){
+    if (!layer->pose.sampled[joint])
+        return 0;
+
+    if (layer->boneMask.empty())
+        return layer->weight;
+
+    return layer->weight * layer->boneMask[joint];
+}
+
+void Model::blendAnimationLayers(float interval){
+    bool changed = false;
+
+    for (size_t i = 0; i < animationLayers.size(); i++){
+        AnimationLayer* layer = animationLayers[i];
+
+        if (layer->weight != layer->targetWeight){
+            float step = layer->fadeSpeed * interval;
+            if (layer->fadeSpeed <= 0 || std::fabs(layer->targetWeight - layer->weight) <= step)
+                layer->weight = layer->targetWeight;
+            else
+                layer->weight += (layer->targetWeight > layer->weight) ? step : -step;
+
+            if (layer->weight == 0 && layer->stopOnFadeOut){
+                layer->stopOnFadeOut = false;
+                layer->animation->stop();
+            }
+
+            changed = true;
+        }
+
+        if (layer->pose.changed){
+            layer->pose.changed = false;
+            changed = true;
+        }
+    }
+
+    if (!changed)
+        return;
+
+    Pose* pose = skeletonPose.getPose();
+    const Pose* bindPose = skeletonPose.getBindPose();
+
+    for (size_t j = 0; j < skeletonPose.size(); j++){
+        const Quaternion& bindRotation = bindPose->rotations[j];
+
+        float total = 0;
+        Vector3 position(0, 0, 0);
+        Vector3 scale(0, 0, 0);
+        Quaternion rotation(0, 0, 0, 0);
+
+        //Weighted average of layers, bind pose fills weight below 1
+        for (size_t i = 0; i < animationLayers.size(); i++){
+            AnimationLayer* layer = animationLayers[i];
+            float weight = getLayerJointWeight(layer, j);
+            if (layer->additive || weight <= 0)
+                continue;
+
+            Quaternion layerRotation = layer->pose.rotations[j];
+            if (layerRotation.dot(bindRotation) < 0)
+                layerRotation = -layerRotation;
+
+            position += layer->pose.positions[j] * weight;
+            scale += layer->pose.scales[j] * weight;
+            rotation = rotation + layerRotation * weight;
+            total += weight;
+        }
+
+        if (total < 1){
+            float remaining = 1 - total;
+            position += bindPose->positions[j] * remaining;
+            scale += bindPose->scales[j] * remaining;
+            rotation = rotation + bindRotation * remaining;
+        }else{
+            position /= total;
+            scale /= total;
+        }
+        rotation.normalise();
+
+        for (size_t i = 0; i < animationLayers.size(); i++){
+            AnimationLayer* layer = animationLayers[i];
+            float weight = getLayerJointWeight(layer, j);
+            if (!layer->additive || weight <= 0)
+                continue;
+
+            Quaternion delta = bindRotation.inverse() * layer->pose.rotations[j];
+            if (delta.w < 0)
+                delta = -delta;
+
+            //Normalized lerp from identity
+            Quaternion weightedDelta = Quaternion() * (1 - weight) + delta * weight;
+            weightedDelta.normalise();
+
+            position += (layer->pose.positions[j] - bindPose->positions[j]) * weight;
+            scale += (layer->pose.scales[j] - bindPose->scales[j]) * weight;
+            rotation = rotation * weightedDelta;
+        }
+
+        pose->positions[j] = position;
+        pose->rotations[j] = rotation;
+        pose->scales[j] = scale;
+    }
+
+    pose->changed = true;
+}
+
+bool Model::updateModelActions(bool animations, float interval){
+    bool animating = false;
+
+    for (int i = 0; i < actions.size(); i++) {
+        if ((dynamic_cast<Animation*>(actions[i]) != NULL) != animations)
+            continue;
+
+        if (actions[i]->isRunning()) {
+            actions[i]->update(interval);
+            animating = true;
+        }
+    }
+
+    return animating;
+}
+
+bool Model::isOutsideCamera(){
+    if (!scene || !scene->getCamera())
+        return false;
+
+    AlignedBox box = getWorldBounds();
+
+    //Deformed models have infinite bounds, bind pose would cull animated vertices outside it
+    if (box.isInfinite())
+        box = getDeformedBounds();
+
+    //Unknown bounds
+    if (box.isNull() || box.isInfinite())
+        return false;
+
+    return !scene->getCamera()->isInside(box, true);
+}
+
+AlignedBox Model::getDeformedBounds(){
+    AlignedBox box;
+
+    if (!animationBounds.isNull()){
+        box = animationBounds;
+    }else if (compactSkeleton && skinning && !morphTargets && !gltfBounds.isNull() && !skeletonPose.isDirty()){
+        AlignedBox joints = skeletonPose.getJointsBounds();
+        if (joints.isNull())
+            return box;
+
+        //Largest distance of bind vertices outside bind joints, vertices follow their joints
+        if (jointsBoundsMargin < 0){
+            AlignedBox bindJoints = skeletonPose.getBindJointsBounds();
+            Vector3 below = bindJoints.getMinimum() - gltfBounds.getMinimum();
+            Vector3 above = gltfBounds.getMaximum() - bindJoints.getMaximum();
+            jointsBoundsMargin = std::max({0.0f, below.x, below.y, below.z, above.x, above.y, above.z});
+        }
+
+        Vector3 margin(jointsBoundsMargin, jointsBoundsMargin, jointsBoundsMargin);
+        box.setExtents(joints.getMinimum() - margin, joints.getMaximum() + margin);
+    }else{
+        //Unknown, not culled
+        return box;
+    }
+
+    box.transformAffine(modelMatrix);
+
+    return box;
+}
+
+void Model::updateSkeletonPose(){
+    //Before model matrix, so attached objects are updated in same frame
+    if (skeletonPose.isDirty()){
+        if (bonesMatrix.size() > 0)
+            skeletonPose.update(&bonesMatrix.front(), bonesMatrix.size());
+        skeletonPose.updateAttachments();
+        requestRedraw();
+    }
+}
+
+void Model::updateActions(){
+    float interval = Engine::getSceneUpdateTime();
+
+    bool animating = false;
+    for (int i = 0; i < actions.size() && !animating; i++)
+        animating = actions[i]->isRunning() && dynamic_cast<Animation*>(actions[i]);
+
+    if (!animationLOD){
+        Mesh::updateActions();
+
+        //Layers write final pose once
+        if (animationLayers.size() > 0)
+            blendAnimationLayers(interval);
+
+        updateSkeletonPose();
+
+        if (cpuMorphs.size() > 0)
+            updateCPUMorphs();
+
+        if (animating && skinning)
+            Engine::evaluatedSkeletons++;
+
+        return;
+    }
+
+    updateModelActions(false, interval);
+
+    bool wasCulled = animationCulled;
+    animationCulled = isOutsideCamera() || !visible;
+
+    //Model entering camera starts a new window
+    if (wasCulled && !animationCulled)
+        animationLODFrame = animationLODStep;
+
+    if (animationCulled && pauseAnimationWhenCulled){
+        if (animating && skinning)
+            Engine::skippedSkeletons++;
+        return;
+    }
+
+    Pose* pose = skeletonPose.getPose();
+
+    if (animationLODFrame >= animationLODStep){
+        //Animations are sampled at end of next window and previous pose is interpolated to it
+        animationLODStep = getAnimationLODStep();
+        animationLODFrame = 0;
+
+        //Culled models keep sampled pose without interpolation
+        bool interpolate = compactSkeleton && animationLODStep > 1 && !animationCulled;
+
+        if (interpolate)
+            animationLODFrom.copy(*pose);
+
+        bool dirty = pose->changed;
+        pose->changed = false;
+
+        updateModelActions(true, interval * animationLODStep);
+        if (animationLayers.size() > 0)
+            blendAnimationLayers(interval * animationLODStep);
+
+        animationLODInterpolating = interpolate && pose->changed;
+        pose->changed = pose->changed || dirty;
+        if (animationLODInterpolating)
+            animationLODTo.copy(*pose);
+
+        if (animating && skinning)
+            Engine::evaluatedSkeletons++;
+    }else if (animating && skinning){
+        if (animationLODInterpolating)
+            Engine::interpolatedSkeletons++;
+        else
+            Engine::skippedSkeletons++;
+    }
+
+    animationLODFrame++;
+
+    if (animationLODInterpolating)
+        pose->interpolate(animationLODFrom, animationLODTo, animationLODFrame / (float)animationLODStep);
+
+    if (animationLODFrame >= animationLODStep)
+        animationLODInterpolating = false;
+
+    updateSkeletonPose();
+
+    if (cpuMorphs.size() > 0)
+        updateCPUMorphs();
+}
+
+bool Model::renderDraw(bool shadow){
+    //Bones palette and morph weights are not uploaded for models outside camera
+    if (!shadow && animationLOD && animationCulled && (skinning || morphTargets))
+        return false;
+
+    if (!paletteBuffers.empty())
+        updateBonePalettes();
+
+    return Mesh::renderDraw(shadow);
+}
+
 void Model::updateModelMatrix(){
     Mesh::updateModelMatrix();
 
-    inverseDerivedTransform = (modelMatrix * Matrix4::translateMatrix(center)).inverse();
+    inverseDerivedTransform = (modelMatrix * Matrix4::translateMatrix(center)).affineInverse();
 }
 
 bool Model::renderLoad(bool shadow) {
@@ -874,10 +1925,14 @@ bool Model::renderLoad(bool shadow) {
         instanciateRender();
 
         if (skinning){
-            render->addProperty(S_PROPERTY_BONESMATRIX, S_PROPERTYDATA_MATRIX4, bonesMatrix.size(), &bonesMatrix.front());
+            //Split palettes are properties of submeshes
+            if (paletteBuffers.empty())
+                render->addProperty(S_PROPERTY_BONESMATRIX, S_PROPERTYDATA_MATRIX4, bonesMatrix.size(), &bonesMatrix.front());
+            else
+                render->addProgramDef(S_PROGRAM_USE_SKINNING);
         }
 
-        if (morphTargets){
+        if (morphTargets && !cpuMorph){
             render->addProperty(S_PROPERTY_MORPHWEIGHTS, S_PROPERTYDATA_FLOAT1, morphWeights.size(), &morphWeights.front());
         }
 
@@ -886,10 +1941,13 @@ bool Model::renderLoad(bool shadow) {
         instanciateShadowRender();
 
         if (skinning){
-            shadowRender->addProperty(S_PROPERTY_BONESMATRIX, S_PROPERTYDATA_MATRIX4, bonesMatrix.size(), &bonesMatrix.front());
+            if (paletteBuffers.empty())
+                shadowRender->addProperty(S_PROPERTY_BONESMATRIX, S_PROPERTYDATA_MATRIX4, bonesMatrix.size(), &bonesMatrix.front());
+            else
+                shadowRender->addProgramDef(S_PROGRAM_USE_SKINNING);
         }
 
-        if (morphTargets){
+        if (morphTargets && !cpuMorph){
             shadowRender->addProperty(S_PROPERTY_MORPHWEIGHTS, S_PROPERTYDATA_FLOAT1, morphWeights.size(), &morphWeights.front());
         }
 
@@ -898,6 +1956,31 @@ bool Model::renderLoad(bool shadow) {
     return Mesh::renderLoad(shadow);
 }
 
+void Model::updateLocalBounds(){
+    //Vertices are deformed in shader
+    if (skinning || morphTargets)
+        localBounds.setInfinite();
+    else if (!gltfBounds.isNull())
+        localBounds = gltfBounds;
+    else
+        Mesh::updateLocalBounds();
+}
+
+bool Model::preload(){
+
+    baseDir = FileData::getBaseDir(filename);
+
+    std::string ext = FileData::getFilePathExtension(filename);
+
+    //OBJ files are parsed in load
+    if (ext.compare("obj") != 0) {
+        if (!readGLTF(filename))
+            return false;
+    }
+
+    return Mesh::preload();
+}
+
 bool Model::load(){
 
     baseDir = FileData::getBaseDir(filename);
@@ -912,7 +1995,7 @@ bool Model::load(){
             return false;
     }
 
-    if (skeleton)
+    if (skeleton || skeletonPose.size() > 0)
         skinning = true;
 
     return Mesh::load();
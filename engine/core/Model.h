@@ -12,7 +12,9 @@
 #include "math/Vector3.h"
 #include "io/Data.h"
 #include "util/SModelData.h"
+#include "util/Skeleton.h"
 #include "action/Animation.h"
+#include "buffer/ExternalBuffer.h"
 
 namespace tinygltf {class Model;}
 
@@ -33,20 +35,61 @@ namespace Supernova {
             int index;
         };
 
+        struct AnimationLayer{
+            Animation* animation;
+            //Tracks of animation are sampled here
+            Pose pose;
+            float weight;
+            float targetWeight;
+            float fadeSpeed;
+            bool stopOnFadeOut;
+            bool additive;
+            //Weight of each joint, empty when all joints have weight 1
+            std::vector<float> boneMask;
+        };
+
+        //Pointers because tracks keep address of layer pose
+        std::vector<AnimationLayer*> animationLayers;
+
         tinygltf::Model* gltfModel;
 
         std::map<std::string, Bone*> bonesNameMapping;
         std::map<int, Bone*> bonesIdMapping;
+        //glTF node to compact skeleton joint
+        std::map<int, int> jointsIdMapping;
 
         std::map<std::string, int> morphNameMapping;
 
         Bone* generateSketetalStructure(int nodeIndex, int skinIndex);
         Bone* findBone(Bone* bone, int boneIndex);
+        void generateCompactSkeleton(int nodeIndex, int skinIndex, int parentJoint);
+        int getSkinJoint(int nodeIndex, int skinIndex);
+        bool getInverseBindMatrix(int skinIndex, int jointIndex, Matrix4& offsetMatrix);
+        void getNodeTransform(int nodeIndex, Vector3& position, Quaternion& rotation, Vector3& scale);
+
+        void setAnimationPoseTarget(Animation* animation, Pose* pose);
+        int findAnimationLayer(Animation* animation);
+        float getLayerJointWeight(AnimationLayer* layer, size_t joint);
+        void blendAnimationLayers(float interval);
+
+        bool updateModelActions(bool animations, float interval);
+        bool isOutsideCamera();
+        void updateSkeletonPose();
+
+        bool gltfReaded;
 
         bool loadOBJ(const char * filename);
+        bool readGLTF(const char * filename);
         bool loadGLTF(const char * filename);
 
         bool loadGLTFBuffer(int bufferViewIndex);
+        std::vector<double> getAccessorValues(int accessorIndex);
+        void splitBonePalettes(int meshIndex);
+        void clearBonePalettes();
+        void updateBonePalettes();
+        void loadCPUMorph(int submeshIndex, int meshIndex, int primitiveIndex);
+        void clearCPUMorphs();
+        void updateCPUMorphs();
         std::string getBufferName(int bufferViewIndex);
 
         static bool fileExists(const std::string &abs_filename, void *);
@@ -57,12 +100,72 @@ namespace Supernova {
         Bone* skeleton;
         Matrix4 inverseDerivedTransform;
 
+        //Joints without Bone objects, used when compactSkeleton is true
+        Skeleton skeletonPose;
+        bool compactSkeleton;
+
+        //Key reduction and quantization of transform tracks
+        bool animationCompression;
+        float animationTolerance;
+        float animationAngleTolerance;
+
+        //Animations of far models are sampled every 2, 4 or 8 updates, compact skeleton is interpolated between them
+        bool animationLOD;
+        float animationLODDistances[3];
+        bool pauseAnimationWhenCulled;
+        bool animationCulled;
+        int animationLODStep;
+        int animationLODFrame;
+        bool animationLODInterpolating;
+        Pose animationLODFrom;
+        Pose animationLODTo;
+
+        //Deformed models are culled only with user bounds or evaluated joints of compact skeleton
+        AlignedBox animationBounds;
+        float jointsBoundsMargin;
+
         std::vector<Matrix4> bonesMatrix;
+
+        //Skins with more than S_MAX_BONES are drawn in submeshes with own palette
+        std::vector<Buffer*> paletteBuffers;
+        size_t paletteSubmeshes;
+
+        //Sparse deltas of vertices moved by target, 4 floats for position and 4 for normal
+        struct MorphTarget{
+            std::vector<unsigned int> vertices;
+            std::vector<float> deltas;
+            unsigned int firstVertex;
+            unsigned int lastVertex;
+        };
+
+        //Morphed positions and normals of a submesh, only changed ranges are evaluated and uploaded
+        struct CPUMorph{
+            std::string bufferName;
+            ExternalBuffer* buffer;
+            std::vector<float> base;
+            std::vector<float> values;
+            std::vector<MorphTarget> targets;
+            std::vector<float> appliedWeights;
+        };
+
+        std::vector<CPUMorph*> cpuMorphs;
+        bool cpuMorphTargets;
+        bool cpuMorph;
         std::vector<float> morphWeights;
 
         bool skinning;
         bool morphTargets;
 
+        //From accessors min and max, glTF buffers have no render attributes
+        AlignedBox gltfBounds;
+
+        AlignedBox getDeformedBounds();
+
+        virtual bool preload();
+        virtual void updateLocalBounds();
+        virtual void updateActions();
+        virtual bool renderDraw(bool shadow);
+
     public:
         Model();
         Model(const char * path);
@@ -71,6 +174,57 @@ namespace Supernova {
         Bone* getBone(std::string name);
         void updateBone(int boneIndex, Matrix4 skinning);
 
+        //Skeleton is evaluated in a flat joint array instead of Bone objects, applied on load
+        void setCompactSkeleton(bool compactSkeleton);
+        bool isCompactSkeleton();
+        Skeleton* getSkeletonPose();
+
+        //Transform tracks are reduced within tolerance and quantized on load
+        void setAnimationCompression(bool animationCompression);
+        bool isAnimationCompression();
+        //Position and scale error in model units
+        void setAnimationTolerance(float animationTolerance);
+        float getAnimationTolerance();
+        //Rotation error in default angle unit
+        void setAnimationAngleTolerance(float animationAngleTolerance);
+        float getAnimationAngleTolerance();
+
+        //Culled models are not drawn and their animations are updated every 8 frames or paused
+        void setAnimationLOD(bool animationLOD);
+        bool isAnimationLOD();
+        //Camera distances where animations start to update every 2, 4 and 8 frames
+        void setAnimationLODDistances(float half, float quarter, float eighth);
+        void setPauseAnimationWhenCulled(bool pauseAnimationWhenCulled);
+        bool isPauseAnimationWhenCulled();
+        int getAnimationLODStep();
+        //Local bounds of deformed mesh in any animation, used by culling instead of joints
+        void setAnimationBounds(Vector3 min, Vector3 max);
+        void clearAnimationBounds();
+        AlignedBox getAnimationBounds();
+
+        //Object follows the bone in compact skeleton, it is added as child of model
+        bool attachToBone(std::string boneName, Object* object);
+        void detachFromBone(Object* object);
+
+        //Animations of compact skeleton are sampled in own pose and blended by weight,
+        //additive layers add their difference to bind pose after other layers
+        int addAnimationLayer(Animation* animation, float weight, bool additive);
+        void removeAnimationLayer(int layer);
+        void clearAnimationLayers();
+        size_t getNumAnimationLayers();
+
+        void setLayerWeight(int layer, float weight);
+        float getLayerWeight(int layer);
+        void setLayerAdditive(int layer, bool additive);
+        bool isLayerAdditive(int layer);
+        //Weight of a bone and all its children in layer
+        void setLayerBoneMask(int layer, std::string boneName, float weight);
+
+        //Weight changes in duration (seconds)
+        void fadeLayer(int layer, float weight, float duration);
+        //Fades animation in and other non additive layers out, animation is added as layer and started if needed
+        void crossfade(Animation* animation, float duration);
+
         Animation* getAnimation(int index);
         Animation* findAnimation(std::string name);
 
@@ -82,6 +236,10 @@ namespace Supernova {
 
         void clearAnimations();
 
+        //Morph targets are summed in CPU, also used when mesh has more targets than vertex attributes
+        void setCPUMorphTargets(bool cpuMorphTargets);
+        bool isCPUMorphTargets();
+
         Matrix4 getInverseDerivedTransform();
 
         virtual void updateModelMatrix();
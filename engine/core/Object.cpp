@@ -4,7 +4,9 @@
 #include "Light.h"
 #include "Scene.h"
 #include "Engine.h"
+#include "util/TransformStore.h"
 #include "physics/PhysicsWorld2D.h"
+#include <climits>
 
 //
 // (c) 2018 Eduardo Doria.
@@ -14,7 +16,11 @@ using namespace Supernova;
 
 Object::Object(){
     loaded = false;
+    loadState = S_LOADSTATE_NONE;
     markToUpdate = true;
+    actionsUpdated = false;
+    transformStore = NULL;
+    transformIndex = -1;
     
     parent = NULL;
     scene = NULL;
@@ -23,6 +29,10 @@ Object::Object(){
     ownedBody = true;
     allowBodyUpdate = true;
 
+    interpolation = false;
+    interpolated = false;
+    interpolationStep = ULONG_MAX;
+
     viewMatrix = NULL;
     projectionMatrix = NULL;
     viewProjectionMatrix = NULL;
@@ -35,6 +45,8 @@ Object::Object(){
 }
 
 Object::~Object(){
+
+    cancelLoadAsync();
     
     if (parent)
         parent->removeObject(this);
@@ -74,6 +86,10 @@ void Object::setSceneAndConfigure(Scene* scene){
         if (SkyBox *sky_ptr = dynamic_cast<SkyBox *>(this)) {
             scene->setSky(sky_ptr);
         }
+
+        if (interpolation) {
+            scene->addInterpolatedObject(this);
+        }
     }
 
     if (Scene *scene_ptr = dynamic_cast<Scene *>(this)) {
@@ -83,6 +99,13 @@ void Object::setSceneAndConfigure(Scene* scene){
 }
 
 void Object::removeScene(){
+    if (scene && interpolation)
+        scene->removeInterpolatedObject(this);
+
+    for (int i = 0; i < actions.size(); i++) {
+        actions[i]->unschedule();
+    }
+
     this->scene = NULL;
     
     std::vector<Object*>::iterator it;
@@ -98,6 +121,9 @@ void Object::addObject(Object* obj){
         }
 
         if (obj->parent == NULL) {
+            if (transformStore)
+                transformStore->invalidate();
+
             objects.push_back(obj);
 
             obj->parent = this;
@@ -118,7 +144,7 @@ void Object::addObject(Object* obj){
 
             obj->needUpdate();
 
-            if (loaded)
+            if (loaded && obj->loadState != S_LOADSTATE_LOADING)
                 obj->load();
         } else {
             Log::Error("Object has a parent already");
@@ -153,9 +179,17 @@ void Object::removeObject(Object* obj){
         scene_ptr->childScene = false;
     }
     
+    if (obj->transformStore)
+        obj->transformStore->invalidate();
+
+    if (scene)
+        scene->shadowCastersVersion++;
+
     std::vector<Object*>::iterator i = std::remove(objects.begin(), objects.end(), obj);
     objects.erase(i,objects.end());
     
+    requestRedraw();
+
     obj->parent = NULL;
     obj->removeScene();
     
@@ -271,6 +305,9 @@ Matrix4 Object::getTransformMatrix(){
 }
 
 Matrix4 Object::getModelMatrix(){
+    if (transformStore && !interpolated)
+        return transformStore->getWorldMatrix(transformIndex);
+
     return modelMatrix;
 }
 
@@ -305,6 +342,9 @@ void Object::moveTo(int index){
     if (parent != NULL){
         int pos = parent->find(this);
         if ((index >= 0) && (index <= (parent->objects.size()-1))) {
+            if (pos != index && transformStore)
+                transformStore->invalidate();
+
             if (pos < index) {
                 Object *temp = parent->objects[pos];
 
@@ -339,6 +379,9 @@ void Object::moveDown(){
         int pos = parent->find(this);
         
         if (pos > 0){
+            if (transformStore)
+                transformStore->invalidate();
+
             Object* temp = parent->objects[pos];
             parent->objects[pos] = parent->objects[pos-1];
             parent->objects[pos-1] = temp;
@@ -351,6 +394,9 @@ void Object::moveUp(){
         int pos = parent->find(this);
         
         if ((pos >= 0) && (pos < (parent->objects.size()-1))){
+            if (transformStore)
+                transformStore->invalidate();
+
             Object* temp = parent->objects[pos];
             parent->objects[pos] = parent->objects[pos+1];
             parent->objects[pos+1] = temp;
@@ -392,6 +438,7 @@ void Object::addAction(Action* action){
 
 void Object::removeAction(Action* action){
     if (action->object == this){
+        action->unschedule();
         std::vector<Action*>::iterator i = std::remove(actions.begin(), actions.end(), action);
         actions.erase(i,actions.end());
         action->object = NULL;
@@ -416,20 +463,16 @@ void Object::updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatrix, Matr
     
 }
 
-void Object::updateModelMatrix(){
-    markToUpdate = false;
-
-    Matrix4 centerMatrix = Matrix4::translateMatrix(-center);
-    Matrix4 scaleMatrix = Matrix4::scaleMatrix(scale);
-    Matrix4 translateMatrix = Matrix4::translateMatrix(position);
-    Matrix4 rotationMatrix = rotation.getRotationMatrix();
-
-    this->transformMatrix = translateMatrix * rotationMatrix * scaleMatrix;
-    this->modelMatrix = this->transformMatrix * centerMatrix;
+void Object::updateWorldValues(){
+    //Keeps world values of last fixed update, once per update step
+    bool keepPrevious = (interpolation && interpolationStep != Engine::getUpdateSteps());
+    if (keepPrevious && interpolationStep != ULONG_MAX){
+        previousWorldPosition = worldPosition;
+        previousWorldRotation = worldRotation;
+        previousWorldScale = worldScale;
+    }
 
     if (parent != NULL){
-        Matrix4 parentCenterMatrix = Matrix4::translateMatrix(parent->center);
-        this->modelMatrix = parent->modelMatrix * parentCenterMatrix * this->modelMatrix;
         worldRotation = parent->worldRotation * rotation;
         worldScale = Vector3(parent->worldScale.x * scale.x, parent->worldScale.y * scale.y, parent->worldScale.z * scale.z);
         worldPosition = modelMatrix * center;
@@ -439,6 +482,53 @@ void Object::updateModelMatrix(){
         worldPosition = position;
     }
 
+    if (keepPrevious){
+        //First update has no previous values to blend
+        if (interpolationStep == ULONG_MAX){
+            previousWorldPosition = worldPosition;
+            previousWorldRotation = worldRotation;
+            previousWorldScale = worldScale;
+        }
+        interpolationStep = Engine::getUpdateSteps();
+    }
+}
+
+void Object::updateWorldTransform(){
+    if (parent != NULL){
+        TransformStore::computeMatrices(position, rotation, scale, center, &parent->modelMatrix, parent->center, transformMatrix, modelMatrix);
+    }else{
+        TransformStore::computeMatrices(position, rotation, scale, center, NULL, Vector3(), transformMatrix, modelMatrix);
+    }
+
+    if (transformStore)
+        transformStore->setMatrices(transformIndex, transformMatrix, modelMatrix);
+
+    updateWorldValues();
+}
+
+void Object::updateModelMatrix(){
+    markToUpdate = false;
+
+    //Matrices computed before by TransformStore::updateWorldTransforms
+    bool computed = (transformStore && transformStore->isComputed(transformIndex));
+    if (computed){
+        transformMatrix = transformStore->getTransformMatrix(transformIndex);
+        modelMatrix = transformStore->getWorldMatrix(transformIndex);
+        updateWorldValues();
+    }else{
+        updateWorldTransform();
+    }
+    if (transformStore)
+        transformStore->setDirty(transformIndex, false);
+
+    //Children computed before by parallel update used old values
+    //and child scenes are not marked by parent TransformStore
+    std::vector<Object*>::iterator it;
+    for (it = objects.begin(); it != objects.end(); ++it) {
+        if (!computed || !(*it)->markToUpdate)
+            (*it)->needUpdate();
+    }
+
     updateMVPMatrix();
 
     if (allowBodyUpdate) {
@@ -446,7 +536,21 @@ void Object::updateModelMatrix(){
     }
 }
 
+void Object::requestRedraw(){
+    if (scene)
+        scene->redrawRequested = true;
+}
+
 void Object::needUpdate(){
+    requestRedraw();
+
+    //Descendants are marked by TransformStore::propagateDirty or by updateModelMatrix
+    if (transformStore){
+        markToUpdate = true;
+        transformStore->setLocalTransform(transformIndex, position, rotation, scale, center);
+        return;
+    }
+
     if (!markToUpdate) {
         markToUpdate = true;
 
@@ -470,6 +574,51 @@ bool Object::isIn3DScene(){
     return false;
 }
 
+void Object::setInterpolation(bool interpolation){
+    if (this->interpolation == interpolation)
+        return;
+
+    this->interpolation = interpolation;
+    interpolationStep = ULONG_MAX;
+
+    if (scene && scene != this){
+        if (interpolation)
+            scene->addInterpolatedObject(this);
+        else
+            scene->removeInterpolatedObject(this);
+    }
+}
+
+bool Object::isInterpolation(){
+    return interpolation;
+}
+
+void Object::interpolateTransform(float alpha){
+    //Only objects changed in last fixed update are blended
+    if (interpolationStep != Engine::getUpdateSteps() || alpha >= 1)
+        return;
+
+    Vector3 position = previousWorldPosition + (worldPosition - previousWorldPosition) * alpha;
+    Quaternion rotation = Quaternion().slerp(alpha, previousWorldRotation, worldRotation);
+    Vector3 scale = previousWorldScale + (worldScale - previousWorldScale) * alpha;
+
+    fixedModelMatrix = modelMatrix;
+    modelMatrix = Matrix4::translateMatrix(position) * rotation.getRotationMatrix() * Matrix4::scaleMatrix(scale) * Matrix4::translateMatrix(-center);
+    interpolated = true;
+
+    updateMVPMatrix();
+}
+
+void Object::restoreTransform(){
+    if (!interpolated)
+        return;
+
+    modelMatrix = fixedModelMatrix;
+    interpolated = false;
+
+    updateMVPMatrix();
+}
+
 void Object::setOwnedBody(bool ownedBody){
     this->ownedBody = ownedBody;
 }
@@ -532,7 +681,7 @@ void Object::updateFromBody(){
         if (body->isWorldSpace()) {
 
             if (getWorldPosition() != bodyPosition) {
-                position = parent->getModelMatrix().inverse() * bodyPosition;
+                position = parent->getModelMatrix().affineInverse() * bodyPosition;
                 needUpdateBody = true;
             }
 
@@ -567,6 +716,10 @@ bool Object::isLoaded(){
     return loaded;
 }
 
+int Object::getLoadState(){
+    return loadState;
+}
+
 bool Object::isMarkToUpdate(){
     return markToUpdate;
 }
@@ -585,18 +738,79 @@ bool Object::load(){
 
     std::vector<Object*>::iterator it;
     for (it = objects.begin(); it != objects.end(); ++it) {
-        (*it)->load();
+        if ((*it)->loadState != S_LOADSTATE_LOADING)
+            (*it)->load();
     }
 
     if (scene && body && scene->physicsWorld)
         scene->getPhysicsWorld()->addBody(body);
 
     loaded = true;
+    loadState = S_LOADSTATE_LOADED;
+
+    requestRedraw();
 
     return loaded;
 
 }
 
+bool Object::preload(){
+    //Children are preloaded from list of loadAsync
+    return true;
+}
+
+void Object::addPreloadObjects(std::vector<void*>& preloadObjects){
+    std::vector<Object*>::iterator it;
+    for (it = objects.begin(); it != objects.end(); ++it) {
+        //Children with own loadAsync preload their subtree
+        if ((*it)->loadState != S_LOADSTATE_LOADING){
+            preloadObjects.push_back(*it);
+            (*it)->addPreloadObjects(preloadObjects);
+        }
+    }
+}
+
+void Object::cancelLoadAsync(){
+    //Also removes object from preload of an ancestor
+    AsyncLoader::cancel(this);
+
+    if (loadState == S_LOADSTATE_LOADING)
+        loadState = S_LOADSTATE_NONE;
+}
+
+bool Object::loadAsync(){
+    if (loadState == S_LOADSTATE_LOADING)
+        return false;
+
+    loadState = S_LOADSTATE_LOADING;
+
+    //Tree is read here, main thread can change it while loader thread works
+    std::vector<void*> preloadObjects;
+    addPreloadObjects(preloadObjects);
+
+    AsyncLoader::add(this, preloadObjects, [this](const std::vector<void*>& preloadObjects){
+        if (!preload())
+            return false;
+
+        for (size_t i = 0; i < preloadObjects.size(); i++){
+            if (!((Object*)preloadObjects[i])->preload())
+                return false;
+        }
+
+        return true;
+    }, [this](bool success){
+        loadState = S_LOADSTATE_NONE;
+
+        if (success)
+            success = load();
+
+        loadState = (success)?S_LOADSTATE_LOADED:S_LOADSTATE_FAILED;
+        onLoad.call(this);
+    });
+
+    return true;
+}
+
 bool Object::draw(){
     if (position.z != 0){
         setSceneDepth(true);
@@ -613,13 +827,22 @@ bool Object::draw(){
     return loaded;
 }
 
-void Object::update(){
-
+void Object::updateActions(){
     for (int i = 0; i < actions.size(); i++) {
-        if (actions[i]->isRunning()) {
-            actions[i]->update(Engine::getSceneUpdateTime());
+        if (actions[i]->isRunning() && !actions[i]->scheduled) {
+            //After first update actions can be batched in scene
+            if (actions[i]->update(Engine::getSceneUpdateTime()) && scene)
+                actions[i]->schedule(scene);
         }
     }
+}
+
+void Object::update(){
+
+    if (!actionsUpdated) {
+        updateActions();
+    }
+    actionsUpdated = false;
 
     if (markToUpdate) {
         updateModelMatrix();
@@ -639,6 +862,8 @@ void Object::destroy(){
     }
 
     loaded = false;
+    if (loadState != S_LOADSTATE_LOADING)
+        loadState = S_LOADSTATE_NONE;
 
 }
 
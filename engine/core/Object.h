@@ -12,19 +12,43 @@
 #include "math/Quaternion.h"
 #include "action/Action.h"
 #include "physics/Body2D.h"
+#include "util/AsyncLoader.h"
+#include "util/FunctionSubscribe.h"
 
 namespace Supernova {
 
     class Scene;
+    class TransformStore;
 
     class Object {
 
+        friend class Scene;
+        friend class TransformStore;
+
     private:
 
         bool markToUpdate;
+        bool actionsUpdated;
+
+        //Set while object is in a valid scene TransformStore
+        TransformStore* transformStore;
+        int transformIndex;
 
         bool ownedBody;
         bool allowBodyUpdate;
+
+        bool interpolation;
+        bool interpolated;
+        unsigned long interpolationStep;
+        Vector3 previousWorldPosition;
+        Quaternion previousWorldRotation;
+        Vector3 previousWorldScale;
+        Matrix4 fixedModelMatrix;
+
+        //World position, rotation, scale and previous values after model matrix is set
+        void updateWorldValues();
+        void interpolateTransform(float alpha);
+        void restoreTransform();
         
         void setSceneAndConfigure(Scene* scene);
         void removeScene();
@@ -33,6 +57,7 @@ namespace Supernova {
     protected:
         
         bool loaded;
+        int loadState;
 
         std::vector<Object*> objects;
 
@@ -63,6 +88,17 @@ namespace Supernova {
         
         bool reload();
 
+        //Called in loader thread by loadAsync, only CPU work (no render API) and without reading children
+        virtual bool preload();
+        void addPreloadObjects(std::vector<void*>& preloadObjects);
+        //Waits running preload and discards pending one, must be first call in
+        //destructors of classes that free data used by preload
+        void cancelLoadAsync();
+
+        virtual void updateActions();
+        //Only computes transform, model and world values, root of a TransformStore runs it in parallel update
+        void updateWorldTransform();
+
         virtual void updateMVPMatrix();
         virtual void updateModelMatrix();
         virtual void updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatrix, Matrix4* viewProjectionMatrix, Vector3* cameraPosition);
@@ -71,6 +107,8 @@ namespace Supernova {
         Object();
         virtual ~Object();
 
+        FunctionSubscribe<void(Object*)> onLoad;
+
         Object* getObject(unsigned int index) const;
         const std::vector<Object *> &getObjects() const;
 
@@ -113,6 +151,7 @@ namespace Supernova {
         
         bool isIn3DScene();
         bool isLoaded();
+        int getLoadState();
         bool isMarkToUpdate();
 
         int find(Object* object);
@@ -124,6 +163,10 @@ namespace Supernova {
 
         void lookAt(Vector3 target, Vector3 up = Vector3(0, 1, 0));
 
+        //Blends rendering between last two fixed updates, only with fixed time scene update
+        void setInterpolation(bool interpolation);
+        bool isInterpolation();
+
         void setOwnedBody(bool ownedBody);
 
         Body2D* createBody2D();
@@ -136,8 +179,11 @@ namespace Supernova {
         void updateFromBody();
 
         virtual void needUpdate();
+        //Marks scene to be drawn when Engine renders on demand
+        void requestRedraw();
 
         virtual bool load();
+        bool loadAsync();
         virtual bool draw();
         virtual void update();
         virtual void destroy();
@@ -2,11 +2,13 @@
 
 #include "Log.h"
 #include "math/Angle.h"
+#include <algorithm>
 
 using namespace Supernova;
 
 Particles::Particles(): Points(){
-    this->lastUsedParticle = 0;
+    this->liveParticles = 0;
+    this->revivedParticles = false;
 
     this->maxParticles = 100;
     this->minRate = 10;
@@ -21,7 +23,7 @@ Particles::Particles(int numParticles): Particles(){
 
 
 Particles::~Particles(){
-    
+
 }
 
 void Particles::addPoint(){
@@ -37,20 +39,37 @@ void Particles::clearPoints(){
 }
 
 void Particles::addParticle(){
-    Points::addPoint();
-    setParticleVisible(points.size()-1, false);
-    particles.push_back({-1, Vector3(0,0,0), Vector3(0,0,0)});
+    Vector4 color = *getMaterial()->getColor();
+
+    positions.insert(positions.end(), {0, 0, 0});
+    velocities.insert(velocities.end(), {0, 0, 0});
+    accelerations.insert(accelerations.end(), {0, 0, 0});
+    colors.insert(colors.end(), {color.x, color.y, color.z, color.w});
+    sizes.push_back(1);
+    rotations.push_back(0);
+    lifes.push_back(-1);
+    sprites.push_back(-1);
+    visibles.push_back(0);
 }
 
 void Particles::addParticle(Vector3 position){
-    Points::addPoint();
-    setParticlePosition(points.size()-1, position);
-    setParticleVisible(points.size()-1, false);
-    particles.push_back({-1, Vector3(0,0,0), Vector3(0,0,0)});
+    addParticle();
+    setParticlePosition((int)lifes.size()-1, position);
 }
 
 void Particles::clearParticles(){
-    Points::clearPoints();
+    positions.clear();
+    velocities.clear();
+    accelerations.clear();
+    colors.clear();
+    sizes.clear();
+    rotations.clear();
+    lifes.clear();
+    sprites.clear();
+    visibles.clear();
+
+    liveParticles = 0;
+    revivedParticles = false;
 }
 
 void Particles::setMaxParticles(int maxParticles){
@@ -61,9 +80,31 @@ int Particles::getMaxParticles(){
     return maxParticles;
 }
 
+void Particles::swapParticles(int a, int b){
+    if (a == b)
+        return;
+
+    for (int c = 0; c < 3; c++){
+        std::swap(positions[a*3+c], positions[b*3+c]);
+        std::swap(velocities[a*3+c], velocities[b*3+c]);
+        std::swap(accelerations[a*3+c], accelerations[b*3+c]);
+    }
+    for (int c = 0; c < 4; c++){
+        std::swap(colors[a*4+c], colors[b*4+c]);
+    }
+    std::swap(sizes[a], sizes[b]);
+    std::swap(rotations[a], rotations[b]);
+    std::swap(lifes[a], lifes[b]);
+    std::swap(sprites[a], sprites[b]);
+    std::swap(visibles[a], visibles[b]);
+}
+
 void Particles::setParticlePosition(int particle, Vector3 position){
-    if ((particle >= 0) && (particle < particles.size()))
-        setPointPosition(particle, position);
+    if ((particle >= 0) && (particle < lifes.size())){
+        positions[particle*3] = position.x;
+        positions[particle*3+1] = position.y;
+        positions[particle*3+2] = position.z;
+    }
 }
 
 void Particles::setParticlePosition(int particle, float x, float y, float z){
@@ -71,101 +112,133 @@ void Particles::setParticlePosition(int particle, float x, float y, float z){
 }
 
 void Particles::setParticleSize(int particle, float size){
-    if ((particle >= 0) && (particle < particles.size()))
-        setPointSize(particle, size);
+    if ((particle >= 0) && (particle < lifes.size()))
+        sizes[particle] = size;
 }
 
 void Particles::setParticleColor(int particle, Vector4 color){
-    if ((particle >= 0) && (particle < particles.size()))
-        setPointColor(particle, color);
+    if ((particle >= 0) && (particle < lifes.size())){
+        colors[particle*4] = color.x;
+        colors[particle*4+1] = color.y;
+        colors[particle*4+2] = color.z;
+        colors[particle*4+3] = color.w;
+    }
 }
 
 void Particles::setParticleColor(int particle, float red, float green, float blue, float alpha){
-    if ((particle >= 0) && (particle < particles.size()))
-        setPointColor(particle, Vector4(red, green, blue, alpha));
+    setParticleColor(particle, Vector4(red, green, blue, alpha));
 }
 
 void Particles::setParticleRotation(int particle, float rotation){
-    if ((particle >= 0) && (particle < particles.size()))
-        setPointRotation(particle, rotation);
+    if ((particle >= 0) && (particle < lifes.size()))
+        rotations[particle] = Angle::defaultToRad(rotation);
 }
 
 void Particles::setParticleSprite(int particle, int index){
-    if ((particle >= 0) && (particle < particles.size()))
-        setPointSprite(particle, index);
+    if ((particle >= 0) && (particle < lifes.size())){
+        sprites[particle] = index;
+
+        if (index >= 0 && !useTextureRects) {
+            useTextureRects = true;
+            if (loaded)
+                reload();
+        }
+    }
 }
 
 void Particles::setParticleVisible(int particle, bool visible){
-    if ((particle >= 0) && (particle < particles.size()))
-        setPointVisible(particle, visible);
+    if ((particle >= 0) && (particle < lifes.size()))
+        visibles[particle] = visible;
 }
 
 void Particles::setParticleLife(int particle, float life){
-    if ((particle >= 0) && (particle < particles.size())){
-        particles[particle].life = life;
-
-        if (life > 0){
-            setParticleVisible(particle, true);
-        }else{
-            setParticleVisible(particle, false);
+    if ((particle >= 0) && (particle < lifes.size())){
+
+        lifes[particle] = life;
+        visibles[particle] = (life > 0);
+
+        if (life > 0 && particle >= liveParticles){
+            if (particle == liveParticles){
+                //Revived particles after it are also joined, so findUnusedParticle returns a dead one
+                while (liveParticles < lifes.size() && lifes[liveParticles] > 0)
+                    liveParticles++;
+            }else{
+                revivedParticles = true;
+            }
         }
 
     }
 }
 
 void Particles::setParticleVelocity(int particle, Vector3 velocity){
-    if ((particle >= 0) && (particle < particles.size())){
-        particles[particle].velocity = velocity;
+    if ((particle >= 0) && (particle < lifes.size())){
+        velocities[particle*3] = velocity.x;
+        velocities[particle*3+1] = velocity.y;
+        velocities[particle*3+2] = velocity.z;
     }
 }
 
 void Particles::setParticleAcceleration(int particle, Vector3 acceleration){
-    if ((particle >= 0) && (particle < particles.size())){
-        particles[particle].acceleration = acceleration;
+    if ((particle >= 0) && (particle < lifes.size())){
+        accelerations[particle*3] = acceleration.x;
+        accelerations[particle*3+1] = acceleration.y;
+        accelerations[particle*3+2] = acceleration.z;
     }
 }
 
 Vector3 Particles::getParticlePosition(int particle){
-    return getPointPosition(particle);
+    if ((particle >= 0) && (particle < lifes.size())){
+        return Vector3(positions[particle*3], positions[particle*3+1], positions[particle*3+2]);
+    }
+    return Vector3(0,0,0);
 }
 
 float Particles::getParticleSize(int particle){
-    return getPointSize(particle);
+    if ((particle >= 0) && (particle < lifes.size())){
+        return sizes[particle];
+    }
+    return -1;
 }
 
 Vector4 Particles::getParticleColor(int particle){
-    return getPointColor(particle);
+    if ((particle >= 0) && (particle < lifes.size())){
+        return Vector4(colors[particle*4], colors[particle*4+1], colors[particle*4+2], colors[particle*4+3]);
+    }
+    return Vector4(0,0,0,0);
 }
 
 float Particles::getParticleRotation(int particle){
-    return getPointRotation(particle);
+    if ((particle >= 0) && (particle < lifes.size())){
+        return Angle::radToDefault(rotations[particle]);
+    }
+    return 0.0;
 }
 
 float Particles::getParticleLife(int particle){
-    if ((particle >= 0) && (particle < particles.size())){
-        return particles[particle].life;
+    if ((particle >= 0) && (particle < lifes.size())){
+        return lifes[particle];
     }
     return -1;
 }
 
 Vector3 Particles::getParticleVelocity(int particle){
-    if ((particle >= 0) && (particle < particles.size())){
-        return particles[particle].velocity;
+    if ((particle >= 0) && (particle < lifes.size())){
+        return Vector3(velocities[particle*3], velocities[particle*3+1], velocities[particle*3+2]);
     }
     return Vector3(0,0,0);
 }
 
 Vector3 Particles::getParticleAcceleration(int particle){
-    if ((particle >= 0) && (particle < particles.size())){
-        return particles[particle].acceleration;
+    if ((particle >= 0) && (particle < lifes.size())){
+        return Vector3(accelerations[particle*3], accelerations[particle*3+1], accelerations[particle*3+2]);
     }
     return Vector3(0,0,0);
 }
 
 void Particles::createParticles(){
-    
+
     clearParticles();
-    
+
     for (int i = 0; i < maxParticles; i++){
         addParticle();
     }
@@ -204,37 +277,170 @@ int Particles::getMaxRate(){
 }
 
 int Particles::findUnusedParticle(){
-    
-    for (int i=lastUsedParticle; i<maxParticles; i++){
-        if (particles[i].life <= 0){
-            lastUsedParticle = i;
-            return i;
+    if (liveParticles < lifes.size())
+        return liveParticles;
+
+    return -1;
+}
+
+int Particles::getParticlesSize(){
+    return (int)lifes.size();
+}
+
+int Particles::getLiveParticles(){
+    return liveParticles;
+}
+
+void Particles::compactParticles(){
+    if (revivedParticles){
+        for (int i = liveParticles; i < lifes.size(); i++){
+            if (lifes[i] > 0){
+                swapParticles(i, liveParticles);
+                liveParticles++;
+            }
         }
+        revivedParticles = false;
     }
-    
-    for (int i=0; i<lastUsedParticle; i++){
-        if (particles[i].life <= 0){
-            lastUsedParticle = i;
-            return i;
+
+    int i = 0;
+    while (i < liveParticles){
+        if (lifes[i] <= 0){
+            liveParticles--;
+            swapParticles(i, liveParticles);
+        }else{
+            i++;
         }
     }
-    
-    return -1;
+}
+
+float* Particles::getPositionsData(){
+    return positions.data();
+}
+
+float* Particles::getVelocitiesData(){
+    return velocities.data();
+}
+
+float* Particles::getAccelerationsData(){
+    return accelerations.data();
+}
+
+float* Particles::getColorsData(){
+    return colors.data();
+}
+
+float* Particles::getSizesData(){
+    return sizes.data();
+}
+
+float* Particles::getRotationsData(){
+    return rotations.data();
+}
+
+float* Particles::getLifesData(){
+    return lifes.data();
+}
+
+Rect Particles::getSpriteRect(int sprite){
+    std::map<int,Rect>::iterator it = spriteRects.find(sprite);
+    if (it != spriteRects.end())
+        return it->second;
+
+    Rect rect(0, 0, 1, 1);
+    if (framesRect.count(sprite) > 0){
+        rect = framesRect[sprite].rect;
+        if (!rect.isNormalized() && texWidth != 0 && texHeight != 0){
+            rect.setRect(rect.getX() / (float) texWidth,
+                         rect.getY() / (float) texHeight,
+                         rect.getWidth() / (float) texWidth,
+                         rect.getHeight() / (float) texHeight);
+        }
+    }
+
+    spriteRects[sprite] = rect;
+
+    return rect;
+}
+
+void Particles::copyBuffer(){
+    buffer.clearAll();
+    buffer.addAttribute(S_VERTEXATTRIBUTE_VERTICES, 3);
+    buffer.addAttribute(S_VERTEXATTRIBUTE_NORMALS, 3);
+    buffer.addAttribute(S_VERTEXATTRIBUTE_POINTSIZES, 1);
+    buffer.addAttribute(S_VERTEXATTRIBUTE_POINTCOLORS, 4);
+    buffer.addAttribute(S_VERTEXATTRIBUTE_POINTROTATIONS, 1);
+    if (useTextureRects)
+        buffer.addAttribute(S_VERTEXATTRIBUTE_TEXTURERECTS, 4);
+
+    sortedParticles.clear();
+    for (int i = 0; i < liveParticles; i++){
+        if (lifes[i] > 0 && visibles[i]){
+            sortedParticles.push_back(i);
+            if (colors[i*4+3] != 1)
+                transparent = true;
+        }
+    }
+
+    //Farthest first, distances are computed once for each particle
+    if (shouldSort()) {
+        sortDistances.resize(lifes.size());
+        for (size_t s = 0; s < sortedParticles.size(); s++){
+            int i = sortedParticles[s];
+            Vector3 position(positions[i*3], positions[i*3+1], positions[i*3+2]);
+            sortDistances[i] = (cameraPosition - (modelMatrix * position)).length();
+        }
+
+        std::sort(sortedParticles.begin(), sortedParticles.end(), [this](int a, int b) -> bool {
+            return sortDistances[a] > sortDistances[b];
+        });
+    }
+
+    Attribute* attVertices = buffer.getAttribute(S_VERTEXATTRIBUTE_VERTICES);
+    Attribute* attNormals = buffer.getAttribute(S_VERTEXATTRIBUTE_NORMALS);
+    Attribute* attSizes = buffer.getAttribute(S_VERTEXATTRIBUTE_POINTSIZES);
+    Attribute* attColors = buffer.getAttribute(S_VERTEXATTRIBUTE_POINTCOLORS);
+    Attribute* attRotations = buffer.getAttribute(S_VERTEXATTRIBUTE_POINTROTATIONS);
+    Attribute* attTextureRects = buffer.getAttribute(S_VERTEXATTRIBUTE_TEXTURERECTS);
+
+    spriteRects.clear();
+
+    for (size_t s = 0; s < sortedParticles.size(); s++){
+        int i = sortedParticles[s];
+
+        buffer.addVector3(attVertices, Vector3(positions[i*3], positions[i*3+1], positions[i*3+2]));
+        buffer.addVector3(attNormals, Vector3(0.0, 0.0, 1.0));
+        buffer.addFloat(attSizes, sizes[i]);
+        buffer.addVector4(attColors, Vector4(colors[i*4], colors[i*4+1], colors[i*4+2], colors[i*4+3]));
+        buffer.addFloat(attRotations, rotations[i]);
+        if (useTextureRects)
+            buffer.addVector4(attTextureRects, getSpriteRect(sprites[i]).getVector());
+    }
 }
 
 void Particles::updateParticles(){
-    updatePoints();
+    copyBuffer();
+
+    if (loaded)
+        updateBuffer(defaultBuffer);
+}
+
+void Particles::updateModelMatrix(){
+    Points::updateModelMatrix();
+
+    //Points sorting is over empty points vector, particles are sorted here
+    if (shouldSort())
+        updateParticles();
 }
 
 bool Particles::load(){
-    
+
     createParticles();
-    
+
     return Points::load();
 }
 
 
 bool Particles::draw(){
-    
+
     return Points::draw();
 }
@@ -8,39 +8,53 @@ namespace Supernova {
     class Particles: public Points{
 
     private:
-        int lastUsedParticle;
-        
+        //Normalized texture rects of sprite frames, built when buffer is copied
+        std::map<int,Rect> spriteRects;
+        std::vector<int> sortedParticles;
+        std::vector<float> sortDistances;
+
         void createParticles();
-        
+        void swapParticles(int a, int b);
+        Rect getSpriteRect(int sprite);
+
     protected:
 
-        struct ParticleData{
-            float life;
-            Vector3 velocity;
-            Vector3 acceleration;
-        };
+        //Structure of arrays, live particles are always in [0, liveParticles)
+        std::vector<float> positions; //3 floats per particle
+        std::vector<float> velocities; //3 floats per particle
+        std::vector<float> accelerations; //3 floats per particle
+        std::vector<float> colors; //4 floats per particle
+        std::vector<float> sizes;
+        std::vector<float> rotations; //radians
+        std::vector<float> lifes;
+        std::vector<int> sprites; //-1 is full texture
+        std::vector<unsigned char> visibles;
+        int liveParticles;
+        //Dead particles given life after live range, they are moved to it in compactParticles
+        bool revivedParticles;
 
-        std::vector<ParticleData> particles;
         int maxParticles;
         int minRate; //per second
         int maxRate;
-        
+
+        virtual void copyBuffer();
+
     public:
         Particles();
         Particles(int numParticles);
         virtual ~Particles();
-        
+
         void setMaxParticles(int maxParticles);
         int getMaxParticles();
-        
+
         virtual void addPoint();
         virtual void addPoint(Vector3 position);
         virtual void clearPoints();
-        
+
         void addParticle();
         void addParticle(Vector3 position);
         void clearParticles();
-        
+
         void setParticlePosition(int particle, Vector3 position);
         void setParticlePosition(int particle, float x, float y, float z);
         void setParticleSize(int particle, float size);
@@ -49,10 +63,11 @@ namespace Supernova {
         void setParticleRotation(int particle, float rotation);
         void setParticleSprite(int particle, int index);
         void setParticleVisible(int particle, bool visible);
+        //Particle keeps its index, live range only grows when particle is at its end
         void setParticleLife(int particle, float life);
         void setParticleVelocity(int particle, Vector3 velocity);
         void setParticleAcceleration(int particle, Vector3 acceleration);
-        
+
         Vector3 getParticlePosition(int particle);
         float getParticleSize(int particle);
         Vector4 getParticleColor(int particle);
@@ -68,11 +83,27 @@ namespace Supernova {
 
         int getMinRate();
         int getMaxRate();
-        
+
         int findUnusedParticle();
 
+        int getParticlesSize();
+        int getLiveParticles();
+        //Moves particles without life out of live range, indexes of live particles can change
+        void compactParticles();
+
+        //Packed arrays for range operations of ParticleInit and ParticleMod
+        float* getPositionsData();
+        float* getVelocitiesData();
+        float* getAccelerationsData();
+        float* getColorsData();
+        float* getSizesData();
+        float* getRotationsData();
+        float* getLifesData();
+
         void updateParticles();
 
+        virtual void updateModelMatrix();
+
         virtual bool load();
         virtual bool draw();
     };
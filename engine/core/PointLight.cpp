@@ -1,6 +1,5 @@
 #include "PointLight.h"
 #include "math/Angle.h"
-#include "util/UniqueToken.h"
 #include "Scene.h"
 
 using namespace Supernova;
@@ -19,37 +18,54 @@ void PointLight::updateLightCamera(){
 
     lightCameras[0]->setPosition(getWorldPosition());
     lightCameras[0]->setView(getWorldPosition() + Vector3(1,0,0));
-    lightCameras[0]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, 100 * power);
+    lightCameras[0]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, getRange());
     lightCameras[0]->setUp(0, -1, 0);
 
     lightCameras[1]->setPosition(getWorldPosition());
     lightCameras[1]->setView(getWorldPosition() + Vector3(-1,0,0));
-    lightCameras[1]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, 100 * power);
+    lightCameras[1]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, getRange());
     lightCameras[1]->setUp(0, -1, 0);
 
     lightCameras[2]->setPosition(getWorldPosition());
     lightCameras[2]->setView(getWorldPosition() + Vector3(0,1,0));
-    lightCameras[2]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, 100 * power);
+    lightCameras[2]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, getRange());
     lightCameras[2]->setUp(0, 0, 1);
 
     lightCameras[3]->setPosition(getWorldPosition());
     lightCameras[3]->setView(getWorldPosition() + Vector3(0,-1,0));
-    lightCameras[3]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, 100 * power);
+    lightCameras[3]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, getRange());
     lightCameras[3]->setUp(0, 0, -1);
 
     lightCameras[4]->setPosition(getWorldPosition());
     lightCameras[4]->setView(getWorldPosition() + Vector3(0,0,1));
-    lightCameras[4]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, 100 * power);
+    lightCameras[4]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, getRange());
     lightCameras[4]->setUp(0, -1, 0);
 
     lightCameras[5]->setPosition(getWorldPosition());
     lightCameras[5]->setView(getWorldPosition() + Vector3(0,0,-1));
-    lightCameras[5]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, 100 * power);
+    lightCameras[5]->setPerspective(Angle::degToDefault(90), (float)shadowMapWidth / (float)shadowMapHeight, 1, getRange());
     lightCameras[5]->setUp(0, -1, 0);
 
     Light::updateLightCamera();
 }
 
+Rect PointLight::getShadowTile(int pass){
+    //Cube faces are a 3x2 grid inside light tile
+    Rect tile = Light::getShadowTile(0);
+    float faceSize = (float)((int)tile.getWidth() / 3);
+
+    return Rect(tile.getX() + (pass % 3) * faceSize, tile.getY() + (pass / 3) * faceSize, faceSize, faceSize);
+}
+
+Vector4 PointLight::getShadowAtlasRect(int){
+    //Offset of first face and scale of one face
+    Rect face = getShadowTile(0);
+    if (shadowAtlasSize == 0)
+        return Vector4(0, 0, 0, 0);
+
+    return Vector4(face.getX() / shadowAtlasSize, face.getY() / shadowAtlasSize, face.getWidth() / shadowAtlasSize, face.getHeight() / shadowAtlasSize);
+}
+
 bool PointLight::loadShadow(){
     if (useShadow){
         if (lightCameras.size()==0) {
@@ -61,13 +77,6 @@ bool PointLight::loadShadow(){
             lightCameras.push_back(new Camera());
         }
 
-        if (shadowMap.size()==0) {
-            shadowMap.push_back(new Texture(shadowMapWidth, shadowMapHeight));
-
-            shadowMap[0]->setId("shadowCubeMap|" + UniqueToken::get());
-            shadowMap[0]->setType(S_TEXTURE_FRAME_CUBE);
-        }
-
         updateLightCamera();
     }
 
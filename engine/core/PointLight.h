@@ -16,6 +16,9 @@ namespace Supernova {
         PointLight();
         virtual ~PointLight();
 
+        virtual Rect getShadowTile(int pass);
+        virtual Vector4 getShadowAtlasRect(int index);
+
         virtual bool loadShadow();
 
     };
@@ -314,6 +314,11 @@ void Points::updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatrix, Matr
     }
 }
 
+void Points::updateLocalBounds(){
+    //Point sizes are not part of buffer positions
+    localBounds.setInfinite();
+}
+
 void Points::updateModelMatrix(){
     GraphicObject::updateModelMatrix();
 
@@ -15,21 +15,19 @@ namespace Supernova {
     class Points: public GraphicObject {
 
     private:
-        InterleavedBuffer buffer;
-
-        int texWidth;
-        int texHeight;
-
         float pointScale;
 
         int pointSizeReference;
 
         void updatePointScale();
         bool sortPoints();
-        bool shouldSort();
         std::vector<int> findFramesByString(std::string id);
 
     protected:
+        InterleavedBuffer buffer;
+
+        int texWidth;
+        int texHeight;
 
         struct FramesData{
             std::string id;
@@ -61,10 +59,14 @@ namespace Supernova {
 
         std::map<int,FramesData> framesRect;
 
-        void copyBuffer();
+        bool shouldSort();
+
+        virtual void copyBuffer();
         void updatePoints();
         void normalizeTextureRects();
 
+        virtual void updateLocalBounds();
+
     public:
         Points();
         virtual ~Points();
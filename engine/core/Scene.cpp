@@ -7,7 +7,9 @@
 #include "Log.h"
 #include "ui/UIObject.h"
 #include "util/UniqueToken.h"
+#include "util/JobSystem.h"
 #include <stdlib.h>
+#include <algorithm>
 
 using namespace Supernova;
 
@@ -31,18 +33,48 @@ Scene::Scene() {
     physicsWorld = NULL;
     ownedPhysicsWorld = true;
 
+    parallelTransforms = true;
+    batchedTweens = true;
+    batchedSpriteAnimations = true;
+
+    lightStorageVersion = 0;
+    shadowCastersVersion = 0;
+    shadowRoundRobinPasses = 1;
+    shadowRoundRobinCursor = 0;
+    shadowCastersCulling = true;
+    maxLightsPerObject = 0;
+    shadowPasses = 0;
+    shadowDrawCalls = 0;
+    shadowCulledCasters = 0;
+
     drawShadowLightPos = Vector3();
+    drawCameraPosition = Vector3();
     drawShadowCameraNearFar = Vector2();
     drawIsPointShadow = false;
+    drawIsDirectionalShadow = false;
+    drawShadowTile = Rect(0, 0, 0, 0);
 
     userDefinedTransparency = S_OPTION_AUTOMATIC;
+    userDefinedDepthPrePass = S_OPTION_AUTOMATIC;
+    depthPrePass = false;
+    opaqueSorting = true;
+    dynamicResolution = false;
+    resolutionFrame = NULL;
+    redrawRequested = true;
     userDefinedDepth = S_OPTION_AUTOMATIC;
 }
 
 Scene::~Scene() {
+    transformStore.invalidate();
+    tweenSystem.clear();
+    spriteAnimationSystem.clear();
+
     if (render)
         delete render;
 
+    if (resolutionFrame)
+        delete resolutionFrame;
+
     if (ownedPhysicsWorld)
         delete physicsWorld;
     else
@@ -68,6 +100,17 @@ void Scene::removeLight (Light* light){
     lights.erase(i, lights.end());
 }
 
+void Scene::addInterpolatedObject (Object* object){
+    if (std::find(interpolatedObjects.begin(), interpolatedObjects.end(), object) == interpolatedObjects.end()){
+        interpolatedObjects.push_back(object);
+    }
+}
+
+void Scene::removeInterpolatedObject (Object* object){
+    std::vector<Object*>::iterator i = std::remove(interpolatedObjects.begin(), interpolatedObjects.end(), object);
+    interpolatedObjects.erase(i, interpolatedObjects.end());
+}
+
 void Scene::addSubScene (Scene* scene){
     bool found = false;
     
@@ -158,12 +201,107 @@ void Scene::setSky(SkyBox* sky){
     this->sky = sky;
 }
 
+void Scene::setParallelTransforms(bool parallelTransforms){
+    this->parallelTransforms = parallelTransforms;
+
+    if (!parallelTransforms)
+        transformStore.invalidate();
+}
+
+bool Scene::isParallelTransforms(){
+    return parallelTransforms;
+}
+
+void Scene::setBatchedTweens(bool batchedTweens){
+    this->batchedTweens = batchedTweens;
+
+    if (!batchedTweens)
+        tweenSystem.clear();
+}
+
+bool Scene::isBatchedTweens(){
+    return batchedTweens;
+}
+
+size_t Scene::getBatchedTweens(){
+    return tweenSystem.size();
+}
+
+void Scene::setBatchedSpriteAnimations(bool batchedSpriteAnimations){
+    this->batchedSpriteAnimations = batchedSpriteAnimations;
+
+    if (!batchedSpriteAnimations)
+        spriteAnimationSystem.clear();
+}
+
+bool Scene::isBatchedSpriteAnimations(){
+    return batchedSpriteAnimations;
+}
+
+size_t Scene::getBatchedSpriteAnimations(){
+    return spriteAnimationSystem.size();
+}
+
+void Scene::setShadowRoundRobinPasses(unsigned int shadowRoundRobinPasses){
+    this->shadowRoundRobinPasses = shadowRoundRobinPasses;
+}
+
+unsigned int Scene::getShadowRoundRobinPasses(){
+    return shadowRoundRobinPasses;
+}
+
+void Scene::setShadowAtlasSize(int shadowAtlasSize){
+    shadowAtlas.setSize(shadowAtlasSize);
+    shadowCubeAtlas.setSize(shadowAtlasSize);
+}
+
+int Scene::getShadowAtlasSize(){
+    return shadowAtlas.getSize();
+}
+
+void Scene::setShadowCastersCulling(bool shadowCastersCulling){
+    this->shadowCastersCulling = shadowCastersCulling;
+}
+
+bool Scene::isShadowCastersCulling(){
+    return shadowCastersCulling;
+}
+
+void Scene::setMaxLightsPerObject(int maxLightsPerObject){
+    this->maxLightsPerObject = std::max(0, maxLightsPerObject);
+}
+
+int Scene::getMaxLightsPerObject(){
+    return maxLightsPerObject;
+}
+
+unsigned int Scene::getShadowPasses(){
+    return shadowPasses;
+}
+
+unsigned int Scene::getShadowDrawCalls(){
+    return shadowDrawCalls;
+}
+
+unsigned int Scene::getShadowCulledCasters(){
+    return shadowCulledCasters;
+}
+
+unsigned int Scene::getUniformUploads(){
+    if (!render)
+        return 0;
+
+    return render->getUniformUploads();
+}
+
 void Scene::setFog(Fog* fog){
     this->fog = fog;
+    requestRedraw();
 }
 
 void Scene::setAmbientLight(Vector3 ambientLight){
     this->ambientLight = ambientLight;
+    requestRedraw();
 }
 
 void Scene::setAmbientLight(const float ambientFactor){
@@ -217,6 +355,62 @@ void Scene::setDepth(bool depth){
         userDefinedDepth = S_OPTION_NO;
 }
 
+void Scene::setDepthPrePass(bool depthPrePass){
+    if (depthPrePass)
+        userDefinedDepthPrePass = S_OPTION_YES;
+    else
+        userDefinedDepthPrePass = S_OPTION_NO;
+}
+
+bool Scene::isDepthPrePass(){
+    return depthPrePass;
+}
+
+void Scene::setOpaqueSorting(bool opaqueSorting){
+    this->opaqueSorting = opaqueSorting;
+}
+
+bool Scene::isOpaqueSorting(){
+    return opaqueSorting;
+}
+
+void Scene::setDynamicResolution(bool dynamicResolution){
+    this->dynamicResolution = dynamicResolution;
+    resolutionController.reset();
+}
+
+bool Scene::isDynamicResolution(){
+    return dynamicResolution;
+}
+
+ResolutionController* Scene::getResolutionController(){
+    return &resolutionController;
+}
+
+float Scene::getResolutionScale(){
+    if (!dynamicResolution)
+        return 1;
+
+    return resolutionController.getScale();
+}
+
+bool Scene::isRedrawRequested(){
+    if (redrawRequested)
+        return true;
+
+    //Interpolated objects change between fixed updates without new transforms
+    if (Engine::isFixedTimeSceneUpdate() && interpolatedObjects.size() > 0)
+        return true;
+
+    std::vector<Scene*>::iterator it;
+    for (it = subScenes.begin(); it != subScenes.end(); ++it) {
+        if ((*it)->isRedrawRequested())
+            return true;
+    }
+
+    return false;
+}
+
 int Scene::getUserDefinedTransparency(){
     return userDefinedTransparency;
 }
@@ -225,6 +419,10 @@ int Scene::getUserDefinedDepth(){
     return userDefinedDepth;
 }
 
+int Scene::getUserDefinedDepthPrePass(){
+    return userDefinedDepthPrePass;
+}
+
 void Scene::updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatrix, Matrix4* viewProjectionMatrix, Vector3* cameraPosition){
     Object::updateVPMatrix(getCamera()->getViewMatrix(), getCamera()->getProjectionMatrix(), getCamera()->getViewProjectionMatrix(), new Vector3(getCamera()->getWorldPosition()));
 }
@@ -303,6 +501,37 @@ void Scene::resetSceneProperties(){
     useLight = lightData.updateLights(getLights(), getAmbientLight());
 }
 
+void Scene::drawOpaqueMeshes(){
+    std::multimap<float, GraphicObject*>::iterator it;
+
+    if (!depthPrePass){
+        for (it = opaqueQueue.begin(); it != opaqueQueue.end(); ++it) {
+            (*it).second->renderDraw(false);
+        }
+        return;
+    }
+
+    //Objects without depth render write depth before others are tested against it
+    for (it = opaqueQueue.begin(); it != opaqueQueue.end(); ++it) {
+        if (!(*it).second->hasDepthRender())
+            (*it).second->renderDraw(false);
+    }
+
+    render->beginDepthPrePass();
+    for (it = opaqueQueue.begin(); it != opaqueQueue.end(); ++it) {
+        if ((*it).second->hasDepthRender())
+            (*it).second->renderDraw(true);
+    }
+
+    render->beginDepthTestedPass();
+    for (it = opaqueQueue.begin(); it != opaqueQueue.end(); ++it) {
+        if ((*it).second->hasDepthRender())
+            (*it).second->renderDraw(false);
+    }
+
+    render->endDepthPrePass();
+}
+
 void Scene::drawTransparentMeshes(){
     std::multimap<float, GraphicObject*>::reverse_iterator it;
     for (it = transparentQueue.rbegin(); it != transparentQueue.rend(); ++it) {
@@ -347,26 +576,64 @@ void Scene::setTextureFrame(Texture* textureFrame){
     }
 }
 
-bool Scene::renderDraw(bool shadowMap, bool cubeMap, int cubeFace) {
-    if (textureFrame == NULL) {
+bool Scene::loadResolutionFrame(){
+    int width = (int)Engine::getViewRect()->getWidth();
+    int height = (int)Engine::getViewRect()->getHeight();
+
+    if (width <= 0 || height <= 0)
+        return false;
+
+    //Frame has full view size, so scale changes only affect viewport
+    if (!resolutionFrame){
+        resolutionFrame = new Texture(width, height);
+        resolutionFrame->setId("resolutionFrame|" + UniqueToken::get());
+        resolutionFrame->setType(S_TEXTURE_FRAME);
+    }else if (resolutionFrame->getTextureFrameWidth() != width || resolutionFrame->getTextureFrameHeight() != height){
+        resolutionFrame->destroy();
+        resolutionFrame->setTextureFrameSize(width, height);
+        resolutionFrame->setId("resolutionFrame|" + UniqueToken::get());
+    }
+
+    if (!resolutionFrame->getTextureRender())
+        return resolutionFrame->load();
+
+    return true;
+}
+
+bool Scene::renderDraw(bool shadowMap) {
+    bool useResolutionFrame = (!shadowMap && !childScene && textureFrame == NULL && dynamicResolution);
+    Rect resolutionRect;
+
+    if (useResolutionFrame && loadResolutionFrame()) {
+        float scale = resolutionController.getScale();
+        resolutionRect = Rect(0, 0,
+                              std::max(1, (int)(resolutionFrame->getTextureFrameWidth() * scale)),
+                              std::max(1, (int)(resolutionFrame->getTextureFrameHeight() * scale)));
+
+        resolutionFrame->getTextureRender()->initTextureFrame();
+        render->viewSize(resolutionRect);
+        render->clear();
+    } else if (textureFrame == NULL) {
+        useResolutionFrame = false;
         render->viewSize(*Engine::getViewRect());
         if (!childScene)
             render->clear();
     } else {
-        if (cubeMap) {
-            textureFrame->getTextureRender()->initTextureFrame(cubeFace);
-        } else {
-            textureFrame->getTextureRender()->initTextureFrame();
-        }
+        textureFrame->getTextureRender()->initTextureFrame();
 
-        render->viewSize(Rect(0, 0, textureFrame->getTextureFrameWidth(), textureFrame->getTextureFrameHeight()));
-        if (shadowMap)
+        if (shadowMap) {
+            //Only the light tile of shadow atlas is drawn and cleared
+            render->viewSize(drawShadowTile);
+            render->enableScissor(drawShadowTile);
             render->clear(1.0);
-        else
+        } else {
+            render->viewSize(Rect(0, 0, textureFrame->getTextureFrameWidth(), textureFrame->getTextureFrameHeight()));
             render->clear();
+        }
     }
 
     transparentQueue.clear();
+    opaqueQueue.clear();
 
     if (!drawingShadow) {
         render->setUseTransparency(isUseTransparency());
@@ -374,7 +641,19 @@ bool Scene::renderDraw(bool shadowMap, bool cubeMap, int cubeFace) {
         render->setChildScene(isChildScene());
         render->setUseDepth(isUseDepth());
 
+        if (camera)
+            drawCameraPosition = camera->getWorldPosition();
+
         resetSceneProperties();
+
+        //Renders registered pointers to old light storage
+        if (lightStorageVersion != lightData.getStorageVersion()){
+            lightStorageVersion = lightData.getStorageVersion();
+            for (int i = 0; i < (int)objects.size(); i++){
+                if (objects[i]->isLoaded())
+                    objects[i]->reload();
+            }
+        }
     } else {
         render->setUseTransparency(false);
         render->setUseLight(false);
@@ -382,6 +661,7 @@ bool Scene::renderDraw(bool shadowMap, bool cubeMap, int cubeFace) {
         render->setUseDepth(true);
     }
     render->setDrawingShadow(drawingShadow);
+    render->updateFrameStamp();
 
     bool drawreturn = render->draw();
 
@@ -392,12 +672,25 @@ bool Scene::renderDraw(bool shadowMap, bool cubeMap, int cubeFace) {
     Object::draw();
 
     if (!drawingShadow) {
+        drawOpaqueMeshes();
         drawSky();
         drawTransparentMeshes();
+
+        if (useResolutionFrame) {
+            resolutionFrame->getTextureRender()->endTextureFrame();
+            render->viewSize(*Engine::getViewRect());
+            render->clear();
+            render->drawTexture(resolutionFrame, Rect(0, 0,
+                    resolutionRect.getWidth() / resolutionFrame->getTextureFrameWidth(),
+                    resolutionRect.getHeight() / resolutionFrame->getTextureFrameHeight()));
+        }
+
         drawChildScenes();
     }
 
     if (textureFrame != NULL) {
+        if (shadowMap)
+            render->disableScissor();
         textureFrame->getTextureRender()->endTextureFrame();
     }
 
@@ -412,124 +705,325 @@ void Scene::updatePhysics(float time){
 }
 
 bool Scene::draw() {
-    //TODO: alert if not loaded
+    //Scene without render has nothing to draw, load requests a new redraw
+    if (!loaded || !render) {
+        redrawRequested = false;
+        return false;
+    }
 
     Camera* originalCamera = this->camera;
     Texture* originalTextureRender = this->textureFrame;
 
+    if (dynamicResolution && !childScene)
+        resolutionController.update(Engine::getFrameWorkTime());
+
+    if (Engine::isFixedTimeSceneUpdate()){
+        for (int i=0; i<interpolatedObjects.size(); i++) {
+            interpolatedObjects[i]->interpolateTransform(Engine::getUpdateAlpha());
+        }
+    }
+
+    shadowPasses = 0;
+    shadowDrawCalls = 0;
+    shadowCulledCasters = 0;
+    render->resetUniformUploads();
+
+    if (loadedShadow)
+        packShadowAtlas();
+
+    //Round-robin lights share a fixed number of passes per frame
+    int roundRobinTotal = 0;
+    for (int i=0; i<lights.size(); i++) {
+        if (lights[i]->isUseShadow() && lights[i]->getShadowUpdatePolicy() == S_SHADOW_UPDATE_ROUNDROBIN)
+            roundRobinTotal += lights[i]->getNumShadowPasses();
+    }
+    int roundRobinIndex = 0;
+    if (shadowRoundRobinCursor >= roundRobinTotal)
+        shadowRoundRobinCursor = 0;
+
     for (int i=0; i<lights.size(); i++) {
         if (lights[i]->isUseShadow()) {
-            drawingShadow = true;
+            bool roundRobin = (lights[i]->getShadowUpdatePolicy() == S_SHADOW_UPDATE_ROUNDROBIN);
+            bool updatedAll = true;
+
+            for (int pass = 0; pass < lights[i]->getNumShadowPasses(); pass++) {
+                bool roundRobinTurn = false;
+                if (roundRobin) {
+                    roundRobinTurn = (((roundRobinIndex - shadowRoundRobinCursor + roundRobinTotal) % roundRobinTotal) < shadowRoundRobinPasses);
+                    roundRobinIndex++;
+                }
+
+                if (lights[i]->isShadowPassUpdate(pass, roundRobinTurn, shadowCastersVersion)) {
+                    drawShadowPass(lights[i], pass);
+                } else {
+                    updatedAll = false;
+                }
+            }
 
-            this->drawShadowLightPos = lights[i]->getPosition();
+            lights[i]->endShadowUpdate(updatedAll, shadowCastersVersion);
+        }
+    }
 
-            if (lights[i]->getType() == S_POINT_LIGHT) {
+    if (roundRobinTotal > 0)
+        shadowRoundRobinCursor = (shadowRoundRobinCursor + shadowRoundRobinPasses) % roundRobinTotal;
 
-                this->drawIsPointShadow = true;
+    if (drawingShadow) {
+        drawingShadow = false;
+        this->setCamera(originalCamera);
+        this->setTextureFrame(originalTextureRender);
+    }
 
-                this->setTextureFrame(lights[i]->getShadowMap());
-                for (int cam = 0; cam < 6; cam++){
-                    this->setCamera(lights[i]->getLightCamera(cam));
-                    this->drawShadowCameraNearFar = lights[i]->getLightCamera(cam)->getNearFarPlane();
+    bool drawReturn = renderDraw();
 
-                    renderDraw(true, true, TEXTURE_CUBE_FACE_POSITIVE_X + cam);
-                }
+    //Logic and physics always use last fixed update transforms
+    for (int i=0; i<interpolatedObjects.size(); i++) {
+        interpolatedObjects[i]->restoreTransform();
+    }
+
+    //Changes made while drawing are already in this frame
+    redrawRequested = false;
 
-            }else if (lights[i]->getType() == S_SPOT_LIGHT) {
+    return drawReturn;
+}
+
+float Scene::getShadowCoverage(Light* light){
+    //Directional lights affect all screen
+    if (light->getType() == S_DIRECTIONAL_LIGHT || !camera)
+        return 1;
 
-                this->drawIsPointShadow = false;
+    float range = light->getRange();
+    Vector3 lightPosition = light->getWorldPosition();
 
-                this->setTextureFrame(lights[i]->getShadowMap());
-                this->setCamera(lights[i]->getLightCamera());
-                this->drawShadowCameraNearFar = lights[i]->getLightCamera()->getNearFarPlane();
+    if (!camera->isInside(lightPosition, range))
+        return 0;
 
-                renderDraw(true);
+    float distance = (lightPosition - camera->getWorldPosition()).length();
+    if (distance <= range)
+        return 1;
 
-            }else if (lights[i]->getType() == S_DIRECTIONAL_LIGHT) {
+    return range / distance;
+}
 
-                this->drawIsPointShadow = false;
+void Scene::packShadowAtlas(){
+    shadowAtlas.clearRequests();
+    shadowCubeAtlas.clearRequests();
 
-                for (int ca = 0; ca < ((DirectionalLight*)lights[i])->getNumShadowCascades(); ca++) {
-                    this->setTextureFrame(lights[i]->getShadowMap(ca));
-                    this->setCamera(lights[i]->getLightCamera(ca));
-                    this->drawShadowCameraNearFar = lights[i]->getLightCamera(ca)->getNearFarPlane();
+    //First request of each light, cascades are in sequence
+    std::vector<int> requests;
 
-                    renderDraw(true);
-                }
+    for (int i=0; i<lights.size(); i++) {
+        int request = -1;
+
+        if (lights[i]->isUseShadow()) {
+            float coverage = getShadowCoverage(lights[i]);
+            int tileSize = (int)(lights[i]->getShadowMapSize() * coverage);
 
+            if (lights[i]->getType() == S_POINT_LIGHT) {
+                request = shadowCubeAtlas.addRequest(tileSize * S_SHADOW_CUBE_TILE_SCALE, coverage);
+            } else {
+                for (int pass = 0; pass < lights[i]->getNumShadowPasses(); pass++) {
+                    //Far cascades are less important
+                    int index = shadowAtlas.addRequest(tileSize, coverage / (pass + 1));
+                    if (pass == 0)
+                        request = index;
+                }
             }
+        }
+
+        requests.push_back(request);
+    }
+
+    shadowAtlas.pack();
+    shadowCubeAtlas.pack();
 
+    for (int i=0; i<lights.size(); i++) {
+        if (requests[i] >= 0) {
+            if (lights[i]->getType() == S_POINT_LIGHT) {
+                lights[i]->setShadowTile(0, shadowCubeAtlas.getTile(requests[i]), shadowCubeAtlas.getSize());
+            } else {
+                for (int pass = 0; pass < lights[i]->getNumShadowPasses(); pass++) {
+                    lights[i]->setShadowTile(pass, shadowAtlas.getTile(requests[i] + pass), shadowAtlas.getSize());
+                }
+            }
         }
     }
+}
 
-    if (drawingShadow) {
-        drawingShadow = false;
-        this->setCamera(originalCamera);
-        this->setTextureFrame(originalTextureRender);
+void Scene::drawShadowPass(Light* light, int pass){
+    Rect tile = light->getShadowTile(pass);
+
+    //Light has no space in shadow atlas
+    if (tile.getWidth() == 0 || tile.getHeight() == 0)
+        return;
+
+    drawingShadow = true;
+
+    this->drawShadowLightPos = light->getPosition();
+
+    this->setCamera(light->getLightCamera(pass));
+    this->drawShadowCameraNearFar = light->getLightCamera(pass)->getNearFarPlane();
+    this->drawIsDirectionalShadow = (light->getType() == S_DIRECTIONAL_LIGHT);
+    this->drawShadowTile = tile;
+
+    if (light->getType() == S_POINT_LIGHT) {
+        this->drawIsPointShadow = true;
+        this->setTextureFrame(shadowCubeAtlas.getTexture());
+    } else {
+        this->drawIsPointShadow = false;
+        this->setTextureFrame(shadowAtlas.getTexture());
     }
 
-    return renderDraw();
+    renderDraw(true);
+
+    light->setShadowPassRendered(pass);
+    shadowPasses++;
+}
+
+void Scene::updateTransformStore(){
+    if (!transformStore.isValid())
+        transformStore.build(this);
+
+    //Actions run first because they change transforms
+    transformStore.updateActions();
+
+    if (!transformStore.isValid())
+        return;
+
+    size_t dirtyObjects = transformStore.propagateDirty();
+
+    //Serial update in Object::update is faster for few objects
+    if (dirtyObjects < S_PARALLEL_TRANSFORMS_MIN_OBJECTS || JobSystem::getNumThreads() == 0)
+        return;
+
+    transformStore.updateWorldTransforms(S_PARALLEL_TRANSFORMS_GRAIN);
 }
 
 void Scene::update(){
 
     updatePhysics(Engine::getSceneUpdateTime());
 
+    if (tweenSystem.update(Engine::getSceneUpdateTime()) > 0)
+        redrawRequested = true;
+
+    if (spriteAnimationSystem.update(Engine::getSceneUpdateTime()) > 0)
+        redrawRequested = true;
+
     if (camera && !camera->getParent()){
         camera->update();
     }
 
+    if (parallelTransforms){
+        updateTransformStore();
+    }
+
+    //Model matrices already computed in parallel are only finished here
     Object::update();
 }
 
-bool Scene::addLightProperties(ObjectRender* render){
+void Scene::updateShadowCaster(GraphicObject* object, const AlignedBox& previousBounds){
+    AlignedBox bounds;
+    bool computedBounds = false;
+
+    for (int i = 0; i < (int)lights.size(); i++){
+        Light* light = lights[i];
+        //Other policies do not use changes of casters
+        if (!light->isUseShadow() || light->shadowDirty || light->getShadowUpdatePolicy() != S_SHADOW_UPDATE_ONCHANGE)
+            continue;
+
+        if (!computedBounds){
+            bounds = object->getWorldBounds();
+            computedBounds = true;
+        }
+
+        bool knownBounds = !previousBounds.isNull() && !previousBounds.isInfinite() && !bounds.isNull() && !bounds.isInfinite();
+        if (!knownBounds || !shadowCastersCulling){
+            light->shadowDirty = true;
+            continue;
+        }
+
+        //Without near plane, directional casters between light and cascade are included
+        for (int c = 0; c < (int)light->lightCameras.size(); c++){
+            if (light->lightCameras[c]->isInside(previousBounds, false) || light->lightCameras[c]->isInside(bounds, false)){
+                light->shadowDirty = true;
+                break;
+            }
+        }
+    }
+}
+
+bool Scene::addLightProperties(ObjectRender* render, LightList* lightList){
     if (useLight){
 
         //Lights
-        render->addProperty(S_PROPERTY_AMBIENTLIGHT, S_PROPERTYDATA_FLOAT3, 1, &ambientLight);
-
-        render->addProperty(S_PROPERTY_POINTLIGHT_POS, S_PROPERTYDATA_FLOAT3, lightData.numPointLight, &lightData.pointLightPos.front());
-        render->addProperty(S_PROPERTY_POINTLIGHT_POWER, S_PROPERTYDATA_FLOAT1, lightData.numPointLight, &lightData.pointLightPower.front());
-        render->addProperty(S_PROPERTY_POINTLIGHT_COLOR, S_PROPERTYDATA_FLOAT3, lightData.numPointLight, &lightData.pointLightColor.front());
-        render->addProperty(S_PROPERTY_POINTLIGHT_SHADOWIDX, S_PROPERTYDATA_INT1, lightData.numPointLight, &lightData.pointLightShadowIdx.front());
-
-        render->addProperty(S_PROPERTY_SPOTLIGHT_POS, S_PROPERTYDATA_FLOAT3, lightData.numSpotLight, &lightData.spotLightPos.front());
-        render->addProperty(S_PROPERTY_SPOTLIGHT_POWER, S_PROPERTYDATA_FLOAT1, lightData.numSpotLight, &lightData.spotLightPower.front());
-        render->addProperty(S_PROPERTY_SPOTLIGHT_COLOR, S_PROPERTYDATA_FLOAT3, lightData.numSpotLight, &lightData.spotLightColor.front());
-        render->addProperty(S_PROPERTY_SPOTLIGHT_TARGET, S_PROPERTYDATA_FLOAT3, lightData.numSpotLight, &lightData.spotLightTarget.front());
-        render->addProperty(S_PROPERTY_SPOTLIGHT_CUTOFF, S_PROPERTYDATA_FLOAT1, lightData.numSpotLight, &lightData.spotLightCutOff.front());
-        render->addProperty(S_PROPERTY_SPOTLIGHT_OUTERCUTOFF, S_PROPERTYDATA_FLOAT1, lightData.numSpotLight, &lightData.spotLightOuterCutOff.front());
-        render->addProperty(S_PROPERTY_SPOTLIGHT_SHADOWIDX, S_PROPERTYDATA_INT1, lightData.numSpotLight, &lightData.spotLightShadowIdx.front());
-
-        render->addProperty(S_PROPERTY_DIRLIGHT_DIR, S_PROPERTYDATA_FLOAT3, lightData.numDirectionalLight, &lightData.directionalLightDir.front());
-        render->addProperty(S_PROPERTY_DIRLIGHT_POWER, S_PROPERTYDATA_FLOAT1, lightData.numDirectionalLight, &lightData.directionalLightPower.front());
-        render->addProperty(S_PROPERTY_DIRLIGHT_COLOR, S_PROPERTYDATA_FLOAT3, lightData.numDirectionalLight, &lightData.directionalLightColor.front());
-        render->addProperty(S_PROPERTY_DIRLIGHT_SHADOWIDX, S_PROPERTYDATA_INT1, lightData.numDirectionalLight, &lightData.directionalLightShadowIdx.front());
+        render->addGlobalProperty(S_PROPERTY_AMBIENTLIGHT, S_PROPERTYDATA_FLOAT3, 1, &ambientLight);
+
+        if (lightList){
+            lightList->resize(std::min(maxLightsPerObject, lightData.numPointLight), std::min(maxLightsPerObject, lightData.numSpotLight));
+
+            render->addProperty(S_PROPERTY_POINTLIGHT_POS, S_PROPERTYDATA_FLOAT3, lightList->numPointLight, &lightList->pointLightPos.front());
+            render->addProperty(S_PROPERTY_POINTLIGHT_POWER, S_PROPERTYDATA_FLOAT1, lightList->numPointLight, &lightList->pointLightPower.front());
+            render->addProperty(S_PROPERTY_POINTLIGHT_COLOR, S_PROPERTYDATA_FLOAT3, lightList->numPointLight, &lightList->pointLightColor.front());
+            render->addProperty(S_PROPERTY_POINTLIGHT_SHADOWIDX, S_PROPERTYDATA_INT1, lightList->numPointLight, &lightList->pointLightShadowIdx.front());
+
+            render->addProperty(S_PROPERTY_SPOTLIGHT_POS, S_PROPERTYDATA_FLOAT3, lightList->numSpotLight, &lightList->spotLightPos.front());
+            render->addProperty(S_PROPERTY_SPOTLIGHT_POWER, S_PROPERTYDATA_FLOAT1, lightList->numSpotLight, &lightList->spotLightPower.front());
+            render->addProperty(S_PROPERTY_SPOTLIGHT_COLOR, S_PROPERTYDATA_FLOAT3, lightList->numSpotLight, &lightList->spotLightColor.front());
+            render->addProperty(S_PROPERTY_SPOTLIGHT_TARGET, S_PROPERTYDATA_FLOAT3, lightList->numSpotLight, &lightList->spotLightTarget.front());
+            render->addProperty(S_PROPERTY_SPOTLIGHT_CUTOFF, S_PROPERTYDATA_FLOAT1, lightList->numSpotLight, &lightList->spotLightCutOff.front());
+            render->addProperty(S_PROPERTY_SPOTLIGHT_OUTERCUTOFF, S_PROPERTYDATA_FLOAT1, lightList->numSpotLight, &lightList->spotLightOuterCutOff.front());
+            render->addProperty(S_PROPERTY_SPOTLIGHT_SHADOWIDX, S_PROPERTYDATA_INT1, lightList->numSpotLight, &lightList->spotLightShadowIdx.front());
+        }else{
+            render->addGlobalProperty(S_PROPERTY_POINTLIGHT_POS, S_PROPERTYDATA_FLOAT3, lightData.numPointLight, &lightData.pointLightPos.front());
+            render->addGlobalProperty(S_PROPERTY_POINTLIGHT_POWER, S_PROPERTYDATA_FLOAT1, lightData.numPointLight, &lightData.pointLightPower.front());
+            render->addGlobalProperty(S_PROPERTY_POINTLIGHT_COLOR, S_PROPERTYDATA_FLOAT3, lightData.numPointLight, &lightData.pointLightColor.front());
+            render->addGlobalProperty(S_PROPERTY_POINTLIGHT_SHADOWIDX, S_PROPERTYDATA_INT1, lightData.numPointLight, &lightData.pointLightShadowIdx.front());
+
+            render->addGlobalProperty(S_PROPERTY_SPOTLIGHT_POS, S_PROPERTYDATA_FLOAT3, lightData.numSpotLight, &lightData.spotLightPos.front());
+            render->addGlobalProperty(S_PROPERTY_SPOTLIGHT_POWER, S_PROPERTYDATA_FLOAT1, lightData.numSpotLight, &lightData.spotLightPower.front());
+            render->addGlobalProperty(S_PROPERTY_SPOTLIGHT_COLOR, S_PROPERTYDATA_FLOAT3, lightData.numSpotLight, &lightData.spotLightColor.front());
+            render->addGlobalProperty(S_PROPERTY_SPOTLIGHT_TARGET, S_PROPERTYDATA_FLOAT3, lightData.numSpotLight, &lightData.spotLightTarget.front());
+            render->addGlobalProperty(S_PROPERTY_SPOTLIGHT_CUTOFF, S_PROPERTYDATA_FLOAT1, lightData.numSpotLight, &lightData.spotLightCutOff.front());
+            render->addGlobalProperty(S_PROPERTY_SPOTLIGHT_OUTERCUTOFF, S_PROPERTYDATA_FLOAT1, lightData.numSpotLight, &lightData.spotLightOuterCutOff.front());
+            render->addGlobalProperty(S_PROPERTY_SPOTLIGHT_SHADOWIDX, S_PROPERTYDATA_INT1, lightData.numSpotLight, &lightData.spotLightShadowIdx.front());
+        }
 
-        //Shadows
-        render->addTextureVector(S_TEXTURESAMPLER_SHADOWMAP2D, lightData.shadowsMap2D);
-        render->addProperty(S_PROPERTY_DEPTHVPMATRIX, S_PROPERTYDATA_MATRIX4, lightData.numShadows2D, &lightData.shadowsVPMatrix.front());
-        render->addProperty(S_PROPERTY_SHADOWBIAS2D, S_PROPERTYDATA_FLOAT1, lightData.numShadows2D, &lightData.shadowsBias2D.front());
-        render->addProperty(S_PROPERTY_SHADOWCAMERA_NEARFAR2D, S_PROPERTYDATA_FLOAT2, lightData.numShadows2D, &lightData.shadowsCameraNearFar2D.front());
-        render->addProperty(S_PROPERTY_NUMCASCADES2D, S_PROPERTYDATA_INT1, lightData.numShadows2D, &lightData.shadowNumCascades2D.front());
+        render->addGlobalProperty(S_PROPERTY_DIRLIGHT_DIR, S_PROPERTYDATA_FLOAT3, lightData.numDirectionalLight, &lightData.directionalLightDir.front());
+        render->addGlobalProperty(S_PROPERTY_DIRLIGHT_POWER, S_PROPERTYDATA_FLOAT1, lightData.numDirectionalLight, &lightData.directionalLightPower.front());
+        render->addGlobalProperty(S_PROPERTY_DIRLIGHT_COLOR, S_PROPERTYDATA_FLOAT3, lightData.numDirectionalLight, &lightData.directionalLightColor.front());
+        render->addGlobalProperty(S_PROPERTY_DIRLIGHT_SHADOWIDX, S_PROPERTYDATA_INT1, lightData.numDirectionalLight, &lightData.directionalLightShadowIdx.front());
 
-        render->addTextureVector(S_TEXTURESAMPLER_SHADOWMAPCUBE, lightData.shadowsMapCube);
-        render->addProperty(S_PROPERTY_SHADOWBIASCUBE, S_PROPERTYDATA_FLOAT1, lightData.numShadowsCube, &lightData.shadowsBiasCube.front());
-        render->addProperty(S_PROPERTY_SHADOWCAMERA_NEARFARCUBE, S_PROPERTYDATA_FLOAT2, lightData.numShadowsCube, &lightData.shadowsCameraNearFarCube.front());
+        //Shadows
+        render->addTexture(S_TEXTURESAMPLER_SHADOWMAP2D, shadowAtlas.getTexture());
+        render->addGlobalProperty(S_PROPERTY_SHADOWRECT2D, S_PROPERTYDATA_FLOAT4, lightData.numShadows2D, &lightData.shadowsRect2D.front());
+        render->addGlobalProperty(S_PROPERTY_DEPTHVPMATRIX, S_PROPERTYDATA_MATRIX4, lightData.numShadows2D, &lightData.shadowsVPMatrix.front());
+        render->addGlobalProperty(S_PROPERTY_SHADOWBIAS2D, S_PROPERTYDATA_FLOAT1, lightData.numShadows2D, &lightData.shadowsBias2D.front());
+        render->addGlobalProperty(S_PROPERTY_SHADOWCAMERA_NEARFAR2D, S_PROPERTYDATA_FLOAT2, lightData.numShadows2D, &lightData.shadowsCameraNearFar2D.front());
+        render->addGlobalProperty(S_PROPERTY_NUMCASCADES2D, S_PROPERTYDATA_INT1, lightData.numShadows2D, &lightData.shadowNumCascades2D.front());
+
+        render->addTexture(S_TEXTURESAMPLER_SHADOWMAPCUBE, shadowCubeAtlas.getTexture());
+        render->addGlobalProperty(S_PROPERTY_SHADOWRECTCUBE, S_PROPERTYDATA_FLOAT4, lightData.numShadowsCube, &lightData.shadowsRectCube.front());
+        render->addGlobalProperty(S_PROPERTY_SHADOWBIASCUBE, S_PROPERTYDATA_FLOAT1, lightData.numShadowsCube, &lightData.shadowsBiasCube.front());
+        render->addGlobalProperty(S_PROPERTY_SHADOWCAMERA_NEARFARCUBE, S_PROPERTYDATA_FLOAT2, lightData.numShadowsCube, &lightData.shadowsCameraNearFarCube.front());
 
         return true;
     }
     return false;
 }
 
+bool Scene::addCameraProperties(ObjectRender* render){
+    render->addGlobalProperty(S_PROPERTY_CAMERAPOS, S_PROPERTYDATA_FLOAT3, 1, &drawCameraPosition);
+
+    return true;
+}
+
 bool Scene::addFogProperties(ObjectRender* render){
     if (fog){
-        render->addProperty(S_PROPERTY_FOG_MODE, S_PROPERTYDATA_INT1, 1, &(fog->mode));
-        render->addProperty(S_PROPERTY_FOG_COLOR, S_PROPERTYDATA_FLOAT3, 1, &(fog->color));
-        render->addProperty(S_PROPERTY_FOG_VISIBILITY, S_PROPERTYDATA_FLOAT1, 1, &(fog->visibility));
-        render->addProperty(S_PROPERTY_FOG_DENSITY, S_PROPERTYDATA_FLOAT1, 1, &(fog->density));
-        render->addProperty(S_PROPERTY_FOG_START, S_PROPERTYDATA_FLOAT1, 1, &(fog->linearStart));
-        render->addProperty(S_PROPERTY_FOG_END, S_PROPERTYDATA_FLOAT1, 1, &(fog->linearEnd));
+        render->addGlobalProperty(S_PROPERTY_FOG_MODE, S_PROPERTYDATA_INT1, 1, &(fog->mode));
+        render->addGlobalProperty(S_PROPERTY_FOG_COLOR, S_PROPERTYDATA_FLOAT3, 1, &(fog->color));
+        render->addGlobalProperty(S_PROPERTY_FOG_VISIBILITY, S_PROPERTYDATA_FLOAT1, 1, &(fog->visibility));
+        render->addGlobalProperty(S_PROPERTY_FOG_DENSITY, S_PROPERTYDATA_FLOAT1, 1, &(fog->density));
+        render->addGlobalProperty(S_PROPERTY_FOG_START, S_PROPERTYDATA_FLOAT1, 1, &(fog->linearStart));
+        render->addGlobalProperty(S_PROPERTY_FOG_END, S_PROPERTYDATA_FLOAT1, 1, &(fog->linearEnd));
 
         return true;
     }
@@ -547,17 +1041,38 @@ bool Scene::load(){
     render->setUseDepth(isUseDepth());
 
     loadedShadow = false;
+    bool useShadowAtlas = false;
+    bool useShadowCubeAtlas = false;
     for (int i=0; i<lights.size(); i++) {
         if (lights[i]->isUseShadow()) {
             lights[i]->loadShadow();
             loadedShadow = true;
+
+            if (lights[i]->getType() == S_POINT_LIGHT)
+                useShadowCubeAtlas = true;
+            else
+                useShadowAtlas = true;
         }
     }
 
+    depthPrePass = false;
+    if (isUseDepth()){
+        if (userDefinedDepthPrePass == S_OPTION_YES)
+            depthPrePass = true;
+        else if (userDefinedDepthPrePass == S_OPTION_AUTOMATIC)
+            depthPrePass = (lights.size() >= S_DEPTHPREPASS_MIN_LIGHTS);
+    }
+
+    if (useShadowAtlas && !shadowAtlas.load(S_TEXTURE_DEPTH_FRAME))
+        Log::Error("Cannot load shadow atlas");
+    if (useShadowCubeAtlas && !shadowCubeAtlas.load(S_TEXTURE_FRAME))
+        Log::Error("Cannot load shadow cube atlas");
+
     doCamera();
 
     render->load();
     resetSceneProperties();
+    lightStorageVersion = lightData.getStorageVersion();
 
     bool loadreturn = Object::load();
 
@@ -574,6 +1089,15 @@ bool Scene::load(){
 void Scene::destroy(){
     Object::destroy();
 
+    shadowAtlas.destroy();
+    shadowCubeAtlas.destroy();
+
+    if (resolutionFrame){
+        resolutionFrame->destroy();
+        delete resolutionFrame;
+        resolutionFrame = NULL;
+    }
+
     if (!userCamera){
         delete camera;
     }
@@ -5,6 +5,16 @@
 #define S_OPTION_YES 1
 #define S_OPTION_AUTOMATIC 2
 
+//Automatic depth pre-pass is used from this number of lights
+#define S_DEPTHPREPASS_MIN_LIGHTS 4
+
+//Below this number of dirty objects transforms are updated in serial
+#define S_PARALLEL_TRANSFORMS_MIN_OBJECTS 1024
+#define S_PARALLEL_TRANSFORMS_GRAIN 256
+
+//Point light tile is bigger than its faces, they are a 3x2 grid inside it
+#define S_SHADOW_CUBE_TILE_SCALE 2
+
 #include "Object.h"
 #include "Camera.h"
 #include "render/SceneRender.h"
@@ -15,17 +25,27 @@
 #include <map>
 #include "ui/UIObject.h"
 #include "util/LightData.h"
+#include "util/LightList.h"
+#include "util/TransformStore.h"
+#include "action/TweenSystem.h"
+#include "action/SpriteAnimationSystem.h"
+#include "util/ShadowAtlas.h"
+#include "util/ResolutionController.h"
 #include "math/Matrix4.h"
 #include "physics/PhysicsWorld.h"
 
 namespace Supernova {
 
+    class GraphicObject;
+
     class Scene: public Object {
         friend class Engine;
         friend class Object;
         friend class GraphicObject;
         friend class Mesh;
         friend class Points;
+        friend class TimeAction;
+        friend class SpriteAnimation;
     private:
 
         SceneRender* render;
@@ -34,6 +54,9 @@ namespace Supernova {
         Vector3 drawShadowLightPos;
         Vector2 drawShadowCameraNearFar;
         bool drawIsPointShadow;
+        bool drawIsDirectionalShadow;
+        Rect drawShadowTile;
+        Vector3 drawCameraPosition;
         
         LightData lightData;
 
@@ -43,10 +66,12 @@ namespace Supernova {
         bool userCamera;
         
         std::multimap<float, GraphicObject*> transparentQueue;
+        std::multimap<float, GraphicObject*> opaqueQueue;
 
         std::vector<Light*> lights;
         std::vector<Scene*> subScenes;
         std::vector<UIObject*> guiObjects;
+        std::vector<Object*> interpolatedObjects;
 
         PhysicsWorld* physicsWorld;
         SkyBox* sky;
@@ -63,13 +88,57 @@ namespace Supernova {
 
         bool ownedPhysicsWorld;
 
+        bool depthPrePass;
+        bool opaqueSorting;
+
+        bool parallelTransforms;
+        TransformStore transformStore;
+
+        bool batchedTweens;
+        TweenSystem tweenSystem;
+
+        bool batchedSpriteAnimations;
+        SpriteAnimationSystem spriteAnimationSystem;
+
+        //Light data storage registered in loaded renders
+        unsigned long lightStorageVersion;
+
+        //Changed when shadow casters are removed or change visibility, moves are tested per light
+        unsigned long shadowCastersVersion;
+        unsigned int shadowRoundRobinPasses;
+        unsigned int shadowRoundRobinCursor;
+
+        bool shadowCastersCulling;
+
+        int maxLightsPerObject;
+
+        //Spot and directional lights use depth atlas, point lights use color atlas with packed distances
+        ShadowAtlas shadowAtlas;
+        ShadowAtlas shadowCubeAtlas;
+
+        unsigned int shadowPasses;
+        unsigned int shadowDrawCalls;
+        unsigned int shadowCulledCasters;
+
+        //Scene is drawn in a scaled part of this frame, then upscaled before child scenes
+        bool dynamicResolution;
+        ResolutionController resolutionController;
+        Texture* resolutionFrame;
+
+        //Something visible changed since last draw
+        bool redrawRequested;
+
         // S_OPTION
         int userDefinedTransparency;
         int userDefinedDepth;
+        int userDefinedDepthPrePass;
         
         void addLight (Light* light);
         void removeLight (Light* light);
         
+        void addInterpolatedObject (Object* object);
+        void removeInterpolatedObject (Object* object);
+
         void addSubScene (Scene* scene);
         void removeSubScene (Scene* scene);
         
@@ -78,15 +147,26 @@ namespace Supernova {
 
         void setSky(SkyBox* sky);
 
-        bool addLightProperties(ObjectRender* render);
+        //Point and spot lights come from object light list when not NULL
+        bool addLightProperties(ObjectRender* render, LightList* lightList = NULL);
+        bool addCameraProperties(ObjectRender* render);
         bool addFogProperties(ObjectRender* render);
 
         void resetSceneProperties();
+        void drawOpaqueMeshes();
         void drawTransparentMeshes();
         void drawSky();
 
         void drawChildScenes();
-        bool renderDraw(bool shadowMap=false, bool cubeMap=false, int cubeFace=0);
+
+        void updateTransformStore();
+        //Marks shadows of lights that could see caster before or after it moved
+        void updateShadowCaster(GraphicObject* object, const AlignedBox& previousBounds);
+        float getShadowCoverage(Light* light);
+        void packShadowAtlas();
+        void drawShadowPass(Light* light, int pass);
+        bool loadResolutionFrame();
+        bool renderDraw(bool shadowMap=false);
 
     public:
 
@@ -121,8 +201,62 @@ namespace Supernova {
         void setTransparency(bool transparency);
         void setDepth(bool depth);
 
+        //Opaque objects write only depth first, then color is drawn without overdraw, applied on load
+        void setDepthPrePass(bool depthPrePass);
+        bool isDepthPrePass();
+
+        //Opaque objects are drawn front to back when scene uses depth, except objects with scissor or inside a scissor
+        void setOpaqueSorting(bool opaqueSorting);
+        bool isOpaqueSorting();
+
+        void setParallelTransforms(bool parallelTransforms);
+        bool isParallelTransforms();
+
+        //Move, rotate, scale, color and alpha actions with built-in ease are updated together
+        void setBatchedTweens(bool batchedTweens);
+        bool isBatchedTweens();
+        size_t getBatchedTweens();
+
+        //Running sprite animations are updated together
+        void setBatchedSpriteAnimations(bool batchedSpriteAnimations);
+        bool isBatchedSpriteAnimations();
+        size_t getBatchedSpriteAnimations();
+
+        //Shadow passes per frame shared by lights with S_SHADOW_UPDATE_ROUNDROBIN
+        void setShadowRoundRobinPasses(unsigned int shadowRoundRobinPasses);
+        unsigned int getShadowRoundRobinPasses();
+
+        //Size of shadow atlas textures, applied on load
+        void setShadowAtlasSize(int shadowAtlasSize);
+        int getShadowAtlasSize();
+
+        //Skip casters outside of each shadow camera frustum
+        void setShadowCastersCulling(bool shadowCastersCulling);
+        bool isShadowCastersCulling();
+
+        //Point and spot lights of each type kept per object, 0 sends all scene lights, applied on load
+        void setMaxLightsPerObject(int maxLightsPerObject);
+        int getMaxLightsPerObject();
+
+        //Resolution of 3D scene follows measured frame work time, UI in child scenes keeps native resolution
+        void setDynamicResolution(bool dynamicResolution);
+        bool isDynamicResolution();
+        ResolutionController* getResolutionController();
+        float getResolutionScale();
+
+        //Also true when a child scene needs redraw
+        bool isRedrawRequested();
+
+        //Statistics of last draw
+        unsigned int getShadowPasses();
+        unsigned int getShadowDrawCalls();
+        unsigned int getShadowCulledCasters();
+        //Properties sent to programs, global ones only once per program in each scene pass
+        unsigned int getUniformUploads();
+
         int getUserDefinedTransparency();
         int getUserDefinedDepth();
+        int getUserDefinedDepthPrePass();
         
         void setFog(Fog* fog);
 
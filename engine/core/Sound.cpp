@@ -7,22 +7,52 @@ using namespace Supernova;
 
 Sound::Sound(std::string filename){
     this->filename = filename;
+    this->loadState = S_LOADSTATE_NONE;
     player = new SoLoudPlayer();
     player->setFile(filename);
 }
 
 Sound::~Sound(){
+    if (loadState == S_LOADSTATE_LOADING)
+        AsyncLoader::cancel(this);
     delete player;
 }
 
 int Sound::load(){
-    return player->load();
+    int res = player->load();
+    loadState = (res == 0)?S_LOADSTATE_LOADED:S_LOADSTATE_FAILED;
+    return res;
+}
+
+bool Sound::loadAsync(){
+    if (loadState == S_LOADSTATE_LOADING)
+        return false;
+
+    loadState = S_LOADSTATE_LOADING;
+
+    //Audio decoding has no render work, all is done in loader thread
+    AsyncLoader::add(this, [this](){
+        return (player->load() == 0);
+    }, [this](bool success){
+        loadState = (success)?S_LOADSTATE_LOADED:S_LOADSTATE_FAILED;
+        onLoad.call();
+    });
+
+    return true;
+}
+
+int Sound::getLoadState(){
+    return loadState;
 }
 
 void Sound::destroy(){
 }
 
 int Sound::play(){
+    if (loadState == S_LOADSTATE_LOADING){
+        Log::Warn("Sound '%s' is still loading", filename.c_str());
+        return -1;
+    }
     return player->play();
 }
 
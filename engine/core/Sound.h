@@ -4,6 +4,8 @@
 #define Sound_h
 
 #include "audio/AudioPlayer.h"
+#include "util/AsyncLoader.h"
+#include "util/FunctionSubscribe.h"
 
 #include <string>
 
@@ -14,12 +16,17 @@ namespace Supernova {
     private:
         AudioPlayer* player;
         std::string filename;
+        int loadState;
 
     public:
         Sound(std::string filename);
         virtual ~Sound();
 
+        FunctionSubscribe<void()> onLoad;
+
         int load();
+        bool loadAsync();
+        int getLoadState();
         void destroy();
 
         int play();
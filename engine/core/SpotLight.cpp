@@ -1,7 +1,6 @@
 #include "SpotLight.h"
 
 #include "math/Angle.h"
-#include "util/UniqueToken.h"
 #include <stdlib.h>
 
 using namespace Supernova;
@@ -23,7 +22,7 @@ void SpotLight::updateLightCamera(){
 
     lightCameras[0]->setPosition(getWorldPosition());
     lightCameras[0]->setView(getWorldTarget());
-    lightCameras[0]->setPerspective(Angle::radToDefault(spotOuterAngle), (float)shadowMapWidth / (float)shadowMapHeight, 1, 100 * power);
+    lightCameras[0]->setPerspective(Angle::radToDefault(spotOuterAngle), (float)shadowMapWidth / (float)shadowMapHeight, 1, getRange());
 
     //TODO: Check this
     Vector3 cameraDirection = (lightCameras[0]->getPosition() - lightCameras[0]->getView()).normalize();
@@ -54,11 +53,15 @@ void SpotLight::setTarget(float x, float y, float z){
 void SpotLight::setSpotAngle(float angle){
     this->spotAngle = Angle::defaultToRad(angle);
     this->spotOuterAngle = this->spotAngle + this->smooth;
+    lightDataDirty = true;
+    requestRedraw();
 }
 
 void SpotLight::setSmooth(float angle){
     this->smooth = Angle::defaultToRad(angle);
     this->spotOuterAngle = this->spotAngle + this->smooth;
+    lightDataDirty = true;
+    requestRedraw();
 }
 
 bool SpotLight::loadShadow(){
@@ -69,13 +72,6 @@ bool SpotLight::loadShadow(){
         if (depthVPMatrix.size()==0)
             depthVPMatrix.push_back(Matrix4());
 
-        if (shadowMap.size()==0) {
-            shadowMap.push_back(new Texture(shadowMapWidth, shadowMapHeight));
-
-            shadowMap[0]->setId("shadowMap|" + UniqueToken::get());
-            shadowMap[0]->setType(S_TEXTURE_DEPTH_FRAME);
-        }
-
         updateLightCamera();
 
     }
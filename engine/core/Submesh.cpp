@@ -201,6 +201,9 @@ void Submesh::renderSetup(bool shadow){
                 render->addProperty(S_PROPERTY_TEXTURERECT, S_PROPERTYDATA_FLOAT4, 1, material->getTextureRect());
         }
 
+        if (bonesMatrix.size() > 0)
+            render->addProperty(S_PROPERTY_BONESMATRIX, S_PROPERTYDATA_MATRIX4, bonesMatrix.size(), &bonesMatrix.front());
+
     } else {
 
         shadowRender = getSubmeshShadowRender();
@@ -210,5 +213,8 @@ void Submesh::renderSetup(bool shadow){
             shadowRender->addVertexAttribute(x.first, x.second.getBuffer(), x.second.getElements(), x.second.getDataType(), x.second.getStride(), x.second.getOffset());
         }
 
+        if (bonesMatrix.size() > 0)
+            shadowRender->addProperty(S_PROPERTY_BONESMATRIX, S_PROPERTYDATA_MATRIX4, bonesMatrix.size(), &bonesMatrix.front());
+
     }
 }
\ No newline at end of file
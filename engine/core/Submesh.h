@@ -2,6 +2,7 @@
 #define Submesh_h
 
 #include "math/Vector4.h"
+#include "math/Matrix4.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -34,6 +35,10 @@ namespace Supernova {
 
         bool shadowRenderOwned;
 
+        //Own skinning palette when model bones are split, slots are indices of model bones
+        std::vector<int> paletteBones;
+        std::vector<Matrix4> bonesMatrix;
+
     protected:
         ObjectRender* render;
         ObjectRender* shadowRender;
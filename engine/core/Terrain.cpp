@@ -289,6 +289,11 @@ void Terrain::updateNodes(){
     }
 }
 
+void Terrain::updateLocalBounds(){
+    //Heights come from heightmap in shader
+    localBounds.setInfinite();
+}
+
 void Terrain::updateModelMatrix(){
     Mesh::updateModelMatrix();
 
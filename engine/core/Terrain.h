@@ -62,6 +62,8 @@ namespace Supernova{
 
         void updateNodes();
 
+        virtual void updateLocalBounds();
+
         virtual void updateModelMatrix();
         virtual void updateVPMatrix(Matrix4* viewMatrix, Matrix4* projectionMatrix, Matrix4* viewProjectionMatrix, Vector3* cameraPosition);
 
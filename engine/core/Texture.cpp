@@ -18,6 +18,7 @@ Texture::Texture(){
     
     this->dataOwned = false;
     this->preserveData = false;
+    this->preloaded = false;
 
     this->resampleToPowerOfTwo = false;
     this->nearestScale = false;
@@ -60,6 +61,7 @@ Texture::Texture(const Texture& t){
     this->type = t.type;
     this->id = t.id;
     this->dataOwned = t.dataOwned;
+    this->preloaded = t.preloaded;
 }
 
 Texture& Texture::operator = (const Texture& t){
@@ -69,6 +71,7 @@ Texture& Texture::operator = (const Texture& t){
     this->type = t.type;
     this->id = t.id;
     this->dataOwned = t.dataOwned;
+    this->preloaded = t.preloaded;
 
     return *this;
 }
@@ -90,6 +93,7 @@ void Texture::setId(std::string id){
 
 void Texture::setTextureData(TextureData* textureData){
     texturesData[0] = textureData;
+    preloaded = false;
 }
 
 void Texture::setType(int type){
@@ -123,36 +127,75 @@ void Texture::setDefaults(){
         nearestScale = Engine::isDefaultNearestScaleTexture();
 }
 
-bool Texture::load(){
+bool Texture::preload(){
 
-    textureRender = TextureRender::sharedInstance(id);
+    if (preloaded)
+        return true;
 
     setDefaults();
-    textureRender.get()->setNearestScale(nearestScale);
-    
-    bool renderNotPrepared = false;
 
-    if (!textureRender.get()->isLoaded()){
+    if (type == S_TEXTURE_2D){
 
-        if (type == S_TEXTURE_2D){
+        if (paths.size() > 0){
+            texturesData.push_back(new TextureData());
+            texturesData.back()->loadTextureFromFile(paths[0].c_str());
+            if (!texturesData.back()->getData()) {
+                releaseData();
+                return false;
+            }
+            dataOwned = true;
+        }
+
+        //Data already released after render load
+        if (texturesData.size() == 0 || !texturesData[0])
+            return true;
 
-            if (paths.size() > 0){
+        if (resampleToPowerOfTwo){
+            texturesData[0]->resamplePowerOfTwo();
+        }else{
+            texturesData[0]->fitPowerOfTwo();
+        }
+
+    }else if (type == S_TEXTURE_CUBE){
+
+        if (paths.size() > 0) {
+            for (int i = 0; i < paths.size(); i++) {
                 texturesData.push_back(new TextureData());
-                texturesData.back()->loadTextureFromFile(paths[0].c_str());
+                texturesData.back()->loadTextureFromFile(paths[i].c_str());
                 if (!texturesData.back()->getData()) {
                     releaseData();
-                    this->textureRender.reset();
-                    TextureRender::deleteUnused();
                     return false;
                 }
-                dataOwned = true;
+                texturesData.back()->resamplePowerOfTwo();
             }
+            dataOwned = true;
+        }
 
-            if (resampleToPowerOfTwo){
-                texturesData[0]->resamplePowerOfTwo();
-            }else{
-                texturesData[0]->fitPowerOfTwo();
-            }
+    }
+
+    preloaded = true;
+
+    return true;
+}
+
+bool Texture::load(){
+
+    textureRender = TextureRender::sharedInstance(id);
+
+    setDefaults();
+    textureRender.get()->setNearestScale(nearestScale);
+    
+    bool renderNotPrepared = false;
+
+    if (!textureRender.get()->isLoaded()){
+
+        if (!preload()){
+            this->textureRender.reset();
+            TextureRender::deleteUnused();
+            return false;
+        }
+
+        if (type == S_TEXTURE_2D){
 
             if (!textureRender.get()->loadTexture(texturesData[0])){
                 renderNotPrepared = true;
@@ -160,21 +203,6 @@ bool Texture::load(){
             
         }else if (type == S_TEXTURE_CUBE){
 
-            if (paths.size() > 0) {
-                for (int i = 0; i < paths.size(); i++) {
-                    texturesData.push_back(new TextureData());
-                    texturesData.back()->loadTextureFromFile(paths[i].c_str());
-                    if (!texturesData.back()->getData()) {
-                        releaseData();
-                        this->textureRender.reset();
-                        TextureRender::deleteUnused();
-                        return false;
-                    }
-                    texturesData.back()->resamplePowerOfTwo();
-                }
-                dataOwned = true;
-            }
-
             if (!textureRender.get()->loadTextureCube(texturesData)){
                 renderNotPrepared = true;
             }
@@ -209,6 +237,9 @@ bool Texture::load(){
             releaseData();
         }
         
+    }else if (preloaded && dataOwned && paths.size() > 0 && !preserveData){
+        //Decoded by preload but already in render by another texture with same id
+        releaseData();
     }
     
     return true;
@@ -221,6 +252,7 @@ void Texture::releaseData(){
     }
     this->texturesData.clear();
     this->texturesData.push_back(NULL);
+    this->preloaded = false;
 }
 
 std::string Texture::getId(){
@@ -34,6 +34,7 @@ namespace Supernova{
         
         bool dataOwned;
         bool preserveData;
+        bool preloaded;
 
         bool resampleToPowerOfTwo;
         bool nearestScale;
@@ -85,6 +86,7 @@ namespace Supernova{
         int getWidth();
         int getHeight();
         
+        bool preload();
         bool load();
         void destroy();
     };
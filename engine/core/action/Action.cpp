@@ -14,6 +14,7 @@ Action::Action(){
     this->object = NULL;
     this->running = false;
     this->timecount = 0;
+    this->scheduled = false;
 }
 
 Action::~Action(){
@@ -26,6 +27,7 @@ Object* Action::getObject(){
 }
 
 void Action::setTimecount(float timecount){
+    unschedule();
     this->timecount = timecount;
 }
 
@@ -61,9 +63,20 @@ bool Action::update(float interval){
     if (running){
         timecount += interval;
         onUpdate.call(object, interval);
+
+        if (object)
+            object->requestRedraw();
     }else{
         return false;
     }
 
     return true;
 }
+
+bool Action::schedule(Scene*){
+    return false;
+}
+
+void Action::unschedule(){
+
+}
@@ -10,11 +10,16 @@
 namespace Supernova{
 
     class Object;
+    class Scene;
+    class TweenSystem;
+    class SpriteAnimationSystem;
 
     class Action{
 
         friend class Object;
         friend class Animation;
+        friend class TweenSystem;
+        friend class SpriteAnimationSystem;
         
     protected:
         
@@ -22,6 +27,9 @@ namespace Supernova{
         
         bool running;
         Object* object;
+
+        //Updated by scene TweenSystem instead of Object::updateActions
+        bool scheduled;
         
     public:
         Action();
@@ -45,6 +53,10 @@ namespace Supernova{
         virtual bool stop();
 
         virtual bool update(float interval);
+
+        //Moves action to batched updates, returns false when it can not be batched
+        virtual bool schedule(Scene* scene);
+        virtual void unschedule();
     };
 }
 
@@ -2,6 +2,7 @@
 
 #include "Object.h"
 #include "GraphicObject.h"
+#include "TweenSystem.h"
 
 using namespace Supernova;
 
@@ -46,4 +47,14 @@ bool AlphaAction::update(float interval){
     }
 
     return true;
-}
\ No newline at end of file
+}
+
+bool AlphaAction::schedule(Scene* scene){
+    if (!dynamic_cast<GraphicObject*>(object))
+        return false;
+
+    float start[] = {startAlpha};
+    float end[] = {endAlpha};
+
+    return addTween(scene, S_TWEEN_ALPHA, start, end);
+}
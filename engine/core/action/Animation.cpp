@@ -63,7 +63,7 @@ bool Animation::checkAllKeyframe(){
 
 void Animation::setStartFrame(int frameIndex){
     if (checkAllKeyframe()){
-        std::vector<float> times = ((KeyframeTrack*)actions[0].action)->getTimes();
+        const std::vector<float>& times = ((KeyframeTrack*)actions[0].action)->getTimes();
 
         if (frameIndex <= 0 || frameIndex > (times.size()-1)){
             Log::Error("Frameindex is out of bound");
@@ -86,7 +86,7 @@ float Animation::getStartTime(){
 
 void Animation::setEndFrame(int frameIndex){
     if (checkAllKeyframe()){
-        std::vector<float> times = ((KeyframeTrack*)actions[0].action)->getTimes();
+        const std::vector<float>& times = ((KeyframeTrack*)actions[0].action)->getTimes();
 
         if (frameIndex <= 0 || frameIndex > (times.size()-1)){
             Log::Error("Frameindex is out of bound");
@@ -132,6 +132,10 @@ Animation::ActionFrame Animation::getActionFrame(unsigned int index){
     }
 }
 
+size_t Animation::getNumActionFrames(){
+    return actions.size();
+}
+
 void Animation::clearActionFrames(){
     if (ownedActions){
         for (int i = 0; i < actions.size(); i++){
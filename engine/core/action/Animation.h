@@ -59,6 +59,7 @@ namespace Supernova {
         void addActionFrame(float startTime, float endTime, Action* action, Object* object);
         void addActionFrame(float startTime, TimeAction* action, Object* object);
         ActionFrame getActionFrame(unsigned int index);
+        size_t getNumActionFrames();
         void clearActionFrames();
 
         virtual bool run();
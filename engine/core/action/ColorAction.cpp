@@ -2,6 +2,7 @@
 
 #include "Object.h"
 #include "GraphicObject.h"
+#include "TweenSystem.h"
 
 
 using namespace Supernova;
@@ -67,3 +68,13 @@ bool ColorAction::update(float interval){
 
     return true;
 }
+
+bool ColorAction::schedule(Scene* scene){
+    if (!dynamic_cast<GraphicObject*>(object))
+        return false;
+
+    float start[] = {startColor.x, startColor.y, startColor.z, startColor.w};
+    float end[] = {endColor.x, endColor.y, endColor.z, endColor.w};
+
+    return addTween(scene, (useAlpha) ? S_TWEEN_COLOR : S_TWEEN_COLOR_RGB, start, end);
+}
@@ -25,6 +25,8 @@ namespace Supernova{
         virtual bool run();
 
         virtual bool update(float interval);
+
+        virtual bool schedule(Scene* scene);
     };
 }
 
@@ -8,6 +8,7 @@ using namespace Supernova;
 
 Ease::Ease(){
     this->function = Ease::linear;
+    this->functionType = S_LINEAR;
 }
 
 Ease::~Ease(){
@@ -234,13 +235,46 @@ float Ease::easeInOutBounce(float time){
     return easeOutBounce(time * 2 - 1) * 0.5 + 0.5;
 }
 
+//Same order of S_ ease constants
+static Ease::EaseFunction easeFunctions[S_EASE_FUNCTIONS] = {
+        Ease::linear,
+        Ease::easeInQuad, Ease::easeOutQuad, Ease::easeInOutQuad,
+        Ease::easeInCubic, Ease::easeOutCubic, Ease::easeInOutCubic,
+        Ease::easeInQuart, Ease::easeOutQuart, Ease::easeInOutQuart,
+        Ease::easeInQuint, Ease::easeOutQuint, Ease::easeInOutQuint,
+        Ease::easeInSine, Ease::easeOutSine, Ease::easeInOutSine,
+        Ease::easeInExpo, Ease::easeOutExpo, Ease::easeInOutExpo,
+        Ease::easeInCirc, Ease::easeOutCirc, Ease::easeInOutCirc,
+        Ease::easeInElastic, Ease::easeOutElastic, Ease::easeInOutElastic,
+        Ease::easeInBack, Ease::easeOutBack, Ease::easeInOutBack,
+        Ease::easeInBounce, Ease::easeOutBounce, Ease::easeInOutBounce
+};
+
+Ease::EaseFunction Ease::getFunction(int functionType){
+    if (functionType < 0 || functionType >= S_EASE_FUNCTIONS)
+        return NULL;
+
+    return easeFunctions[functionType];
+}
+
+int Ease::findFunctionType(EaseFunction function){
+    for (int i = 0; i < S_EASE_FUNCTIONS; i++){
+        if (easeFunctions[i] == function)
+            return i;
+    }
+
+    return -1;
+}
+
 void Ease::setFunction(std::function<float(float)> function){
     this->function.remove();
     this->function = function;
+    this->functionType = -1;
 }
 
 int Ease::setFunction(lua_State* L){
     this->function.remove();
+    this->functionType = -1;
     return this->function.set(L);
 }
 
@@ -248,68 +282,17 @@ void Ease::setFunctionType(int functionType){
 
     function.remove();
 
-    if (functionType == S_LINEAR){
-        function = Ease::linear;
-    }else if(functionType == S_EASE_QUAD_IN){
-        function = Ease::easeInQuad;
-    }else if(functionType == S_EASE_QUAD_OUT){
-        function = Ease::easeOutQuad;
-    }else if(functionType == S_EASE_QUAD_IN_OUT){
-        function = Ease::easeInOutQuad;
-    }else if(functionType == S_EASE_CUBIC_IN){
-        function = Ease::easeInCubic;
-    }else if(functionType == S_EASE_CUBIC_OUT){
-        function = Ease::easeOutCubic;
-    }else if(functionType == S_EASE_CUBIC_IN_OUT){
-        function = Ease::easeInOutCubic;
-    }else if(functionType == S_EASE_QUART_IN){
-        function = Ease::easeInQuart;
-    }else if(functionType == S_EASE_QUART_OUT){
-        function = Ease::easeOutQuart;
-    }else if(functionType == S_EASE_QUART_IN_OUT){
-        function = Ease::easeInOutQuart;
-    }else if(functionType == S_EASE_QUINT_IN){
-        function = Ease::easeInQuint;
-    }else if(functionType == S_EASE_QUINT_OUT){
-        function = Ease::easeOutQuint;
-    }else if(functionType == S_EASE_QUINT_IN_OUT){
-        function = Ease::easeInOutQuint;
-    }else if(functionType == S_EASE_SINE_IN){
-        function = Ease::easeInSine;
-    }else if(functionType == S_EASE_SINE_OUT){
-        function = Ease::easeOutSine;
-    }else if(functionType == S_EASE_SINE_IN_OUT){
-        function = Ease::easeInOutSine;
-    }else if(functionType == S_EASE_EXPO_IN){
-        function = Ease::easeInExpo;
-    }else if(functionType == S_EASE_EXPO_OUT){
-        function = Ease::easeOutExpo;
-    }else if(functionType == S_EASE_EXPO_IN_OUT){
-        function = Ease::easeInOutExpo;
-    }else if(functionType == S_EASE_CIRC_IN){
-        function = Ease::easeInCirc;
-    }else if(functionType == S_EASE_CIRC_OUT){
-        function = Ease::easeOutCirc;
-    }else if(functionType == S_EASE_CIRC_IN_OUT){
-        function = Ease::easeInOutCirc;
-    }else if(functionType == S_EASE_ELASTIC_IN){
-        function = Ease::easeInElastic;
-    }else if(functionType == S_EASE_ELASTIC_OUT){
-        function = Ease::easeOutElastic;
-    }else if(functionType == S_EASE_ELASTIC_IN_OUT){
-        function = Ease::easeInOutElastic;
-    }else if(functionType == S_EASE_BACK_IN){
-        function = Ease::easeInBack;
-    }else if(functionType == S_EASE_BACK_OUT){
-        function = Ease::easeOutBack;
-    }else if(functionType == S_EASE_BACK_IN_OUT){
-        function = Ease::easeInOutBack;
-    }else if(functionType == S_EASE_BOUNCE_IN){
-        function = Ease::easeInBounce;
-    }else if(functionType == S_EASE_BOUNCE_OUT){
-        function = Ease::easeOutBounce;
-    }else if(functionType == S_EASE_BOUNCE_IN_OUT){
-        function = Ease::easeInOutBounce;
+    EaseFunction easeFunction = getFunction(functionType);
+
+    if (easeFunction){
+        function = easeFunction;
+        this->functionType = functionType;
+    }else{
+        this->functionType = -1;
     }
 
 }
+
+int Ease::getFunctionType(){
+    return functionType;
+}
@@ -35,13 +35,21 @@
 #define S_EASE_BOUNCE_OUT 29
 #define S_EASE_BOUNCE_IN_OUT 30
 
+#define S_EASE_FUNCTIONS 31
+
 namespace Supernova {
 
     class Ease {
 
+    public:
+
+        typedef float (*EaseFunction)(float);
+
     protected:
 
         Function<float(float)> function;
+        //One of S_ ease constants, -1 when function is custom
+        int functionType;
 
     public:
 
@@ -84,6 +92,11 @@ namespace Supernova {
         int setFunction(lua_State* L);
 
         void setFunctionType(int functionType);
+        int getFunctionType();
+
+        //Shared by batched tweens, NULL when type is invalid
+        static EaseFunction getFunction(int functionType);
+        static int findFunctionType(EaseFunction function);
 
     };
 }
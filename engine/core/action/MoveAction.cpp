@@ -1,6 +1,7 @@
 #include "MoveAction.h"
 
 #include "Object.h"
+#include "TweenSystem.h"
 
 
 using namespace Supernova;
@@ -25,10 +26,12 @@ MoveAction::~MoveAction(){
 }
 
 void MoveAction::setEndPosition(Vector3 endPosition){
+    unschedule();
     this->endPosition = endPosition;
 }
 
 void MoveAction::setStartPosition(Vector3 startPosition){
+    unschedule();
     this->startPosition = startPosition;
     this->objectStartPosition = false;
 }
@@ -55,3 +58,10 @@ bool MoveAction::update(float interval){
     
     return true;
 }
+
+bool MoveAction::schedule(Scene* scene){
+    float start[] = {startPosition.x, startPosition.y, startPosition.z};
+    float end[] = {endPosition.x, endPosition.y, endPosition.z};
+
+    return addTween(scene, S_TWEEN_POSITION, start, end);
+}
@@ -1,6 +1,7 @@
 #include "ParticlesAnimation.h"
 #include "Particles.h"
 #include "Log.h"
+#include "math/SIMD.h"
 
 #include <stdlib.h> 
 
@@ -13,6 +14,9 @@ ParticlesAnimation::ParticlesAnimation(): Action(){
 
     initOwned = true;
     modOwned = true;
+
+    particles = NULL;
+    particlesObject = NULL;
 }
 
 ParticlesAnimation::~ParticlesAnimation(){
@@ -24,6 +28,15 @@ ParticlesAnimation::~ParticlesAnimation(){
     
 }
 
+Particles* ParticlesAnimation::getParticles(){
+    if (particlesObject != object){
+        particlesObject = object;
+        particles = dynamic_cast<Particles*>(object);
+    }
+
+    return particles;
+}
+
 void ParticlesAnimation::addInit(ParticleInit* particleInit){
     particlesInit.push_back(particleInit);
 }
@@ -68,7 +81,7 @@ bool ParticlesAnimation::run(){
     if (!Action::run())
         return false;
     
-    if (Particles* particles = dynamic_cast<Particles*>(object)) {
+    if (getParticles()) {
         emitter = true;
     }else{
         Log::Error("Object in ParticlesAnimation must be a Particles type");
@@ -86,10 +99,11 @@ bool ParticlesAnimation::stop(){
     if (!Action::stop())
         return false;
     
-    if (Particles* particles = dynamic_cast<Particles*>(object)){
-        for (int i = 0; i < particles->getMaxParticles(); i++) {
+    if (Particles* particles = getParticles()){
+        for (int i = 0; i < particles->getLiveParticles(); i++) {
             particles->setParticleLife(i, -1);
         }
+        particles->compactParticles();
         
         particles->updateParticles();
     }
@@ -120,7 +134,7 @@ bool ParticlesAnimation::update(float interval){
     if (!Action::update(interval))
         return false;
 
-    if (Particles* particles = dynamic_cast<Particles*>(object)){
+    if (Particles* particles = getParticles()){
 
         if (emitter){
             newParticlesCount += interval * particles->getMinRate();
@@ -131,6 +145,9 @@ bool ParticlesAnimation::update(float interval){
             if (newparticles > particles->getMaxRate())
                 newparticles = particles->getMaxRate();
 
+            //New particles are always appended to live range
+            int first = particles->getLiveParticles();
+
             for(int i=0; i<newparticles; i++){
                 int particleIndex = particles->findUnusedParticle();
                 
@@ -143,45 +160,59 @@ bool ParticlesAnimation::update(float interval){
                     particles->setParticleColor(particleIndex, Vector4(1,1,1,1));
                     particles->setParticleSize(particleIndex, 1);
                     particles->setParticleSprite(particleIndex, -1);
-
-                    for (int init=0; init < particlesInit.size(); init++){
-                        particlesInit[init]->execute(particles, particleIndex);
-                    }
                     
                 }
             }
-        }
 
-        bool existParticles = false;
-        for(int i=0; i<particles->getMaxParticles(); i++){
-            
-            float life = particles->getParticleLife(i);
-            
-            if(life > 0.0f){
+            int last = particles->getLiveParticles();
 
-                for (int mod=0; mod < particlesMod.size(); mod++){
-                    particlesMod[mod]->execute(particles, i, life);
+            if (last > first){
+                for (int init=0; init < particlesInit.size(); init++){
+                    particlesInit[init]->executeRange(particles, first, last);
                 }
-                
-                Vector3 velocity = particles->getParticleVelocity(i);
-                Vector3 position = particles->getParticlePosition(i);
-                Vector3 acceleration = particles->getParticleAcceleration(i);
-                
-                velocity += acceleration * interval * 0.5f;
-                position += velocity * interval;
-                life -= interval;
-
-                particles->setParticleLife(i, life);
-                particles->setParticleVelocity(i, velocity);
-                particles->setParticlePosition(i, position);
-                
-                existParticles = true;
-                
-                //printf("1.Particle %i life %f position %f %f %f\n", i, life, position.x, position.y, position.z);
             }
         }
+
+        particles->compactParticles();
+
+        int live = particles->getLiveParticles();
+
+        for (int mod=0; mod < particlesMod.size(); mod++){
+            particlesMod[mod]->executeRange(particles, 0, live);
+        }
+
+        float* positions = particles->getPositionsData();
+        float* velocities = particles->getVelocitiesData();
+        float* accelerations = particles->getAccelerationsData();
+        float* lifes = particles->getLifesData();
+
+        //Position, velocity and acceleration are packed, so they are integrated as flat arrays
+        int count = live * 3;
+        int i = 0;
+#ifdef SUPERNOVA_SIMD
+        SIMD::float4 vInterval = SIMD::splat(interval);
+        SIMD::float4 vHalf = SIMD::splat(0.5f);
+        for (; i + 4 <= count; i += 4){
+            SIMD::float4 velocity = SIMD::load(velocities + i);
+            SIMD::float4 acceleration = SIMD::load(accelerations + i);
+
+            velocity = SIMD::add(velocity, SIMD::mul(SIMD::mul(acceleration, vInterval), vHalf));
+            SIMD::store(velocities + i, velocity);
+            SIMD::store(positions + i, SIMD::add(SIMD::load(positions + i), SIMD::mul(velocity, vInterval)));
+        }
+#endif
+        for (; i < count; i++){
+            velocities[i] += accelerations[i] * interval * 0.5f;
+            positions[i] += velocities[i] * interval;
+        }
+
+        for (i = 0; i < live; i++){
+            lifes[i] -= interval;
+        }
+
+        particles->compactParticles();
         
-        if (!existParticles && !emitter){
+        if (particles->getLiveParticles() == 0 && !emitter){
             stop();
             onFinish.call(object);
         }
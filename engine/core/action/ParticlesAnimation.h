@@ -6,9 +6,17 @@
 #include "action/particlemod/ParticleMod.h"
 
 namespace Supernova{
+
+    class Particles;
     
     class ParticlesAnimation: public Action{
 
+    private:
+        Particles* particles;
+        Object* particlesObject;
+
+        Particles* getParticles();
+
     protected:
 
         std::vector<ParticleInit*> particlesInit;
@@ -1,6 +1,7 @@
 #include "RotateAction.h"
 
 #include "Object.h"
+#include "TweenSystem.h"
 
 using namespace Supernova;
 
@@ -60,3 +61,10 @@ bool RotateAction::update(float interval){
 
     return true;
 }
+
+bool RotateAction::schedule(Scene* scene){
+    float start[] = {startRotation.w, startRotation.x, startRotation.y, startRotation.z};
+    float end[] = {endRotation.w, endRotation.x, endRotation.y, endRotation.z};
+
+    return addTween(scene, S_TWEEN_ROTATION, start, end);
+}
@@ -1,6 +1,7 @@
 #include "ScaleAction.h"
 
 #include "Object.h"
+#include "TweenSystem.h"
 
 
 using namespace Supernova;
@@ -42,3 +43,10 @@ bool ScaleAction::update(float interval){
 
     return true;
 }
+
+bool ScaleAction::schedule(Scene* scene){
+    float start[] = {startScale.x, startScale.y, startScale.z};
+    float end[] = {endScale.x, endScale.y, endScale.z};
+
+    return addTween(scene, S_TWEEN_SCALE, start, end);
+}
@@ -23,6 +23,8 @@ namespace Supernova{
 
         virtual bool update(float interval);
 
+        virtual bool schedule(Scene* scene);
+
     };
 
 }
@@ -1,60 +1,82 @@
 #include "SpriteAnimation.h"
+#include "SpriteAnimationSystem.h"
 #include "Sprite.h"
+#include "Scene.h"
 #include "Log.h"
+#include <algorithm>
+#include <math.h>
 
 using namespace Supernova;
 
 SpriteAnimation::SpriteAnimation(std::vector<int> framesTime, std::vector<int> frames, bool loop): Action(){
-    this->spriteFrameCount = 0;
     this->framesIndex = 0;
-    this->framesTimeIndex = 0;
 
     this->loop = loop;
-    
+
     this->framesTime = framesTime;
     this->frames = frames;
-    
+
     this->startFrame = 0;
     this->endFrame = 0;
+
+    this->sprite = NULL;
+    this->spriteObject = NULL;
+    this->cycleTime = 0;
+    this->elapsedTime = 0;
+    this->nextTime = 0;
+    this->animationSystem = NULL;
+    this->animationIndex = 0;
+    this->animationCallback = -1;
 }
 
 SpriteAnimation::SpriteAnimation(std::vector<int> framesTime, int startFrame, int endFrame, bool loop): Action(){
-    this->spriteFrameCount = 0;
     this->framesIndex = 0;
-    this->framesTimeIndex = 0;
 
     this->loop = loop;
 
     this->framesTime = framesTime;
-    
+
     this->startFrame = startFrame;
     this->endFrame = endFrame;
-    
+
+    this->sprite = NULL;
+    this->spriteObject = NULL;
+    this->cycleTime = 0;
+    this->elapsedTime = 0;
+    this->nextTime = 0;
+    this->animationSystem = NULL;
+    this->animationIndex = 0;
+    this->animationCallback = -1;
 }
 
 SpriteAnimation::SpriteAnimation(int interval, int startFrame, int endFrame, bool loop): Action(){
-    this->spriteFrameCount = 0;
     this->framesIndex = 0;
-    this->framesTimeIndex = 0;
 
     this->loop = loop;
-    
+
     std::vector<int> framesTime;
     framesTime.push_back(interval);
-    
+
     this->framesTime = framesTime;
-    
+
     this->startFrame = startFrame;
     this->endFrame = endFrame;
+
+    this->sprite = NULL;
+    this->spriteObject = NULL;
+    this->cycleTime = 0;
+    this->elapsedTime = 0;
+    this->nextTime = 0;
+    this->animationSystem = NULL;
+    this->animationIndex = 0;
+    this->animationCallback = -1;
 }
 
 SpriteAnimation::SpriteAnimation(int interval, std::vector<int> frames, bool loop): Action(){
-    this->spriteFrameCount = 0;
     this->framesIndex = 0;
-    this->framesTimeIndex = 0;
 
     this->loop = loop;
-    
+
     std::vector<int> framesTime;
     framesTime.push_back(interval);
 
@@ -63,17 +85,93 @@ SpriteAnimation::SpriteAnimation(int interval, std::vector<int> frames, bool loo
 
     this->startFrame = 0;
     this->endFrame = 0;
+
+    this->sprite = NULL;
+    this->spriteObject = NULL;
+    this->cycleTime = 0;
+    this->elapsedTime = 0;
+    this->nextTime = 0;
+    this->animationSystem = NULL;
+    this->animationIndex = 0;
+    this->animationCallback = -1;
 }
 
 SpriteAnimation::~SpriteAnimation(){
-    
+    unschedule();
+}
+
+Sprite* SpriteAnimation::getSprite(){
+    if (spriteObject != object){
+        spriteObject = object;
+        sprite = dynamic_cast<Sprite*>(object);
+    }
+
+    return sprite;
+}
+
+void SpriteAnimation::buildStepTimes(){
+    stepTimes.clear();
+    cycleTime = 0;
+
+    size_t framesSize = frames.size();
+    size_t timesSize = framesTime.size();
+
+    if (framesSize == 0 || timesSize == 0)
+        return;
+
+    size_t a = framesSize;
+    size_t b = timesSize;
+    while (b != 0){
+        size_t r = a % b;
+        a = b;
+        b = r;
+    }
+
+    size_t steps = (framesSize / a) * timesSize;
+
+    for (size_t i = 0; i < steps; i++){
+        cycleTime += framesTime[i % timesSize];
+        stepTimes.push_back(cycleTime);
+    }
+}
+
+bool SpriteAnimation::evaluate(){
+    if (stepTimes.size() == 0 || frames.size() == 0)
+        return true;
+
+    if (loop && elapsedTime >= cycleTime)
+        elapsedTime = fmod(elapsedTime, cycleTime);
+
+    //Binary search for step that ends after elapsed time
+    size_t step = std::upper_bound(stepTimes.begin(), stepTimes.end(), elapsedTime) - stepTimes.begin();
+
+    size_t lastFrame = frames.size() - 1;
+    bool finished = (!loop && step > 0 && step >= lastFrame);
+
+    int index;
+    if (finished){
+        index = (int)lastFrame;
+    }else{
+        index = (int)(step % frames.size());
+        nextTime = stepTimes[step];
+    }
+
+    if (index != framesIndex || finished){
+        framesIndex = index;
+        if (sprite)
+            sprite->setFrame(frames[framesIndex]);
+    }
+
+    return !finished;
 }
 
 bool SpriteAnimation::run(){
+    unschedule();
+
     if (!Action::run())
         return false;
 
-    if (Sprite* sprite = dynamic_cast<Sprite*>(object)) {
+    if (Sprite* sprite = getSprite()) {
 
         bool erro = false;
 
@@ -89,6 +187,9 @@ bool SpriteAnimation::run(){
         }else if (endFrame < 0 && endFrame >= sprite->getFramesSize()){
             Log::Error("Incorrect sprite animation: range of endFrame");
             erro = true;
+        }else if (!framesTime.empty() && *std::min_element(framesTime.begin(), framesTime.end()) < 0){
+            Log::Error("Incorrect sprite animation: negative framesTime");
+            erro = true;
         }
 
         if (!erro) {
@@ -112,63 +213,69 @@ bool SpriteAnimation::run(){
                 this->frames = frames;
             }
 
-            sprite->setFrame(frames[framesIndex]);
+            buildStepTimes();
+
+            if (cycleTime > 0){
+                sprite->setFrame(frames[framesIndex]);
+            }else{
+                Log::Error("Incorrect sprite animation: framesTime sum is zero");
+                stop();
+            }
         }else{
             Log::Error("Object in SpriteAnimation must be a Sprite type");
             stop();
         }
     }
-    
+
     return true;
 }
 
 bool SpriteAnimation::pause(){
+    unschedule();
+
     return Action::pause();
 }
 
 bool SpriteAnimation::stop(){
+    unschedule();
+
     if (!Action::stop())
         return false;
 
-    this->spriteFrameCount = 0;
     this->framesIndex = 0;
-    this->framesTimeIndex = 0;
-    
+    this->elapsedTime = 0;
+    this->nextTime = 0;
+
     return true;
 }
 
 bool SpriteAnimation::update(float interval){
     if (!Action::update(interval))
         return false;
-    
-    if (Sprite* sprite = dynamic_cast<Sprite*>(object)){
-
-        spriteFrameCount += interval * 1000;
-        while ((spriteFrameCount >= framesTime[framesTimeIndex]) && (isRunning())) {
-
-            spriteFrameCount -= framesTime[framesTimeIndex];
-            
-            framesIndex++;
-            framesTimeIndex++;
-            
-            if (framesIndex == frames.size() - 1) {
-                if (!loop) {
-                    stop();
-                    onFinish.call(object);
-                }
-            }
-            
-            if (framesIndex >= frames.size())
-                framesIndex = 0;
-            
-            if (framesTimeIndex >= framesTime.size())
-                framesTimeIndex = 0;
 
-            sprite->setFrame(frames[framesIndex]);
+    if (getSprite()){
+
+        elapsedTime += interval * 1000;
 
+        if (elapsedTime >= nextTime && !evaluate()){
+            stop();
+            onFinish.call(object);
+            return false;
         }
 
     }
-    
+
     return true;
 }
+
+bool SpriteAnimation::schedule(Scene* scene){
+    if (!scene || !scene->batchedSpriteAnimations || !running || !getSprite() || cycleTime <= 0)
+        return false;
+
+    return scene->spriteAnimationSystem.add(this);
+}
+
+void SpriteAnimation::unschedule(){
+    if (animationSystem)
+        animationSystem->remove(this);
+}
@@ -5,19 +5,43 @@
 #include <vector>
 
 namespace Supernova{
+
+    class Sprite;
     
     class SpriteAnimation: public Action{
+
+        friend class SpriteAnimationSystem;
         
     protected:
         bool loop;
         std::vector<int> framesTime;
         std::vector<int> frames;
         int framesIndex;
-        int framesTimeIndex;
-        unsigned int spriteFrameCount;
         
         int startFrame;
         int endFrame;
+
+        //Cast once when object changes
+        Sprite* sprite;
+        Object* spriteObject;
+
+        //End time in ms of each step of a cycle, frames and framesTime wrap together after lcm of sizes
+        std::vector<float> stepTimes;
+        float cycleTime;
+        //Time in ms inside cycle, frame only changes when it reaches nextTime
+        float elapsedTime;
+        float nextTime;
+
+        //Set while scheduled, index changes when other animations are removed
+        SpriteAnimationSystem* animationSystem;
+        size_t animationIndex;
+        //Position in system callbacks of current update, -1 when not waiting
+        int animationCallback;
+
+        Sprite* getSprite();
+        void buildStepTimes();
+        //Sets frame of elapsedTime, returns false when last frame is reached and not looping
+        bool evaluate();
         
     public:
         SpriteAnimation(std::vector<int> framesTime, std::vector<int> frames, bool loop);
@@ -31,6 +55,9 @@ namespace Supernova{
         virtual bool stop();
         
         virtual bool update(float interval);
+
+        virtual bool schedule(Scene* scene);
+        virtual void unschedule();
     };
 }
 
@@ -0,0 +1,132 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "SpriteAnimationSystem.h"
+#include "SpriteAnimation.h"
+
+using namespace Supernova;
+
+SpriteAnimationSystem::SpriteAnimationSystem(){
+}
+
+SpriteAnimationSystem::~SpriteAnimationSystem(){
+    clear();
+}
+
+bool SpriteAnimationSystem::add(SpriteAnimation* animation){
+    if (animation->scheduled || !animation->object)
+        return false;
+
+    animation->scheduled = true;
+    animation->animationSystem = this;
+    animation->animationIndex = animations.size();
+
+    animations.push_back(animation);
+    timecounts.push_back(animation->timecount);
+    elapsedTimes.push_back(animation->elapsedTime);
+    nextTimes.push_back(animation->nextTime);
+
+    return true;
+}
+
+void SpriteAnimationSystem::remove(SpriteAnimation* animation){
+    if (!animation->scheduled || animation->animationSystem != this)
+        return;
+
+    size_t index = animation->animationIndex;
+    size_t last = animations.size() - 1;
+
+    animation->timecount = timecounts[index];
+    animation->elapsedTime = elapsedTimes[index];
+    animation->nextTime = nextTimes[index];
+
+    //Last animation is moved to removed place to keep arrays contiguous
+    if (index != last){
+        animations[index] = animations[last];
+        timecounts[index] = timecounts[last];
+        elapsedTimes[index] = elapsedTimes[last];
+        nextTimes[index] = nextTimes[last];
+
+        animations[index]->animationIndex = index;
+    }
+
+    animations.pop_back();
+    timecounts.pop_back();
+    elapsedTimes.pop_back();
+    nextTimes.pop_back();
+
+    if (animation->animationCallback >= 0){
+        callbackAnimations[animation->animationCallback] = NULL;
+        animation->animationCallback = -1;
+    }
+
+    animation->scheduled = false;
+    animation->animationSystem = NULL;
+}
+
+void SpriteAnimationSystem::clear(){
+    while (animations.size() > 0)
+        remove(animations.back());
+}
+
+size_t SpriteAnimationSystem::size() const{
+    return animations.size();
+}
+
+size_t SpriteAnimationSystem::update(float interval){
+    size_t count = animations.size();
+    float ms = interval * 1000;
+
+    for (size_t i = 0; i < count; i++){
+        timecounts[i] += interval;
+        elapsedTimes[i] += ms;
+
+        bool finished = false;
+
+        if (elapsedTimes[i] >= nextTimes[i]){
+            SpriteAnimation* animation = animations[i];
+
+            animation->elapsedTime = elapsedTimes[i];
+            finished = !animation->evaluate();
+
+            elapsedTimes[i] = animation->elapsedTime;
+            nextTimes[i] = animation->nextTime;
+        }
+
+        //Functions can be subscribed after animation was added
+        if (finished || animations[i]->onUpdate.size() > 0){
+            animations[i]->animationCallback = (int)callbackAnimations.size();
+            callbackAnimations.push_back(animations[i]);
+            callbackFinished.push_back(finished);
+        }
+    }
+
+    //Callbacks can stop or remove animations, so they run after the pass
+    for (size_t i = 0; i < callbackAnimations.size(); i++){
+        SpriteAnimation* animation = callbackAnimations[i];
+
+        //Removed by a previous callback, it can be deleted
+        if (!animation)
+            continue;
+
+        animation->onUpdate.call(animation->object, interval);
+
+        if (!callbackAnimations[i])
+            continue;
+
+        callbackAnimations[i] = NULL;
+        animation->animationCallback = -1;
+
+        if (callbackFinished[i]){
+            animation->unschedule();
+            animation->stop();
+            animation->onFinish.call(animation->object);
+        }
+    }
+
+    callbackAnimations.clear();
+    callbackFinished.clear();
+
+    return count;
+}
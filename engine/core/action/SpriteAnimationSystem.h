@@ -0,0 +1,46 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef SPRITEANIMATIONSYSTEM_H
+#define SPRITEANIMATIONSYSTEM_H
+
+#include <vector>
+#include <stddef.h>
+
+namespace Supernova {
+
+    class SpriteAnimation;
+
+    //Running sprite animations of a scene, time is advanced for all in one pass
+    //and animation memory is only touched when a frame changes
+    class SpriteAnimationSystem {
+    private:
+        std::vector<SpriteAnimation*> animations;
+
+        std::vector<float> timecounts;
+        std::vector<float> elapsedTimes;
+        std::vector<float> nextTimes;
+
+        //Removed animations are set to NULL here, so later callbacks skip them
+        std::vector<SpriteAnimation*> callbackAnimations;
+        std::vector<unsigned char> callbackFinished;
+
+    public:
+        SpriteAnimationSystem();
+        virtual ~SpriteAnimationSystem();
+
+        bool add(SpriteAnimation* animation);
+        //Animation state is copied back from arrays
+        void remove(SpriteAnimation* animation);
+        void clear();
+
+        size_t size() const;
+
+        //Returns number of updated animations
+        size_t update(float interval);
+    };
+
+}
+
+#endif //SPRITEANIMATIONSYSTEM_H
@@ -3,6 +3,8 @@
 #include "Engine.h"
 #include "Object.h"
 #include "Log.h"
+#include "TweenSystem.h"
+#include "Scene.h"
 #include <math.h>
 
 #include <stdio.h>
@@ -15,6 +17,10 @@ TimeAction::TimeAction(): Action(), Ease(){
     this->loop = false;
     this->time = 0;
     this->value = 0;
+    this->tweenSystem = NULL;
+    this->tweenProperty = 0;
+    this->tweenIndex = 0;
+    this->tweenCallback = -1;
 }
 
 TimeAction::TimeAction(float duration, bool loop): Action(), Ease(){
@@ -22,20 +28,29 @@ TimeAction::TimeAction(float duration, bool loop): Action(), Ease(){
     this->loop = loop;
     this->time = 0;
     this->value = 0;
+    this->tweenSystem = NULL;
+    this->tweenProperty = 0;
+    this->tweenIndex = 0;
+    this->tweenCallback = -1;
 }
 
 TimeAction::TimeAction(float duration, bool loop, float (*function)(float)): Action(), Ease(){
     this->function = function;
+    this->functionType = Ease::findFunctionType(function);
 
     this->duration = duration;
     this->loop = loop;
     this->time = 0;
     this->value = 0;
+    this->tweenSystem = NULL;
+    this->tweenProperty = 0;
+    this->tweenIndex = 0;
+    this->tweenCallback = -1;
 }
 
 
 TimeAction::~TimeAction(){
-
+    unschedule();
 }
 
 float TimeAction::getDuration(){
@@ -43,7 +58,8 @@ float TimeAction::getDuration(){
 };
 
 void TimeAction::setDuration(float duration){
-     this->duration = duration;
+    unschedule();
+    this->duration = duration;
 }
 
 bool TimeAction::isLoop(){
@@ -51,26 +67,52 @@ bool TimeAction::isLoop(){
 }
 
 void TimeAction::setLoop(bool loop){
+    unschedule();
     this->loop = loop;
 }
 
 float TimeAction::getTime(){
+    if (tweenSystem)
+        tweenSystem->sync(this);
+
     return time;
 }
 
 float TimeAction::getValue(){
+    if (tweenSystem)
+        tweenSystem->sync(this);
+
     return value;
 }
 
+void TimeAction::setFunction(std::function<float(float)> function){
+    unschedule();
+    Ease::setFunction(function);
+}
+
+int TimeAction::setFunction(lua_State* L){
+    unschedule();
+    return Ease::setFunction(L);
+}
+
+void TimeAction::setFunctionType(int functionType){
+    unschedule();
+    Ease::setFunctionType(functionType);
+}
+
 bool TimeAction::run(){
+    unschedule();
     return Action::run();
 }
 
 bool TimeAction::pause(){
+    unschedule();
     return Action::pause();
 }
 
 bool TimeAction::stop(){
+    unschedule();
+
     if (!Action::stop())
         return false;
 
@@ -108,3 +150,15 @@ bool TimeAction::update(float interval){
     
     return true;
 }
+
+bool TimeAction::addTween(Scene* scene, int property, const float* start, const float* end){
+    if (!scene || !scene->batchedTweens || !running)
+        return false;
+
+    return scene->tweenSystem.add(this, property, start, end);
+}
+
+void TimeAction::unschedule(){
+    if (tweenSystem)
+        tweenSystem->remove(this);
+}
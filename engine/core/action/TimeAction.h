@@ -7,8 +7,11 @@
 namespace Supernova{
     
     class Object;
+    class TweenSystem;
     
     class TimeAction: public Action, public Ease{
+
+        friend class TweenSystem;
         
     protected:
         
@@ -17,6 +20,15 @@ namespace Supernova{
         
         float time;
         float value;
+
+        //Set while scheduled, index changes when other tweens are removed
+        TweenSystem* tweenSystem;
+        int tweenProperty;
+        size_t tweenIndex;
+        //Position in tween system callbacks of current update, -1 when not waiting
+        int tweenCallback;
+
+        bool addTween(Scene* scene, int property, const float* start, const float* end);
         
     public:
         TimeAction();
@@ -32,12 +44,18 @@ namespace Supernova{
 
         float getTime();
         float getValue();
+
+        void setFunction(std::function<float(float)> function);
+        int setFunction(lua_State* L);
+        void setFunctionType(int functionType);
         
         virtual bool run();
         virtual bool pause();
         virtual bool stop();
         
         virtual bool update(float interval);
+
+        virtual void unschedule();
     };
 }
 
@@ -0,0 +1,274 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "TweenSystem.h"
+#include "TimeAction.h"
+#include "Object.h"
+#include "GraphicObject.h"
+#include "Log.h"
+
+using namespace Supernova;
+
+TweenSystem::TweenSystem(){
+    for (int p = 0; p < S_TWEEN_PROPERTIES; p++){
+        tweens[p].components = getComponents(p);
+    }
+}
+
+TweenSystem::~TweenSystem(){
+    clear();
+}
+
+int TweenSystem::getComponents(int property){
+    if (property == S_TWEEN_ROTATION || property == S_TWEEN_COLOR)
+        return 4;
+    if (property == S_TWEEN_ALPHA)
+        return 1;
+
+    return 3;
+}
+
+bool TweenSystem::add(TimeAction* action, int property, const float* start, const float* end){
+    if (property < 0 || property >= S_TWEEN_PROPERTIES){
+        Log::Error("Invalid tween property %i", property);
+        return false;
+    }
+
+    if (action->scheduled || !action->object || action->functionType < 0)
+        return false;
+
+    Tweens& t = tweens[property];
+
+    action->scheduled = true;
+    action->tweenSystem = this;
+    action->tweenProperty = property;
+    action->tweenIndex = t.actions.size();
+
+    t.actions.push_back(action);
+    t.objects.push_back(action->object);
+    t.timecounts.push_back(action->timecount);
+    t.durations.push_back(action->duration);
+    t.times.push_back(action->time);
+    t.values.push_back(action->value);
+    t.loops.push_back(action->loop);
+    t.functionTypes.push_back((unsigned char)action->functionType);
+    t.finished.push_back(0);
+
+    for (int c = 0; c < t.components; c++){
+        t.starts.push_back(start[c]);
+        t.ends.push_back(end[c]);
+    }
+
+    return true;
+}
+
+void TweenSystem::remove(TimeAction* action){
+    if (!action->scheduled || action->tweenSystem != this)
+        return;
+
+    sync(action);
+
+    Tweens& t = tweens[action->tweenProperty];
+    size_t index = action->tweenIndex;
+    size_t last = t.actions.size() - 1;
+
+    //Last tween is moved to removed place to keep arrays contiguous
+    if (index != last){
+        t.actions[index] = t.actions[last];
+        t.objects[index] = t.objects[last];
+        t.timecounts[index] = t.timecounts[last];
+        t.durations[index] = t.durations[last];
+        t.times[index] = t.times[last];
+        t.values[index] = t.values[last];
+        t.loops[index] = t.loops[last];
+        t.functionTypes[index] = t.functionTypes[last];
+        t.finished[index] = t.finished[last];
+
+        for (int c = 0; c < t.components; c++){
+            t.starts[index * t.components + c] = t.starts[last * t.components + c];
+            t.ends[index * t.components + c] = t.ends[last * t.components + c];
+        }
+
+        t.actions[index]->tweenIndex = index;
+    }
+
+    t.actions.pop_back();
+    t.objects.pop_back();
+    t.timecounts.pop_back();
+    t.durations.pop_back();
+    t.times.pop_back();
+    t.values.pop_back();
+    t.loops.pop_back();
+    t.functionTypes.pop_back();
+    t.finished.pop_back();
+    t.starts.resize(last * t.components);
+    t.ends.resize(last * t.components);
+
+    if (action->tweenCallback >= 0){
+        callbackActions[action->tweenCallback] = NULL;
+        action->tweenCallback = -1;
+    }
+
+    action->scheduled = false;
+    action->tweenSystem = NULL;
+}
+
+void TweenSystem::sync(TimeAction* action){
+    if (!action->scheduled || action->tweenSystem != this)
+        return;
+
+    Tweens& t = tweens[action->tweenProperty];
+    size_t index = action->tweenIndex;
+
+    action->timecount = t.timecounts[index];
+    action->time = t.times[index];
+    action->value = t.values[index];
+}
+
+void TweenSystem::clear(){
+    for (int p = 0; p < S_TWEEN_PROPERTIES; p++){
+        while (tweens[p].actions.size() > 0)
+            remove(tweens[p].actions.back());
+    }
+}
+
+size_t TweenSystem::size() const{
+    size_t count = 0;
+    for (int p = 0; p < S_TWEEN_PROPERTIES; p++){
+        count += tweens[p].actions.size();
+    }
+
+    return count;
+}
+
+void TweenSystem::apply(int property){
+    Tweens& t = tweens[property];
+    size_t count = t.actions.size();
+    int n = t.components;
+
+    const float* starts = t.starts.data();
+    const float* ends = t.ends.data();
+
+    for (size_t i = 0; i < count; i++){
+        if (t.finished[i])
+            continue;
+
+        const float* s = &starts[i * n];
+        const float* e = &ends[i * n];
+        float value = t.values[i];
+
+        if (property == S_TWEEN_POSITION){
+            t.objects[i]->setPosition(Vector3(
+                    s[0] + (e[0] - s[0]) * value,
+                    s[1] + (e[1] - s[1]) * value,
+                    s[2] + (e[2] - s[2]) * value));
+        }else if (property == S_TWEEN_SCALE){
+            t.objects[i]->setScale(Vector3(
+                    s[0] + (e[0] - s[0]) * value,
+                    s[1] + (e[1] - s[1]) * value,
+                    s[2] + (e[2] - s[2]) * value));
+        }else if (property == S_TWEEN_ROTATION){
+            Quaternion rotation;
+            t.objects[i]->setRotation(rotation.slerp(value, Quaternion(s[0], s[1], s[2], s[3]), Quaternion(e[0], e[1], e[2], e[3])));
+        }else{
+            //Only GraphicObject tweens are added to color properties
+            GraphicObject* cObject = (GraphicObject*)t.objects[i];
+            Vector4 color = cObject->getColor();
+
+            if (property == S_TWEEN_COLOR){
+                color = Vector4(
+                        s[0] + (e[0] - s[0]) * value,
+                        s[1] + (e[1] - s[1]) * value,
+                        s[2] + (e[2] - s[2]) * value,
+                        s[3] + (e[3] - s[3]) * value);
+            }else if (property == S_TWEEN_COLOR_RGB){
+                color = Vector4(
+                        s[0] + (e[0] - s[0]) * value,
+                        s[1] + (e[1] - s[1]) * value,
+                        s[2] + (e[2] - s[2]) * value,
+                        color.w);
+            }else if (property == S_TWEEN_ALPHA){
+                color.w = s[0] + (e[0] - s[0]) * value;
+            }
+
+            cObject->setColor(color);
+        }
+    }
+}
+
+size_t TweenSystem::update(float interval){
+    size_t count = 0;
+
+    for (int p = 0; p < S_TWEEN_PROPERTIES; p++){
+        Tweens& t = tweens[p];
+        size_t size = t.actions.size();
+
+        if (size == 0)
+            continue;
+
+        //Same steps of TimeAction::update for all tweens of property
+        for (size_t i = 0; i < size; i++){
+            t.timecounts[i] += interval;
+
+            t.finished[i] = (t.times[i] == 1) && !t.loops[i];
+            if (t.finished[i])
+                continue;
+
+            float duration = t.durations[i];
+            if (duration >= 0){
+                if (t.timecounts[i] >= duration){
+                    if (!t.loops[i]){
+                        t.timecounts[i] = duration;
+                    }else{
+                        t.timecounts[i] -= duration;
+                    }
+                }
+
+                t.times[i] = t.timecounts[i] / duration;
+            }
+
+            t.values[i] = Ease::getFunction(t.functionTypes[i])(t.times[i]);
+        }
+
+        apply(p);
+
+        //Functions can be subscribed after tween was added
+        for (size_t i = 0; i < size; i++){
+            if (t.finished[i] || t.actions[i]->onUpdate.size() > 0){
+                t.actions[i]->tweenCallback = (int)callbackActions.size();
+                callbackActions.push_back(t.actions[i]);
+                callbackFinished.push_back(t.finished[i]);
+            }
+        }
+
+        count += size;
+    }
+
+    for (size_t i = 0; i < callbackActions.size(); i++){
+        TimeAction* action = callbackActions[i];
+
+        //Removed by a previous callback, it can be deleted
+        if (!action)
+            continue;
+
+        action->onUpdate.call(action->object, interval);
+
+        if (!callbackActions[i])
+            continue;
+
+        callbackActions[i] = NULL;
+        action->tweenCallback = -1;
+
+        if (callbackFinished[i]){
+            action->unschedule();
+            action->stop();
+            action->onFinish.call(action->object);
+        }
+    }
+
+    callbackActions.clear();
+    callbackFinished.clear();
+
+    return count;
+}
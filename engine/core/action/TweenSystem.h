@@ -0,0 +1,77 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef TWEENSYSTEM_H
+#define TWEENSYSTEM_H
+
+#include <vector>
+#include <stddef.h>
+
+#define S_TWEEN_POSITION 0
+#define S_TWEEN_SCALE 1
+#define S_TWEEN_ROTATION 2
+#define S_TWEEN_COLOR 3
+#define S_TWEEN_COLOR_RGB 4
+#define S_TWEEN_ALPHA 5
+
+#define S_TWEEN_PROPERTIES 6
+
+namespace Supernova {
+
+    class Object;
+    class TimeAction;
+
+    //Running tweens of a scene in contiguous arrays by property, advanced in one pass per frame
+    class TweenSystem {
+    private:
+        struct Tweens{
+            int components;
+
+            std::vector<TimeAction*> actions;
+            std::vector<Object*> objects;
+
+            std::vector<float> timecounts;
+            std::vector<float> durations;
+            std::vector<float> times;
+            std::vector<float> values;
+            std::vector<unsigned char> loops;
+            std::vector<unsigned char> functionTypes;
+            std::vector<unsigned char> finished;
+
+            //components values for each tween
+            std::vector<float> starts;
+            std::vector<float> ends;
+        };
+
+        Tweens tweens[S_TWEEN_PROPERTIES];
+
+        //Callbacks run after all tweens are written, they can stop, remove or delete tweens.
+        //Removed actions are set to NULL here, so later callbacks skip them
+        std::vector<TimeAction*> callbackActions;
+        std::vector<unsigned char> callbackFinished;
+
+        void apply(int property);
+
+    public:
+        TweenSystem();
+        virtual ~TweenSystem();
+
+        static int getComponents(int property);
+
+        //Action state is copied to arrays, start and end have property components
+        bool add(TimeAction* action, int property, const float* start, const float* end);
+        //Action state is copied back from arrays
+        void remove(TimeAction* action);
+        void sync(TimeAction* action);
+        void clear();
+
+        size_t size() const;
+
+        //Returns number of updated tweens
+        size_t update(float interval);
+    };
+
+}
+
+#endif //TWEENSYSTEM_H
@@ -0,0 +1,139 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "KeyframeCompression.h"
+#include <cmath>
+#include <algorithm>
+
+using namespace Supernova;
+
+//Components other than largest are between -1/sqrt(2) and 1/sqrt(2)
+static const float quaternionLimit = 0.70710678f;
+
+std::vector<size_t> KeyframeCompression::reduceKeys(const std::vector<float>& times, float tolerance, std::function<float(size_t, size_t, size_t)> error){
+    std::vector<size_t> kept;
+    size_t count = times.size();
+
+    if (count <= 2){
+        for (size_t i = 0; i < count; i++)
+            kept.push_back(i);
+        return kept;
+    }
+
+    kept.push_back(0);
+
+    //Extends segment from last kept key while all keys inside it can be interpolated
+    size_t start = 0;
+    for (size_t end = 2; end < count; end++){
+        for (size_t k = start + 1; k < end; k++){
+            if (error(start, end, k) > tolerance){
+                kept.push_back(end - 1);
+                start = end - 1;
+                break;
+            }
+        }
+    }
+
+    kept.push_back(count - 1);
+
+    return kept;
+}
+
+void KeyframeCompression::packQuaternion(Quaternion q, uint16_t* packed){
+    q.normalise();
+
+    float components[4] = {q.w, q.x, q.y, q.z};
+
+    int largest = 0;
+    for (int i = 1; i < 4; i++){
+        if (std::fabs(components[i]) > std::fabs(components[largest]))
+            largest = i;
+    }
+
+    //q and -q are same rotation, so largest is always positive
+    float sign = (components[largest] < 0) ? -1.0f : 1.0f;
+
+    int k = 0;
+    for (int i = 0; i < 4; i++){
+        if (i == largest)
+            continue;
+
+        float value = (components[i] * sign + quaternionLimit) / (2 * quaternionLimit);
+        value = std::max(0.0f, std::min(1.0f, value));
+
+        packed[k] = (uint16_t)std::lround(value * 32767.0f);
+        k++;
+    }
+
+    packed[0] |= (uint16_t)((largest & 1) << 15);
+    packed[1] |= (uint16_t)((largest >> 1) << 15);
+}
+
+Quaternion KeyframeCompression::unpackQuaternion(const uint16_t* packed){
+    int largest = (packed[0] >> 15) | ((packed[1] >> 15) << 1);
+
+    float components[4];
+    float sum = 0;
+
+    int k = 0;
+    for (int i = 0; i < 4; i++){
+        if (i == largest)
+            continue;
+
+        float value = (packed[k] & 0x7FFF) / 32767.0f;
+        components[i] = value * (2 * quaternionLimit) - quaternionLimit;
+        sum += components[i] * components[i];
+        k++;
+    }
+
+    components[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+
+    return Quaternion(components[0], components[1], components[2], components[3]);
+}
+
+void KeyframeCompression::packVector3(const Vector3& v, const Vector3& minimum, const Vector3& range, uint16_t* packed){
+    for (int i = 0; i < 3; i++){
+        float value = 0;
+        if (range[i] > 0)
+            value = std::max(0.0f, std::min(1.0f, (v[i] - minimum[i]) / range[i]));
+
+        packed[i] = (uint16_t)std::lround(value * 65535.0f);
+    }
+}
+
+Vector3 KeyframeCompression::unpackVector3(const uint16_t* packed, const Vector3& minimum, const Vector3& range){
+    return Vector3(
+            minimum.x + (packed[0] / 65535.0f) * range.x,
+            minimum.y + (packed[1] / 65535.0f) * range.y,
+            minimum.z + (packed[2] / 65535.0f) * range.z);
+}
+
+void KeyframeCompression::getRange(const std::vector<Vector3>& values, Vector3& minimum, Vector3& range){
+    if (values.size() == 0){
+        minimum = Vector3(0, 0, 0);
+        range = Vector3(0, 0, 0);
+        return;
+    }
+
+    Vector3 maximum = values[0];
+    minimum = values[0];
+
+    for (size_t i = 1; i < values.size(); i++){
+        for (int c = 0; c < 3; c++){
+            minimum[c] = std::min(minimum[c], values[i][c]);
+            maximum[c] = std::max(maximum[c], values[i][c]);
+        }
+    }
+
+    range = maximum - minimum;
+}
+
+float KeyframeCompression::getQuaternionAngle(Quaternion q1, Quaternion q2){
+    q1.normalise();
+    q2.normalise();
+
+    float dot = std::min(1.0f, std::fabs(q1.dot(q2)));
+
+    return 2 * std::acos(dot);
+}
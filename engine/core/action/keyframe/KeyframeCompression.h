@@ -0,0 +1,37 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef KEYFRAMECOMPRESSION_H
+#define KEYFRAMECOMPRESSION_H
+
+#include "math/Vector3.h"
+#include "math/Quaternion.h"
+#include <vector>
+#include <functional>
+#include <stdint.h>
+
+namespace Supernova {
+
+    //Import time helpers, unpack functions are used while sampling
+    class KeyframeCompression {
+    public:
+        //Keys kept when removed keys are interpolated from kept neighbors within tolerance,
+        //error(previous, next, key) returns difference of key to interpolation of previous and next
+        static std::vector<size_t> reduceKeys(const std::vector<float>& times, float tolerance, std::function<float(size_t, size_t, size_t)> error);
+
+        //Smallest three: 2 bits for largest component, 15 bits for each other, 48 bits total
+        static void packQuaternion(Quaternion q, uint16_t* packed);
+        static Quaternion unpackQuaternion(const uint16_t* packed);
+
+        //16 bits for each component inside minimum and range of clip values
+        static void packVector3(const Vector3& v, const Vector3& minimum, const Vector3& range, uint16_t* packed);
+        static Vector3 unpackVector3(const uint16_t* packed, const Vector3& minimum, const Vector3& range);
+        static void getRange(const std::vector<Vector3>& values, Vector3& minimum, Vector3& range);
+
+        static float getQuaternionAngle(Quaternion q1, Quaternion q2);
+    };
+
+}
+
+#endif //KEYFRAMECOMPRESSION_H
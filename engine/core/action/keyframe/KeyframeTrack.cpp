@@ -4,33 +4,83 @@
 
 #include "KeyframeTrack.h"
 #include "Log.h"
+#include <algorithm>
 
 using namespace Supernova;
 
 KeyframeTrack::KeyframeTrack(): TimeAction(){
     this->index = 0;
+    this->nextIndex = 0;
     this->progress = 0;
+    this->pose = NULL;
+    this->joint = -1;
+    this->compressed = false;
 }
 
 KeyframeTrack::KeyframeTrack(std::vector<float> times): TimeAction(){
     setTimes(times);
     this->index = 0;
+    this->nextIndex = 0;
     this->progress = 0;
+    this->pose = NULL;
+    this->joint = -1;
+    this->compressed = false;
 }
 
 void KeyframeTrack::setTimes(std::vector<float> times){
     this->times = times;
+    this->index = 0;
+    this->nextIndex = 0;
+    this->progress = 0;
 }
 
-std::vector<float> KeyframeTrack::getTimes(){
+const std::vector<float>& KeyframeTrack::getTimes() const{
     return times;
 }
 
+void KeyframeTrack::setPoseTarget(Pose* pose, int joint){
+    this->pose = pose;
+    this->joint = joint;
+}
+
+Pose* KeyframeTrack::getPoseTarget(){
+    return pose;
+}
+
+int KeyframeTrack::getJointTarget(){
+    return joint;
+}
+
+void KeyframeTrack::compress(float){
+    //Only tracks with values can be compressed
+}
+
+bool KeyframeTrack::isCompressed(){
+    return compressed;
+}
+
+void KeyframeTrack::keepTimes(const std::vector<size_t>& keys){
+    std::vector<float> keptTimes(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+        keptTimes[i] = times[keys[i]];
+
+    times.swap(keptTimes);
+    index = 0;
+}
+
+int KeyframeTrack::findIndex(float time){
+    int last = (int)times.size() - 2;
+    int found = (int)(std::upper_bound(times.begin(), times.end(), time) - times.begin()) - 1;
+
+    return std::max(0, std::min(found, last));
+}
+
 bool KeyframeTrack::stop(){
     if (!TimeAction::stop())
         return false;
 
     index = 0;
+    nextIndex = 0;
     progress = 0;
 
     return true;
@@ -43,18 +93,38 @@ bool KeyframeTrack::update(float interval){
     if (times.size() == 0)
         return false;
 
-    float actualTime = duration * value;
-
-    if (actualTime < times[0]) {
+    //Constant channel, only first value is used
+    if (times.size() == 1){
         index = 0;
+        nextIndex = 0;
         progress = 0;
         return true;
     }
 
-    index = 0;
-    while ((index+1) < times.size() && times[index+1] < actualTime){
-        index++;
+    float actualTime = duration * value;
+    int last = (int)times.size() - 2;
+
+    if (index > last)
+        index = last;
+
+    //Forward playback stays in same or next keyframe, seeks and loops use binary search
+    if (actualTime < times[index]) {
+        index = findIndex(actualTime);
+    } else if (index < last && actualTime >= times[index+1]) {
+        if (index+1 == last || actualTime < times[index+2]) {
+            index++;
+        } else {
+            index = findIndex(actualTime);
+        }
     }
 
+    nextIndex = index+1;
+
+    float keyDuration = times[nextIndex] - times[index];
+    if (keyDuration > 0)
+        progress = std::max(0.0f, std::min(1.0f, (actualTime - times[index]) / keyDuration));
+    else
+        progress = 0;
+
     return true;
 }
@@ -6,22 +6,47 @@
 #define KEYFRAMETRACK_H
 
 #include "action/TimeAction.h"
+#include <stdint.h>
 
 namespace Supernova {
 
+    class Pose;
+
     class KeyframeTrack: public TimeAction {
 
     protected:
         std::vector<float> times;
+        //Keyframe before actual time, kept between updates as a playhead cursor
         int index;
+        //Keyframe after actual time, same as index in single key tracks
+        int nextIndex;
+        //Interpolation between index and nextIndex
         float progress;
 
+        //When set, values are written in pose joint instead of object
+        Pose* pose;
+        int joint;
+
+        //Values are quantized and no keyframe can be added
+        bool compressed;
+
+        int findIndex(float time);
+        void keepTimes(const std::vector<size_t>& keys);
+
     public:
         KeyframeTrack();
         KeyframeTrack(std::vector<float> times);
 
         void setTimes(std::vector<float> times);
-        std::vector<float> getTimes();
+        const std::vector<float>& getTimes() const;
+
+        void setPoseTarget(Pose* pose, int joint);
+        Pose* getPoseTarget();
+        int getJointTarget();
+
+        //Removes keys interpolated within tolerance and quantizes values
+        virtual void compress(float tolerance);
+        bool isCompressed();
 
         virtual bool stop();
 
@@ -30,13 +30,13 @@ bool MorphTracks::update(float interval){
         return false;
 
     if (Model* model = dynamic_cast<Model*>(object)){
-        if (values[index].size() == values[index+1].size()) {
+        if (values[index].size() == values[nextIndex].size()) {
             for (int morphIndex = 0; morphIndex < values[index].size(); morphIndex++) {
-                float weight = (values[index + 1][morphIndex] - values[index][morphIndex]) * progress;
+                float weight = (values[nextIndex][morphIndex] - values[index][morphIndex]) * progress;
                 model->setMorphWeight(morphIndex, values[index][morphIndex] + weight);
             }
         }else{
-            Log::Error("MorphTrack of index %i is different size than index %i", index, index+1);
+            Log::Error("MorphTrack of index %i is different size than index %i", index, nextIndex);
         }
     }
 
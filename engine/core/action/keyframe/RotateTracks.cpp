@@ -4,6 +4,9 @@
 
 #include "RotateTracks.h"
 #include "Object.h"
+#include "util/Pose.h"
+#include "Log.h"
+#include "KeyframeCompression.h"
 
 using namespace Supernova;
 
@@ -11,7 +14,7 @@ using namespace Supernova;
 RotateTracks::RotateTracks(){
 }
 
-RotateTracks::RotateTracks(std::vector<float> times, std::vector<Quaternion> values){
+RotateTracks::RotateTracks(std::vector<float> times, std::vector<Quaternion> values): KeyframeTrack(times){
     setValues(values);
 }
 
@@ -20,17 +23,55 @@ void RotateTracks::setValues(std::vector<Quaternion> values){
 }
 
 void RotateTracks::addKeyframe(float time, Quaternion value){
+    if (compressed){
+        Log::Error("Cannot add keyframe to compressed track");
+        return;
+    }
+
     times.push_back(time);
     values.push_back(value);
 }
 
+void RotateTracks::compress(float tolerance){
+    if (compressed || times.size() != values.size())
+        return;
+
+    std::vector<size_t> keys = KeyframeCompression::reduceKeys(times, tolerance, [this](size_t previous, size_t next, size_t key){
+        float duration = times[next] - times[previous];
+        float t = (duration > 0) ? (times[key] - times[previous]) / duration : 0;
+        Quaternion interpolated = Quaternion().slerp(t, values[previous], values[next]);
+        return KeyframeCompression::getQuaternionAngle(interpolated, values[key]);
+    });
+
+    packedValues.resize(keys.size() * 3);
+    for (size_t i = 0; i < keys.size(); i++)
+        KeyframeCompression::packQuaternion(values[keys[i]], &packedValues[i * 3]);
+    keepTimes(keys);
+
+    values.clear();
+    values.shrink_to_fit();
+
+    compressed = true;
+}
+
+Quaternion RotateTracks::getValue(int key){
+    if (compressed)
+        return KeyframeCompression::unpackQuaternion(&packedValues[key * 3]);
+
+    return values[key];
+}
+
 bool RotateTracks::update(float interval){
     if (!KeyframeTrack::update(interval))
         return false;
 
-    if (object){
-        object->setRotation(object->getRotation().slerp(progress, values[index], values[index+1]));
+    Quaternion value = Quaternion().slerp(progress, getValue(index), getValue(nextIndex));
+
+    if (pose){
+        pose->setRotation(joint, value);
+    }else if (object){
+        object->setRotation(value);
     }
 
     return true;
-}
\ No newline at end of file
+}
@@ -15,6 +15,11 @@ namespace Supernova {
     protected:
         std::vector<Quaternion> values;
 
+        //After compress, smallest three quaternion in 3 values of 16 bits for each key
+        std::vector<uint16_t> packedValues;
+
+        Quaternion getValue(int key);
+
     public:
         RotateTracks();
         RotateTracks(std::vector<float> times, std::vector<Quaternion> values);
@@ -23,6 +28,9 @@ namespace Supernova {
 
         void addKeyframe(float time, Quaternion value);
 
+        //Tolerance is angle in radians
+        virtual void compress(float tolerance);
+
         virtual bool update(float interval);
     };
 
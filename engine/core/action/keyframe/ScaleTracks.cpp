@@ -4,7 +4,9 @@
 
 #include "ScaleTracks.h"
 #include "Object.h"
+#include "util/Pose.h"
 #include "Log.h"
+#include "KeyframeCompression.h"
 
 using namespace Supernova;
 
@@ -20,17 +22,61 @@ void ScaleTracks::setValues(std::vector<Vector3> values){
 }
 
 void ScaleTracks::addKeyframe(float time, Vector3 value){
+    if (compressed){
+        Log::Error("Cannot add keyframe to compressed track");
+        return;
+    }
+
     times.push_back(time);
     values.push_back(value);
 }
 
+void ScaleTracks::compress(float tolerance){
+    if (compressed || times.size() != values.size())
+        return;
+
+    std::vector<size_t> keys = KeyframeCompression::reduceKeys(times, tolerance, [this](size_t previous, size_t next, size_t key){
+        float duration = times[next] - times[previous];
+        float t = (duration > 0) ? (times[key] - times[previous]) / duration : 0;
+        Vector3 interpolated = values[previous] + (values[next] - values[previous]) * t;
+        return interpolated.distance(values[key]);
+    });
+
+    std::vector<Vector3> keptValues(keys.size());
+    for (size_t i = 0; i < keys.size(); i++)
+        keptValues[i] = values[keys[i]];
+    keepTimes(keys);
+
+    KeyframeCompression::getRange(keptValues, packedMinimum, packedRange);
+
+    packedValues.resize(keptValues.size() * 3);
+    for (size_t i = 0; i < keptValues.size(); i++)
+        KeyframeCompression::packVector3(keptValues[i], packedMinimum, packedRange, &packedValues[i * 3]);
+
+    values.clear();
+    values.shrink_to_fit();
+
+    compressed = true;
+}
+
+Vector3 ScaleTracks::getValue(int key){
+    if (compressed)
+        return KeyframeCompression::unpackVector3(&packedValues[key * 3], packedMinimum, packedRange);
+
+    return values[key];
+}
+
 bool ScaleTracks::update(float interval){
     if (!KeyframeTrack::update(interval))
         return false;
 
-    if (object){
-        Vector3 scale = (values[index+1] - values[index]) * progress;
-        object->setScale(values[index] + scale);
+    Vector3 previous = getValue(index);
+    Vector3 value = previous + (getValue(nextIndex) - previous) * progress;
+
+    if (pose){
+        pose->setScale(joint, value);
+    }else if (object){
+        object->setScale(value);
     }
 
     return true;
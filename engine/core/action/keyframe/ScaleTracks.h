@@ -15,6 +15,13 @@ namespace Supernova {
     protected:
         std::vector<Vector3> values;
 
+        //After compress, 3 values of 16 bits for each key inside clip range
+        std::vector<uint16_t> packedValues;
+        Vector3 packedMinimum;
+        Vector3 packedRange;
+
+        Vector3 getValue(int key);
+
     public:
         ScaleTracks();
         ScaleTracks(std::vector<float> times, std::vector<Vector3> values);
@@ -23,6 +30,8 @@ namespace Supernova {
 
         void addKeyframe(float time, Vector3 value);
 
+        virtual void compress(float tolerance);
+
         virtual bool update(float interval);
     };
 
@@ -8,4 +8,10 @@ ParticleInit::ParticleInit(){
 
 ParticleInit::~ParticleInit(){
 
-}
\ No newline at end of file
+}
+
+void ParticleInit::executeRange(Particles* particles, int first, int last){
+    for (int i = first; i < last; i++){
+        execute(particles, i);
+    }
+}
@@ -13,6 +13,8 @@ namespace Supernova {
         virtual ~ParticleInit();
 
         virtual void execute(Particles* particles, int particle) = 0;
+        //Particles in [first, last), default calls execute for each one
+        virtual void executeRange(Particles* particles, int first, int last);
     };
 
 }
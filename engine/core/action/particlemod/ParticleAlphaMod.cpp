@@ -55,4 +55,16 @@ void ParticleAlphaMod::execute(Particles* particles, int particle, float life) {
 
         particles->setParticleColor(particle, color);
     }
+}
+
+void ParticleAlphaMod::executeRange(Particles* particles, int first, int last) {
+    computeValues(particles, first, last);
+
+    float* colors = particles->getColorsData();
+
+    for (int i = first; i < last; i++){
+        float value = values[i - first];
+        if (value >= 0 && value <= 1)
+            colors[i*4+3] = fromAlpha + ((toAlpha - fromAlpha) * value);
+    }
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ namespace Supernova {
         float getToAlpha();
 
         virtual void execute(Particles* particles, int particle, float life);
+        virtual void executeRange(Particles* particles, int first, int last);
     };
 
 }
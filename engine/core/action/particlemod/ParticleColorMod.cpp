@@ -66,4 +66,22 @@ void ParticleColorMod::execute(Particles* particles, int particle, float life) {
         }
         particles->setParticleColor(particle, color);
     }
+}
+
+void ParticleColorMod::executeRange(Particles* particles, int first, int last) {
+    computeValues(particles, first, last);
+
+    float* colors = particles->getColorsData();
+
+    for (int i = first; i < last; i++){
+        float value = values[i - first];
+        if (value >= 0 && value <= 1){
+            Vector4 color = fromColor + ((toColor - fromColor) * value);
+            colors[i*4] = color.x;
+            colors[i*4+1] = color.y;
+            colors[i*4+2] = color.z;
+            if (useAlpha)
+                colors[i*4+3] = color.w;
+        }
+    }
 }
\ No newline at end of file
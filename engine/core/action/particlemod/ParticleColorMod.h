@@ -31,6 +31,7 @@ namespace Supernova {
         Vector4 getToColor();
 
         virtual void execute(Particles* particles, int particle, float life);
+        virtual void executeRange(Particles* particles, int first, int last);
     };
 
 }
@@ -31,3 +31,30 @@ void ParticleMod::execute(Particles* particles, int particle, float life){
 
     value = function.call(time);
 }
+
+void ParticleMod::computeValues(Particles* particles, int first, int last){
+    float* lifes = particles->getLifesData();
+    EaseFunction easeFunction = (functionType >= 0) ? getFunction(functionType) : NULL;
+
+    values.resize(last - first);
+
+    for (int i = first; i < last; i++){
+        float life = lifes[i];
+        float time;
+        if ((fromLife != toLife) && (life <= fromLife) && (life >= toLife)) {
+            time = (life - fromLife) / (toLife - fromLife);
+        }else{
+            time = -1;
+        }
+
+        values[i - first] = easeFunction ? easeFunction(time) : function.call(time);
+    }
+}
+
+void ParticleMod::executeRange(Particles* particles, int first, int last){
+    float* lifes = particles->getLifesData();
+
+    for (int i = first; i < last; i++){
+        execute(particles, i, lifes[i]);
+    }
+}
@@ -13,6 +13,10 @@ namespace Supernova {
         float toLife;
 
         float value;
+        //Ease values of a range, values[0] is first particle
+        std::vector<float> values;
+
+        void computeValues(Particles* particles, int first, int last);
 
     public:
         ParticleMod();
@@ -20,6 +24,8 @@ namespace Supernova {
         virtual ~ParticleMod();
 
         virtual void execute(Particles* particles, int particle, float life);
+        //Particles in [first, last), default calls execute for each one
+        virtual void executeRange(Particles* particles, int first, int last);
     };
 
 }
@@ -51,4 +51,20 @@ void ParticlePositionMod::execute(Particles* particles, int particle, float life
         Vector3 position = fromPosition + ((toPosition - fromPosition) * value);
         particles->setParticlePosition(particle, position);
     }
+}
+
+void ParticlePositionMod::executeRange(Particles* particles, int first, int last) {
+    computeValues(particles, first, last);
+
+    float* positions = particles->getPositionsData();
+
+    for (int i = first; i < last; i++){
+        float value = values[i - first];
+        if (value >= 0 && value <= 1){
+            Vector3 position = fromPosition + ((toPosition - fromPosition) * value);
+            positions[i*3] = position.x;
+            positions[i*3+1] = position.y;
+            positions[i*3+2] = position.z;
+        }
+    }
 }
\ No newline at end of file
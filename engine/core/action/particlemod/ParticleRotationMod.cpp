@@ -1,4 +1,5 @@
 #include "ParticleRotationMod.h"
+#include "math/Angle.h"
 
 using namespace Supernova;
 
@@ -52,4 +53,16 @@ void ParticleRotationMod::execute(Particles* particles, int particle, float life
 
         particles->setParticleRotation(particle, rotation);
     }
+}
+
+void ParticleRotationMod::executeRange(Particles* particles, int first, int last) {
+    computeValues(particles, first, last);
+
+    float* rotations = particles->getRotationsData();
+
+    for (int i = first; i < last; i++){
+        float value = values[i - first];
+        if (value >= 0 && value <= 1)
+            rotations[i] = Angle::defaultToRad(fromRotation + ((toRotation - fromRotation) * value));
+    }
 }
\ No newline at end of file
@@ -52,4 +52,16 @@ void ParticleSizeMod::execute(Particles* particles, int particle, float life) {
 
         particles->setParticleSize(particle, size);
     }
+}
+
+void ParticleSizeMod::executeRange(Particles* particles, int first, int last) {
+    computeValues(particles, first, last);
+
+    float* sizes = particles->getSizesData();
+
+    for (int i = first; i < last; i++){
+        float value = values[i - first];
+        if (value >= 0 && value <= 1)
+            sizes[i] = fromSize + ((toSize - fromSize) * value);
+    }
 }
\ No newline at end of file
@@ -57,4 +57,17 @@ void ParticleSpriteMod::execute(Particles* particles, int particle, float life)
         int index = (int)(frames.size() * value);
         particles->setParticleSprite(particle, frames[index]);
     }
+}
+
+void ParticleSpriteMod::executeRange(Particles* particles, int first, int last) {
+    computeValues(particles, first, last);
+
+    //Sprite can enable texture rects, so it still uses particle setter
+    for (int i = first; i < last; i++){
+        float value = values[i - first];
+        if (value >= 0 && value <= 1){
+            int index = (int)(frames.size() * value);
+            particles->setParticleSprite(i, frames[index]);
+        }
+    }
 }
\ No newline at end of file
@@ -28,6 +28,7 @@ namespace Supernova {
         std::vector<int> getFrames();
 
         virtual void execute(Particles* particles, int particle, float life);
+        virtual void executeRange(Particles* particles, int first, int last);
     };
 
 }
@@ -51,4 +51,20 @@ void ParticleVelocityMod::execute(Particles* particles, int particle, float life
         Vector3 velocity = fromVelocity + ((toVelocity - fromVelocity) * value);
         particles->setParticleVelocity(particle, velocity);
     }
+}
+
+void ParticleVelocityMod::executeRange(Particles* particles, int first, int last) {
+    computeValues(particles, first, last);
+
+    float* velocities = particles->getVelocitiesData();
+
+    for (int i = first; i < last; i++){
+        float value = values[i - first];
+        if (value >= 0 && value <= 1){
+            Vector3 velocity = fromVelocity + ((toVelocity - fromVelocity) * value);
+            velocities[i*3] = velocity.x;
+            velocities[i*3+1] = velocity.y;
+            velocities[i*3+2] = velocity.z;
+        }
+    }
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Buffer.h"
 
 #include "Log.h"
+#include <string.h>
 
 using namespace Supernova;
 
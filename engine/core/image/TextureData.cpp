@@ -1,6 +1,7 @@
 #include "TextureData.h"
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 #include "io/Data.h"
 #include "stb_image.h"
 #include "Log.h"
@@ -288,6 +288,29 @@ void AlignedBox::transform( const Matrix4& matrix ) {
     merge( matrix * currentCorner );
 }
 
+void AlignedBox::transformAffine( const Matrix4& matrix ) {
+    if( mBoxType != BOXTYPE_FINITE )
+        return;
+
+    Vector3 corners[8] = {
+        Vector3(mMinimum.x, mMinimum.y, mMinimum.z),
+        Vector3(mMinimum.x, mMinimum.y, mMaximum.z),
+        Vector3(mMinimum.x, mMaximum.y, mMaximum.z),
+        Vector3(mMinimum.x, mMaximum.y, mMinimum.z),
+        Vector3(mMaximum.x, mMaximum.y, mMinimum.z),
+        Vector3(mMaximum.x, mMaximum.y, mMaximum.z),
+        Vector3(mMaximum.x, mMinimum.y, mMaximum.z),
+        Vector3(mMaximum.x, mMinimum.y, mMinimum.z)
+    };
+
+    matrix.transformPoints(corners, corners, 8);
+
+    setNull();
+
+    for (int i = 0; i < 8; i++)
+        merge( corners[i] );
+}
+
 void AlignedBox::setNull() {
     mBoxType = BOXTYPE_NULL;
 }
@@ -80,6 +80,8 @@ namespace Supernova{
         void merge( const Vector3& point );
 
         void transform( const Matrix4& matrix );
+        //Faster transform for matrices without projection, like model matrices
+        void transformAffine( const Matrix4& matrix );
 
         void setNull();
         bool isNull(void) const;
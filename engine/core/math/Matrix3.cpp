@@ -3,6 +3,7 @@
 #include "math/Angle.h"
 #include <string>
 #include <assert.h>
+#include <string.h>
 
 using namespace Supernova;
 
@@ -1,9 +1,11 @@
 #include "Matrix4.h"
 
 #include "Angle.h"
+#include "SIMD.h"
 #include <cmath>
 #include <cassert>
 #include <string>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 
@@ -59,13 +61,57 @@ Matrix4 Matrix4::operator *(const Matrix4 &m) const
 {
     Matrix4 prod;
 
+#ifdef SUPERNOVA_SIMD
+    SIMD::float4 c0 = SIMD::load(matrix[0]);
+    SIMD::float4 c1 = SIMD::load(matrix[1]);
+    SIMD::float4 c2 = SIMD::load(matrix[2]);
+    SIMD::float4 c3 = SIMD::load(matrix[3]);
+
+    for (int c=0;c<4;c++){
+        SIMD::float4 r = SIMD::mul(c0, SIMD::splat(m.matrix[c][0]));
+        r = SIMD::add(r, SIMD::mul(c1, SIMD::splat(m.matrix[c][1])));
+        r = SIMD::add(r, SIMD::mul(c2, SIMD::splat(m.matrix[c][2])));
+        r = SIMD::add(r, SIMD::mul(c3, SIMD::splat(m.matrix[c][3])));
+        SIMD::store(prod.matrix[c], r);
+    }
+#else
     for (int c=0;c<4;c++)
         for (int r=0;r<4;r++)
-            prod.set(c,r,
-                m.get(c,0)*get(0,r) +
-                m.get(c,1)*get(1,r) +
-                m.get(c,2)*get(2,r) +
-                m.get(c,3)*get(3,r));
+            prod.matrix[c][r] =
+                m.matrix[c][0]*matrix[0][r] +
+                m.matrix[c][1]*matrix[1][r] +
+                m.matrix[c][2]*matrix[2][r] +
+                m.matrix[c][3]*matrix[3][r];
+#endif
+
+    return prod;
+}
+
+Matrix4 Matrix4::affineMultiply(const Matrix4 &m) const
+{
+    Matrix4 prod;
+
+    for (int c=0;c<3;c++){
+        for (int r=0;r<3;r++){
+            float value =
+                m.matrix[c][0]*matrix[0][r] +
+                m.matrix[c][1]*matrix[1][r] +
+                m.matrix[c][2]*matrix[2][r];
+            //Keeps signed zero of skipped term m[c][3]*matrix[3][r], so result is bit-identical to operator*
+            if (value == 0.f)
+                value = (std::signbit(value) && (std::signbit(m.matrix[c][3]) != std::signbit(matrix[3][r]))) ? -0.f : 0.f;
+            prod.matrix[c][r] = value;
+        }
+        prod.matrix[c][3] = 0.f;
+    }
+
+    for (int r=0;r<3;r++)
+        prod.matrix[3][r] =
+            m.matrix[3][0]*matrix[0][r] +
+            m.matrix[3][1]*matrix[1][r] +
+            m.matrix[3][2]*matrix[2][r] +
+            matrix[3][r];
+    prod.matrix[3][3] = 1.f;
 
     return prod;
 }
@@ -93,15 +139,14 @@ Matrix4& Matrix4::operator*=(const Matrix4 &m)
 
 Vector3 Matrix4::operator*(const Vector3 &v) const
 {
-    float prod[4] = { 0,0,0,0 };
+    float prod[4];
 
+#ifdef SUPERNOVA_SIMD
+    SIMD::store(prod, SIMD::combine(SIMD::load(matrix[0]), v.x, SIMD::load(matrix[1]), v.y, SIMD::load(matrix[2]), v.z, SIMD::load(matrix[3])));
+#else
     for (int r=0;r<4;r++)
-    {
-        for (int c=0;c<3;c++)
-            prod[r] += v[c]*get(c,r);
-
-        prod[r] += get(3,r);
-    }
+        prod[r] = v.x*matrix[0][r] + v.y*matrix[1][r] + v.z*matrix[2][r] + matrix[3][r];
+#endif
 
     float div = 1.0 / prod[3];
 
@@ -111,14 +156,18 @@ Vector3 Matrix4::operator*(const Vector3 &v) const
 Vector4 Matrix4::operator*(const Vector4 &v) const
 {
 
-    float prod[4] = { 0,0,0,0 };
+    float prod[4];
 
-    int i, j;
-    for(j=0; j<4; ++j) {
-        prod[j] = 0.f;
-        for(i=0; i<4; ++i)
-            prod[j] += get(i,j) * v[i];
-    }
+#ifdef SUPERNOVA_SIMD
+    SIMD::float4 r = SIMD::mul(SIMD::load(matrix[0]), SIMD::splat(v.x));
+    r = SIMD::add(r, SIMD::mul(SIMD::load(matrix[1]), SIMD::splat(v.y)));
+    r = SIMD::add(r, SIMD::mul(SIMD::load(matrix[2]), SIMD::splat(v.z)));
+    r = SIMD::add(r, SIMD::mul(SIMD::load(matrix[3]), SIMD::splat(v.w)));
+    SIMD::store(prod, r);
+#else
+    for (int j=0; j<4; ++j)
+        prod[j] = matrix[0][j]*v.x + matrix[1][j]*v.y + matrix[2][j]*v.z + matrix[3][j]*v.w;
+#endif
 
     return Vector4(prod[0] ,prod[1] ,prod[2], prod[3]);
 }
@@ -179,20 +228,44 @@ Vector4 Matrix4::column(const unsigned int column) const
 }
 
 void Matrix4::identity(){
-    int i, j;
-    for(i=0; i<4; ++i)
-        for(j=0; j<4; ++j)
-            set(i,j,(i==j ? 1.f : 0.f));
+    for (int i=0; i<4; ++i)
+        for (int j=0; j<4; ++j)
+            matrix[i][j] = (i==j ? 1.f : 0.f);
 }
 
 void Matrix4::translateInPlace(float x, float y, float z){
-    Vector4 t = Vector4(x, y, z, 0);
-    Vector4 r = Vector4();
-    int i;
-    for (i = 0; i < 4; ++i) {
-        r = row(i);
-        set(3, i, get(3, i) + r.dotProduct(t));
+#ifdef SUPERNOVA_SIMD
+    SIMD::store(matrix[3], SIMD::combine(SIMD::load(matrix[0]), x, SIMD::load(matrix[1]), y, SIMD::load(matrix[2]), z, SIMD::load(matrix[3])));
+#else
+    for (int i = 0; i < 4; ++i)
+        matrix[3][i] = matrix[0][i]*x + matrix[1][i]*y + matrix[2][i]*z + matrix[3][i];
+#endif
+}
+
+void Matrix4::transformPoints(const Vector3* points, Vector3* result, size_t count) const{
+#ifdef SUPERNOVA_SIMD
+    SIMD::float4 c0 = SIMD::load(matrix[0]);
+    SIMD::float4 c1 = SIMD::load(matrix[1]);
+    SIMD::float4 c2 = SIMD::load(matrix[2]);
+    SIMD::float4 c3 = SIMD::load(matrix[3]);
+
+    float prod[4];
+    for (size_t i = 0; i < count; i++){
+        const Vector3& p = points[i];
+        SIMD::store(prod, SIMD::combine(c0, p.x, c1, p.y, c2, p.z, c3));
+        result[i].x = prod[0];
+        result[i].y = prod[1];
+        result[i].z = prod[2];
     }
+#else
+    for (size_t i = 0; i < count; i++){
+        //Copy allows points and result to be the same array
+        Vector3 p = points[i];
+        result[i].x = p.x*matrix[0][0] + p.y*matrix[1][0] + p.z*matrix[2][0] + matrix[3][0];
+        result[i].y = p.x*matrix[0][1] + p.y*matrix[1][1] + p.z*matrix[2][1] + matrix[3][1];
+        result[i].z = p.x*matrix[0][2] + p.y*matrix[1][2] + p.z*matrix[2][2] + matrix[3][2];
+    }
+#endif
 }
 
 Matrix4 Matrix4::transpose(){
@@ -208,43 +281,78 @@ Matrix4 Matrix4::transpose(){
 Matrix4 Matrix4::inverse(){
     float s[6];
     float c[6];
-    s[0] = get(0,0)*get(1,1) - get(1,0)*get(0,1);
-    s[1] = get(0,0)*get(1,2) - get(1,0)*get(0,2);
-    s[2] = get(0,0)*get(1,3) - get(1,0)*get(0,3);
-    s[3] = get(0,1)*get(1,2) - get(1,1)*get(0,2);
-    s[4] = get(0,1)*get(1,3) - get(1,1)*get(0,3);
-    s[5] = get(0,2)*get(1,3) - get(1,2)*get(0,3);
-
-    c[0] = get(2,0)*get(3,1) - get(3,0)*get(2,1);
-    c[1] = get(2,0)*get(3,2) - get(3,0)*get(2,2);
-    c[2] = get(2,0)*get(3,3) - get(3,0)*get(2,3);
-    c[3] = get(2,1)*get(3,2) - get(3,1)*get(2,2);
-    c[4] = get(2,1)*get(3,3) - get(3,1)*get(2,3);
-    c[5] = get(2,2)*get(3,3) - get(3,2)*get(2,3);
+    s[0] = matrix[0][0]*matrix[1][1] - matrix[1][0]*matrix[0][1];
+    s[1] = matrix[0][0]*matrix[1][2] - matrix[1][0]*matrix[0][2];
+    s[2] = matrix[0][0]*matrix[1][3] - matrix[1][0]*matrix[0][3];
+    s[3] = matrix[0][1]*matrix[1][2] - matrix[1][1]*matrix[0][2];
+    s[4] = matrix[0][1]*matrix[1][3] - matrix[1][1]*matrix[0][3];
+    s[5] = matrix[0][2]*matrix[1][3] - matrix[1][2]*matrix[0][3];
+
+    c[0] = matrix[2][0]*matrix[3][1] - matrix[3][0]*matrix[2][1];
+    c[1] = matrix[2][0]*matrix[3][2] - matrix[3][0]*matrix[2][2];
+    c[2] = matrix[2][0]*matrix[3][3] - matrix[3][0]*matrix[2][3];
+    c[3] = matrix[2][1]*matrix[3][2] - matrix[3][1]*matrix[2][2];
+    c[4] = matrix[2][1]*matrix[3][3] - matrix[3][1]*matrix[2][3];
+    c[5] = matrix[2][2]*matrix[3][3] - matrix[3][2]*matrix[2][3];
 
     float idet = 1.0f/( s[0]*c[5]-s[1]*c[4]+s[2]*c[3]+s[3]*c[2]-s[4]*c[1]+s[5]*c[0] );
 
     Matrix4 t;
 
-    t.set(0,0, ( get(1,1) * c[5] - get(1,2) * c[4] + get(1,3) * c[3]) * idet);
-    t.set(0,1, (-get(0,1) * c[5] + get(0,2) * c[4] - get(0,3) * c[3]) * idet);
-    t.set(0,2, ( get(3,1) * s[5] - get(3,2) * s[4] + get(3,3) * s[3]) * idet);
-    t.set(0,3, (-get(2,1) * s[5] + get(2,2) * s[4] - get(2,3) * s[3]) * idet);
+    t.matrix[0][0] = ( matrix[1][1] * c[5] - matrix[1][2] * c[4] + matrix[1][3] * c[3]) * idet;
+    t.matrix[0][1] = (-matrix[0][1] * c[5] + matrix[0][2] * c[4] - matrix[0][3] * c[3]) * idet;
+    t.matrix[0][2] = ( matrix[3][1] * s[5] - matrix[3][2] * s[4] + matrix[3][3] * s[3]) * idet;
+    t.matrix[0][3] = (-matrix[2][1] * s[5] + matrix[2][2] * s[4] - matrix[2][3] * s[3]) * idet;
 
-    t.set(1,0, (-get(1,0) * c[5] + get(1,2) * c[2] - get(1,3) * c[1]) * idet);
-    t.set(1,1, ( get(0,0) * c[5] - get(0,2) * c[2] + get(0,3) * c[1]) * idet);
-    t.set(1,2, (-get(3,0) * s[5] + get(3,2) * s[2] - get(3,3) * s[1]) * idet);
-    t.set(1,3, ( get(2,0) * s[5] - get(2,2) * s[2] + get(2,3) * s[1]) * idet);
+    t.matrix[1][0] = (-matrix[1][0] * c[5] + matrix[1][2] * c[2] - matrix[1][3] * c[1]) * idet;
+    t.matrix[1][1] = ( matrix[0][0] * c[5] - matrix[0][2] * c[2] + matrix[0][3] * c[1]) * idet;
+    t.matrix[1][2] = (-matrix[3][0] * s[5] + matrix[3][2] * s[2] - matrix[3][3] * s[1]) * idet;
+    t.matrix[1][3] = ( matrix[2][0] * s[5] - matrix[2][2] * s[2] + matrix[2][3] * s[1]) * idet;
 
-    t.set(2,0, ( get(1,0) * c[4] - get(1,1) * c[2] + get(1,3) * c[0]) * idet);
-    t.set(2,1, (-get(0,0) * c[4] + get(0,1) * c[2] - get(0,3) * c[0]) * idet);
-    t.set(2,2, ( get(3,0) * s[4] - get(3,1) * s[2] + get(3,3) * s[0]) * idet);
-    t.set(2,3, (-get(2,0) * s[4] + get(2,1) * s[2] - get(2,3) * s[0]) * idet);
+    t.matrix[2][0] = ( matrix[1][0] * c[4] - matrix[1][1] * c[2] + matrix[1][3] * c[0]) * idet;
+    t.matrix[2][1] = (-matrix[0][0] * c[4] + matrix[0][1] * c[2] - matrix[0][3] * c[0]) * idet;
+    t.matrix[2][2] = ( matrix[3][0] * s[4] - matrix[3][1] * s[2] + matrix[3][3] * s[0]) * idet;
+    t.matrix[2][3] = (-matrix[2][0] * s[4] + matrix[2][1] * s[2] - matrix[2][3] * s[0]) * idet;
 
-    t.set(3,0, (-get(1,0) * c[3] + get(1,1) * c[1] - get(1,2) * c[0]) * idet);
-    t.set(3,1, ( get(0,0) * c[3] - get(0,1) * c[1] + get(0,2) * c[0]) * idet);
-    t.set(3,2, (-get(3,0) * s[3] + get(3,1) * s[1] - get(3,2) * s[0]) * idet);
-    t.set(3,3, ( get(2,0) * s[3] - get(2,1) * s[1] + get(2,2) * s[0]) * idet);
+    t.matrix[3][0] = (-matrix[1][0] * c[3] + matrix[1][1] * c[1] - matrix[1][2] * c[0]) * idet;
+    t.matrix[3][1] = ( matrix[0][0] * c[3] - matrix[0][1] * c[1] + matrix[0][2] * c[0]) * idet;
+    t.matrix[3][2] = (-matrix[3][0] * s[3] + matrix[3][1] * s[1] - matrix[3][2] * s[0]) * idet;
+    t.matrix[3][3] = ( matrix[2][0] * s[3] - matrix[2][1] * s[1] + matrix[2][2] * s[0]) * idet;
+
+    return t;
+}
+
+Matrix4 Matrix4::affineInverse() const{
+    //Rows of inverse 3x3 are cross products of columns divided by determinant
+    float r0[3], r1[3], r2[3];
+
+    r0[0] = matrix[1][1]*matrix[2][2] - matrix[1][2]*matrix[2][1];
+    r0[1] = matrix[1][2]*matrix[2][0] - matrix[1][0]*matrix[2][2];
+    r0[2] = matrix[1][0]*matrix[2][1] - matrix[1][1]*matrix[2][0];
+
+    r1[0] = matrix[2][1]*matrix[0][2] - matrix[2][2]*matrix[0][1];
+    r1[1] = matrix[2][2]*matrix[0][0] - matrix[2][0]*matrix[0][2];
+    r1[2] = matrix[2][0]*matrix[0][1] - matrix[2][1]*matrix[0][0];
+
+    r2[0] = matrix[0][1]*matrix[1][2] - matrix[0][2]*matrix[1][1];
+    r2[1] = matrix[0][2]*matrix[1][0] - matrix[0][0]*matrix[1][2];
+    r2[2] = matrix[0][0]*matrix[1][1] - matrix[0][1]*matrix[1][0];
+
+    float idet = 1.0f / (matrix[0][0]*r0[0] + matrix[0][1]*r0[1] + matrix[0][2]*r0[2]);
+
+    Matrix4 t;
+
+    for (int c=0;c<3;c++){
+        t.matrix[c][0] = r0[c] * idet;
+        t.matrix[c][1] = r1[c] * idet;
+        t.matrix[c][2] = r2[c] * idet;
+        t.matrix[c][3] = 0.f;
+    }
+
+    t.matrix[3][0] = -(t.matrix[0][0]*matrix[3][0] + t.matrix[1][0]*matrix[3][1] + t.matrix[2][0]*matrix[3][2]);
+    t.matrix[3][1] = -(t.matrix[0][1]*matrix[3][0] + t.matrix[1][1]*matrix[3][1] + t.matrix[2][1]*matrix[3][2]);
+    t.matrix[3][2] = -(t.matrix[0][2]*matrix[3][0] + t.matrix[1][2]*matrix[3][1] + t.matrix[2][2]*matrix[3][2]);
+    t.matrix[3][3] = 1.f;
 
     return t;
 }
@@ -472,25 +580,25 @@ Matrix4 Matrix4::scaleMatrix(const Vector3& sf){
 
      Matrix4 r;
 
-     r.set(0, 0, s.x);
-     r.set(0, 1, t.x);
-     r.set(0, 2, -f.x);
-     r.set(0, 3, 0.f);
+     r.matrix[0][0] = s.x;
+     r.matrix[0][1] = t.x;
+     r.matrix[0][2] = -f.x;
+     r.matrix[0][3] = 0.f;
 
-     r.set(1, 0, s.y);
-     r.set(1, 1, t.y);
-     r.set(1, 2, -f.y);
-     r.set(1, 3, 0.f);
+     r.matrix[1][0] = s.y;
+     r.matrix[1][1] = t.y;
+     r.matrix[1][2] = -f.y;
+     r.matrix[1][3] = 0.f;
 
-     r.set(2, 0, s.z);
-     r.set(2, 1, t.z);
-     r.set(2, 2, -f.z);
-     r.set(2, 3, 0.f);
+     r.matrix[2][0] = s.z;
+     r.matrix[2][1] = t.z;
+     r.matrix[2][2] = -f.z;
+     r.matrix[2][3] = 0.f;
 
-     r.set(3, 0, 0.f);
-     r.set(3, 1, 0.f);
-     r.set(3, 2, 0.f);
-     r.set(3, 3, 1.f);
+     r.matrix[3][0] = 0.f;
+     r.matrix[3][1] = 0.f;
+     r.matrix[3][2] = 0.f;
+     r.matrix[3][3] = 1.f;
 
      r.translateInPlace(-eye.x, -eye.y, -eye.z);
 
@@ -557,25 +665,25 @@ Matrix4 Matrix4::perspectiveMatrix(float y_fov, float aspect, float near, float
 
     Matrix4 r;
 
-    r.set(0, 0, a / aspect);
-    r.set(0, 1, 0.f);
-    r.set(0, 2, 0.f);
-    r.set(0, 3, 0.f);
-
-    r.set(1, 0, 0.f);
-    r.set(1, 1, a);
-    r.set(1, 2, 0.f);
-    r.set(1, 3, 0.f);
-
-    r.set(2, 0, 0.f);
-    r.set(2, 1, 0.f);
-    r.set(2, 2, -((far + near) / (far - near)));
-    r.set(2, 3, -1.f);
-
-    r.set(3, 0, 0.f);
-    r.set(3, 1, 0.f);
-    r.set(3, 2, -((2.f * far * near) / (far - near)));
-    r.set(3, 3, 0.f);
+    r.matrix[0][0] = a / aspect;
+    r.matrix[0][1] = 0.f;
+    r.matrix[0][2] = 0.f;
+    r.matrix[0][3] = 0.f;
+
+    r.matrix[1][0] = 0.f;
+    r.matrix[1][1] = a;
+    r.matrix[1][2] = 0.f;
+    r.matrix[1][3] = 0.f;
+
+    r.matrix[2][0] = 0.f;
+    r.matrix[2][1] = 0.f;
+    r.matrix[2][2] = -((far + near) / (far - near));
+    r.matrix[2][3] = -1.f;
+
+    r.matrix[3][0] = 0.f;
+    r.matrix[3][1] = 0.f;
+    r.matrix[3][2] = -((2.f * far * near) / (far - near));
+    r.matrix[3][3] = 0.f;
 
     return r;
 }
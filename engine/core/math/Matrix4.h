@@ -4,6 +4,7 @@
 
 #include "math/Vector3.h"
 #include "math/Vector4.h"
+#include <stddef.h>
 
 
 namespace Supernova {
@@ -46,8 +47,16 @@ namespace Supernova {
         void translateInPlace(float x, float y, float z);
 
         Matrix4 inverse();
+        //Faster inverse when last row is (0,0,0,1), like model and view matrices
+        Matrix4 affineInverse() const;
         Matrix4 transpose();
 
+        //Same as operator*(Vector3) for affine matrices, without perspective divide
+        void transformPoints(const Vector3* points, Vector3* result, size_t count) const;
+
+        //Same as operator* when both matrices have last row (0,0,0,1)
+        Matrix4 affineMultiply(const Matrix4 &m) const;
+
         static Matrix4 translateMatrix(float x, float y, float z);
         static Matrix4 translateMatrix(const Vector3& position);
 
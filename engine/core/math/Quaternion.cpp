@@ -231,7 +231,7 @@ void Quaternion::fromRotationMatrix (const Matrix4& kRot){
     }
 }
 
-Matrix4 Quaternion::getRotationMatrix(){
+Matrix4 Quaternion::getRotationMatrix() const{
 
     float xx      = x * x;
     float xy      = x * y;
@@ -46,7 +46,7 @@ namespace Supernova {
         void fromAxes (const Vector3* akAxis);
         void fromAxes (const Vector3& xaxis, const Vector3& yaxis, const Vector3& zaxis);
         void fromRotationMatrix (const Matrix4& kRot);
-        Matrix4 getRotationMatrix();
+        Matrix4 getRotationMatrix() const;
         void fromAngle (const float angle);
         void fromAngleAxis (const float angle, const Vector3& rkAxis);
 
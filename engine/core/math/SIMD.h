@@ -0,0 +1,77 @@
+
+#ifndef simd_h
+#define simd_h
+
+//
+// (c) 2020 Eduardo Doria.
+//
+
+//Define SUPERNOVA_NO_SIMD to force scalar math
+
+#if !defined(SUPERNOVA_NO_SIMD)
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SUPERNOVA_SIMD
+#define SUPERNOVA_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SUPERNOVA_SIMD
+#define SUPERNOVA_SIMD_NEON
+#include <arm_neon.h>
+#elif defined(__wasm_simd128__)
+#define SUPERNOVA_SIMD
+#define SUPERNOVA_SIMD_WASM
+#include <wasm_simd128.h>
+#endif
+#endif
+
+#ifdef SUPERNOVA_SIMD
+
+namespace Supernova {
+
+    //Minimal 4 float wrapper, operations are not fused to keep same results of scalar code
+    namespace SIMD {
+
+#if defined(SUPERNOVA_SIMD_SSE)
+        typedef __m128 float4;
+
+        inline float4 load(const float* p){ return _mm_loadu_ps(p); }
+        inline void store(float* p, float4 v){ _mm_storeu_ps(p, v); }
+        inline float4 splat(float f){ return _mm_set1_ps(f); }
+        inline float4 add(float4 a, float4 b){ return _mm_add_ps(a, b); }
+        inline float4 sub(float4 a, float4 b){ return _mm_sub_ps(a, b); }
+        inline float4 mul(float4 a, float4 b){ return _mm_mul_ps(a, b); }
+#elif defined(SUPERNOVA_SIMD_NEON)
+        typedef float32x4_t float4;
+
+        inline float4 load(const float* p){ return vld1q_f32(p); }
+        inline void store(float* p, float4 v){ vst1q_f32(p, v); }
+        inline float4 splat(float f){ return vdupq_n_f32(f); }
+        inline float4 add(float4 a, float4 b){ return vaddq_f32(a, b); }
+        inline float4 sub(float4 a, float4 b){ return vsubq_f32(a, b); }
+        inline float4 mul(float4 a, float4 b){ return vmulq_f32(a, b); }
+#elif defined(SUPERNOVA_SIMD_WASM)
+        typedef v128_t float4;
+
+        inline float4 load(const float* p){ return wasm_v128_load(p); }
+        inline void store(float* p, float4 v){ wasm_v128_store(p, v); }
+        inline float4 splat(float f){ return wasm_f32x4_splat(f); }
+        inline float4 add(float4 a, float4 b){ return wasm_f32x4_add(a, b); }
+        inline float4 sub(float4 a, float4 b){ return wasm_f32x4_sub(a, b); }
+        inline float4 mul(float4 a, float4 b){ return wasm_f32x4_mul(a, b); }
+#endif
+
+        //a*x + b*y + c*z + d
+        inline float4 combine(float4 a, float x, float4 b, float y, float4 c, float z, float4 d){
+            float4 r = mul(a, splat(x));
+            r = add(r, mul(b, splat(y)));
+            r = add(r, mul(c, splat(z)));
+            return add(r, d);
+        }
+
+    }
+
+}
+
+#endif
+
+#endif /* simd_h */
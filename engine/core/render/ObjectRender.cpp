@@ -93,7 +93,12 @@ void ObjectRender::setIndices(std::string buffer, size_t size, size_t offset, Da
 
 void ObjectRender::addProperty(int type, int datatype, unsigned int size, void* data){
     if (data && (size > 0))
-        properties[type] = { datatype, size, data };
+        properties[type] = { datatype, size, data, false };
+}
+
+void ObjectRender::addGlobalProperty(int type, int datatype, unsigned int size, void* data){
+    if (data && (size > 0))
+        properties[type] = { datatype, size, data, true };
 }
 
 void ObjectRender::addTexture(int type, Texture* texture){
@@ -116,6 +121,10 @@ void ObjectRender::updateBuffer(std::string name, unsigned int size, void* data)
     }
 }
 
+void ObjectRender::updateBufferRange(std::string, size_t, size_t){
+    //Buffer data is same pointer, only render uploads it
+}
+
 std::shared_ptr<ProgramRender> ObjectRender::getProgram(){
     
     loadProgram();
@@ -72,6 +72,7 @@ namespace Supernova {
             int datatype;
             unsigned int size;
             void* data;
+            bool global;
         };
 
         std::unordered_map<std::string, BufferData> buffers;
@@ -122,12 +123,15 @@ namespace Supernova {
         void addVertexAttribute(int type, std::string buffer, unsigned int elements, DataType dataType = DataType::FLOAT, unsigned int stride = 0, size_t offset = 0);
         void setIndices(std::string buffer, size_t size, size_t offset, DataType type);
         void addProperty(int type, int datatype, unsigned int size, void* data);
+        //Same data for all objects of scene pass, like camera, lights and fog
+        void addGlobalProperty(int type, int datatype, unsigned int size, void* data);
         void addTexture(int type, Texture* texture);
         void addTextureVector(int type, std::vector<Texture*> texturesVec);
 
         std::shared_ptr<ProgramRender> getProgram();
 
         virtual void updateBuffer(std::string name, unsigned int size, void* data);
+        virtual void updateBufferRange(std::string name, size_t offset, size_t size);
 
         virtual bool load();
         virtual bool prepareDraw();
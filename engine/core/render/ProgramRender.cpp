@@ -18,6 +18,9 @@ ProgramRender::ProgramRender(){
     this->numShadows2D = 0;
     this->numShadowsCube = 0;
     this->numBlendMapColors = 0;
+
+    this->globalsStamp = 0;
+    this->globalProperties = 0;
 }
 
 ProgramRender::~ProgramRender(){
@@ -143,6 +146,26 @@ int ProgramRender::getNumBlendMapColors(){
     return numBlendMapColors;
 }
 
+void ProgramRender::setGlobalsStamp(unsigned long globalsStamp){
+    this->globalsStamp = globalsStamp;
+}
+
+unsigned long ProgramRender::getGlobalsStamp(){
+    return globalsStamp;
+}
+
+void ProgramRender::addGlobalProperty(int type){
+    if (type >= 0 && type < 64)
+        globalProperties |= ((uint64_t)1 << type);
+}
+
+bool ProgramRender::isGlobalProperty(int type){
+    if (type >= 0 && type < 64)
+        return (globalProperties & ((uint64_t)1 << type)) != 0;
+
+    return false;
+}
+
 void ProgramRender::createProgram(int shaderType, int programDefs, int numPointLights, int numSpotLights, int numDirLights, int numShadows2D, int numShadowsCube, int numBlendMapColors){
     loaded = true;
 }
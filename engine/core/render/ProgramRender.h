@@ -91,6 +91,9 @@
 #define S_PROPERTY_TERRAINTEXTUREDETAILTILES 48
 #define S_PROPERTY_BLENDMAPCOLORINDEX 49
 
+#define S_PROPERTY_SHADOWRECT2D 50
+#define S_PROPERTY_SHADOWRECTCUBE 51
+
 #define S_TEXTURESAMPLER_DIFFUSE 1
 #define S_TEXTURESAMPLER_SHADOWMAP2D 2
 #define S_TEXTURESAMPLER_SHADOWMAPCUBE 3
@@ -98,6 +101,9 @@
 #define S_TEXTURESAMPLER_BLENDMAP 5
 #define S_TEXTURESAMPLER_TERRAINDETAIL 6
 
+//Skinning uniforms of one draw, larger skeletons are split in palettes
+#define S_MAX_BONES 70
+
 #define S_PROGRAM_USE_FOG  1 << 0
 #define S_PROGRAM_USE_TEXCOORD  1 << 1
 #define S_PROGRAM_USE_TEXRECT  1 << 2
@@ -112,6 +118,7 @@
 #include <string>
 #include <unordered_map>
 #include <regex>
+#include <cstdint>
 
 namespace Supernova {
 
@@ -136,6 +143,11 @@ namespace Supernova {
         int numShadowsCube;
         int numBlendMapColors;
 
+        //Scene frame stamp of last global properties upload
+        unsigned long globalsStamp;
+        //Bit by property type of properties uploaded as global
+        uint64_t globalProperties;
+
         std::string regexReplace(std::string_view haystack, const std::regex& rx, std::function<std::string(const std::cmatch&)> f);
         std::string replaceAll(std::string source, const std::string from, const std::string to);
         std::string unrollLoops(std::string source);
@@ -158,6 +170,12 @@ namespace Supernova {
         int getNumShadowsCube();
         int getNumBlendMapColors();
 
+        //Program uniforms keep values, global properties are sent again only when stamp is different
+        void setGlobalsStamp(unsigned long globalsStamp);
+        unsigned long getGlobalsStamp();
+        void addGlobalProperty(int type);
+        bool isGlobalProperty(int type);
+
         virtual void createProgram(int shaderType, int programDefs, int numPointLights, int numSpotLights, int numDirLights, int numShadows2D, int numShadowsCube, int numBlendMapColors);
         virtual void deleteProgram();
         
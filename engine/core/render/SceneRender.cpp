@@ -5,12 +5,18 @@
 
 using namespace Supernova;
 
+unsigned long SceneRender::frameStampCounter = 0;
+bool SceneRender::scissorEnabled = false;
+Rect SceneRender::activeScissor;
+
 SceneRender::SceneRender(){
     useLight = false;
     childScene = false;
     useDepth = false;
     useTransparency = false;
     drawingShadow = false;
+    frameStamp = 0;
+    uniformUploads = 0;
 }
 
 SceneRender::~SceneRender(){
@@ -45,6 +51,35 @@ void SceneRender::setDrawingShadow(bool drawingShadow){
     this->drawingShadow = drawingShadow;
 }
 
+void SceneRender::updateFrameStamp(){
+    //Zero is never used, programs start with it
+    frameStamp = ++frameStampCounter;
+}
+
+unsigned long SceneRender::getFrameStamp(){
+    return frameStamp;
+}
+
+void SceneRender::addUniformUploads(unsigned int uniformUploads){
+    this->uniformUploads += uniformUploads;
+}
+
+void SceneRender::resetUniformUploads(){
+    uniformUploads = 0;
+}
+
+unsigned int SceneRender::getUniformUploads(){
+    return uniformUploads;
+}
+
+bool SceneRender::isEnabledScissor(){
+    return scissorEnabled;
+}
+
+Rect SceneRender::getActiveScissor(){
+    return activeScissor;
+}
+
 bool SceneRender::load(){
     return true;
 }
@@ -7,6 +7,8 @@
 
 namespace Supernova {
 
+    class Texture;
+
     class SceneRender {
         
     protected:
@@ -19,6 +21,16 @@ namespace Supernova {
         
         Scene* scene;
 
+        unsigned long frameStamp;
+        static unsigned long frameStampCounter;
+
+        //glUniform* calls of objects since last reset
+        unsigned int uniformUploads;
+
+        //Scissor state of context shared by all scenes, set by enableScissor and disableScissor
+        static bool scissorEnabled;
+        static Rect activeScissor;
+
         void updateLights();
 
         SceneRender();
@@ -34,6 +46,14 @@ namespace Supernova {
         void setUseTransparency(bool useTransparency);
         void setDrawingShadow(bool drawingShadow);
 
+        //Unique for each scene pass, global properties are sent once per program for each stamp
+        void updateFrameStamp();
+        unsigned long getFrameStamp();
+
+        void addUniformUploads(unsigned int uniformUploads);
+        void resetUniformUploads();
+        unsigned int getUniformUploads();
+
         virtual bool load();
         virtual bool draw();
         virtual bool clear(float value = 0) = 0;
@@ -41,8 +61,16 @@ namespace Supernova {
         virtual bool enableScissor(Rect rect) = 0;
         virtual bool disableScissor() = 0;
 
-        virtual bool isEnabledScissor() = 0;
-        virtual Rect getActiveScissor() = 0;
+        //Color is masked in pre-pass, then depth is only tested
+        virtual bool beginDepthPrePass() = 0;
+        virtual bool beginDepthTestedPass() = 0;
+        virtual bool endDepthPrePass() = 0;
+
+        //Region of texture in xy offset and zw size, drawn over all viewport
+        virtual bool drawTexture(Texture* texture, Rect textureRect) = 0;
+
+        bool isEnabledScissor();
+        Rect getActiveScissor();
     };
     
 }
@@ -6,6 +6,7 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <memory>
 
 #define TEXTURE_CUBE_FACE_POSITIVE_X 0
 #define TEXTURE_CUBE_FACE_NEGATIVE_X 1
@@ -41,6 +41,8 @@
 #include "Sprite.h"
 #include "util/Function.h"
 #include "util/FunctionSubscribe.h"
+#include "util/JobSystem.h"
+#include "util/ResolutionController.h"
 #include "physics/Contact2D.h"
 #include "action/Action.h"
 #include "action/Ease.h"
@@ -52,6 +54,7 @@
 #include "action/AlphaAction.h"
 #include "action/SpriteAnimation.h"
 #include "action/ParticlesAnimation.h"
+#include "action/Animation.h"
 #include "action/particleinit/ParticleInit.h"
 #include "action/particleinit/ParticleAccelerationInit.h"
 #include "action/particleinit/ParticleAlphaInit.h"
@@ -275,8 +278,21 @@ void LuaBinding::registerClasses(lua_State *L){
             .addStaticFunction("setDefaultNearestScaleTexture", &Engine::setDefaultNearestScaleTexture)
             .addStaticFunction("setDefaultResampleToPOTTexture", &Engine::setDefaultResampleToPOTTexture)
             .addStaticFunction("setUpdateTime", &Engine::setUpdateTime)
+            .addStaticFunction("setMaxFrameDelta", &Engine::setMaxFrameDelta)
+            .addStaticFunction("setMaxUpdateSteps", &Engine::setMaxUpdateSteps)
+            .addStaticFunction("getDroppedTime", &Engine::getDroppedTime)
+            .addStaticFunction("getUpdateAlpha", &Engine::getUpdateAlpha)
+            .addStaticFunction("setAsyncLoadTimeBudget", &Engine::setAsyncLoadTimeBudget)
+            .addStaticFunction("setAsyncLoadThreads", &Engine::setAsyncLoadThreads)
+            .addStaticFunction("setRenderOnDemand", &Engine::setRenderOnDemand)
+            .addStaticFunction("isRenderOnDemand", &Engine::isRenderOnDemand)
+            .addStaticFunction("requestRedraw", &Engine::requestRedraw)
+            .addStaticFunction("getEvaluatedSkeletons", &Engine::getEvaluatedSkeletons)
+            .addStaticFunction("getInterpolatedSkeletons", &Engine::getInterpolatedSkeletons)
+            .addStaticFunction("getSkippedSkeletons", &Engine::getSkippedSkeletons)
             .addStaticFunction("getFramerate", &Engine::getFramerate)
             .addStaticFunction("getDeltatime", &Engine::getDeltatime)
+            .addStaticFunction("getFrameWorkTime", &Engine::getFrameWorkTime)
             .addConstant("SCALING_FITWIDTH", Scaling::FITWIDTH)
             .addConstant("SCALING_FITHEIGHT", Scaling::FITHEIGHT)
             .addConstant("SCALING_LETTERBOX", Scaling::LETTERBOX)
@@ -298,6 +314,25 @@ void LuaBinding::registerClasses(lua_State *L){
             .addStaticProperty("onTextInput", [] () { return &Engine::onTextInput; }, [] (lua_State* L) { Engine::onTextInput.add("luaFunction", L); })
             .endClass();
 
+    //Lua state is not thread safe, so jobs can not call Lua functions and only configuration is exposed
+    LuaIntf::LuaBinding(L).beginClass<JobSystem>("JobSystem")
+            .addStaticFunction("setNumThreads", &JobSystem::setNumThreads)
+            .addStaticFunction("getNumThreads", &JobSystem::getNumThreads)
+            .endClass();
+
+    LuaIntf::LuaBinding(L).beginClass<ResolutionController>("ResolutionController")
+            .addFunction("reset", &ResolutionController::reset)
+            .addFunction("getScale", &ResolutionController::getScale)
+            .addFunction("getAverageFrameTime", &ResolutionController::getAverageFrameTime)
+            .addProperty("targetFrameTime", &ResolutionController::getTargetFrameTime, &ResolutionController::setTargetFrameTime)
+            .addFunction("setScaleRange", &ResolutionController::setScaleRange)
+            .addFunction("getMinScale", &ResolutionController::getMinScale)
+            .addFunction("getMaxScale", &ResolutionController::getMaxScale)
+            .addProperty("step", &ResolutionController::getStep, &ResolutionController::setStep)
+            .addProperty("tolerance", &ResolutionController::getTolerance, &ResolutionController::setTolerance)
+            .addProperty("cooldownFrames", &ResolutionController::getCooldownFrames, &ResolutionController::setCooldownFrames)
+            .endClass();
+
     LuaIntf::LuaBinding(L).beginClass<Function<float(float)>>("Function_F_F")
             .addFunction("__call", &Function<float(float)>::call)
             .addFunction("call", &Function<float(float)>::call)
@@ -510,7 +545,17 @@ void LuaBinding::registerClasses(lua_State *L){
             .addFunction("moveUp", &Object::moveUp)
             .addFunction("moveDown", &Object::moveDown)
             .addProperty("center", &Object::getCenter, (void (Object::*)(Vector3))&Object::setCenter)
+            .addProperty("interpolation", &Object::isInterpolation, &Object::setInterpolation)
+            .addFunction("loadAsync", &Object::loadAsync)
+            .addFunction("getLoadState", &Object::getLoadState)
+            .addProperty("loadState", &Object::getLoadState)
+            .addProperty("onLoad", [] (Object* object) { return &object->onLoad; }, [] (Object* object, lua_State* L) { object->onLoad.add("luaFunction", L); })
+            .addConstant("LOADSTATE_NONE", S_LOADSTATE_NONE)
+            .addConstant("LOADSTATE_LOADING", S_LOADSTATE_LOADING)
+            .addConstant("LOADSTATE_LOADED", S_LOADSTATE_LOADED)
+            .addConstant("LOADSTATE_FAILED", S_LOADSTATE_FAILED)
             .addFunction("destroy", &Object::destroy)
+            .addFunction("requestRedraw", &Object::requestRedraw)
             .endClass()
 
             .beginExtendClass<Scene, Object>("Scene")
@@ -518,6 +563,25 @@ void LuaBinding::registerClasses(lua_State *L){
             .addFunction("setCamera", &Scene::setCamera)
             .addFunction("setAmbientLight", (void (Scene::*)(const float))&Scene::setAmbientLight)
             .addProperty("ambientLight", &Scene::getAmbientLight, (void (Scene::*)(Vector3))&Scene::setAmbientLight)
+            .addProperty("parallelTransforms", &Scene::isParallelTransforms, &Scene::setParallelTransforms)
+            .addProperty("batchedTweens", &Scene::isBatchedTweens, &Scene::setBatchedTweens)
+            .addFunction("getBatchedTweens", &Scene::getBatchedTweens)
+            .addProperty("batchedSpriteAnimations", &Scene::isBatchedSpriteAnimations, &Scene::setBatchedSpriteAnimations)
+            .addFunction("getBatchedSpriteAnimations", &Scene::getBatchedSpriteAnimations)
+            .addProperty("shadowRoundRobinPasses", &Scene::getShadowRoundRobinPasses, &Scene::setShadowRoundRobinPasses)
+            .addFunction("getShadowPasses", &Scene::getShadowPasses)
+            .addFunction("getShadowDrawCalls", &Scene::getShadowDrawCalls)
+            .addFunction("getShadowCulledCasters", &Scene::getShadowCulledCasters)
+            .addFunction("getUniformUploads", &Scene::getUniformUploads)
+            .addProperty("shadowCastersCulling", &Scene::isShadowCastersCulling, &Scene::setShadowCastersCulling)
+            .addProperty("maxLightsPerObject", &Scene::getMaxLightsPerObject, &Scene::setMaxLightsPerObject)
+            .addFunction("setDepthPrePass", &Scene::setDepthPrePass)
+            .addFunction("isDepthPrePass", &Scene::isDepthPrePass)
+            .addProperty("opaqueSorting", &Scene::isOpaqueSorting, &Scene::setOpaqueSorting)
+            .addProperty("shadowAtlasSize", &Scene::getShadowAtlasSize, &Scene::setShadowAtlasSize)
+            .addProperty("dynamicResolution", &Scene::isDynamicResolution, &Scene::setDynamicResolution)
+            .addFunction("getResolutionController", &Scene::getResolutionController)
+            .addFunction("getResolutionScale", &Scene::getResolutionScale)
             .endClass()
 
             .beginExtendClass<Camera, Object>("Camera")
@@ -550,9 +614,18 @@ void LuaBinding::registerClasses(lua_State *L){
             .addFunction("getTarget", &Light::getTarget)
             .addFunction("getDirection", &Light::getDirection)
             .addFunction("getPower", &Light::getPower)
+            .addFunction("getRange", &Light::getRange)
             .addFunction("getSpotAngle", &Light::getSpotAngle)
             .addFunction("setPower", &Light::setPower)
             .addFunction("setShadow", &Light::setShadow)
+            .addProperty("shadowUpdatePolicy", &Light::getShadowUpdatePolicy, &Light::setShadowUpdatePolicy)
+            .addProperty("shadowUpdateInterval", &Light::getShadowUpdateInterval, &Light::setShadowUpdateInterval)
+            .addFunction("invalidateShadow", &Light::invalidateShadow)
+            .addProperty("shadowMapSize", &Light::getShadowMapSize, &Light::setShadowMapSize)
+            .addConstant("SHADOW_UPDATE_ALWAYS", S_SHADOW_UPDATE_ALWAYS)
+            .addConstant("SHADOW_UPDATE_INTERVAL", S_SHADOW_UPDATE_INTERVAL)
+            .addConstant("SHADOW_UPDATE_ROUNDROBIN", S_SHADOW_UPDATE_ROUNDROBIN)
+            .addConstant("SHADOW_UPDATE_ONCHANGE", S_SHADOW_UPDATE_ONCHANGE)
             .endClass()
 
             .beginExtendClass<PointLight, Light>("PointLight")
@@ -576,6 +649,7 @@ void LuaBinding::registerClasses(lua_State *L){
             .addFunction("setColor", (void (GraphicObject::*)(float, float, float, float))&GraphicObject::setColor)
             .addFunction("setColorVector", (void (GraphicObject::*)(Vector4))&GraphicObject::setColor)
             .addFunction("setTexture", (void (GraphicObject::*)(std::string))&GraphicObject::setTexture)
+            .addProperty("castShadows", &GraphicObject::isCastShadows, &GraphicObject::setCastShadows)
             .endClass()
 
             .beginExtendClass<Mesh, GraphicObject>("Mesh")
@@ -669,6 +743,32 @@ void LuaBinding::registerClasses(lua_State *L){
 
             .beginExtendClass<Model, Mesh>("Model")
             .addConstructor(LUA_ARGS(LuaIntf::_opt<const char *>))
+            .addProperty("compactSkeleton", &Model::isCompactSkeleton, &Model::setCompactSkeleton)
+            .addProperty("animationCompression", &Model::isAnimationCompression, &Model::setAnimationCompression)
+            .addProperty("animationTolerance", &Model::getAnimationTolerance, &Model::setAnimationTolerance)
+            .addProperty("animationAngleTolerance", &Model::getAnimationAngleTolerance, &Model::setAnimationAngleTolerance)
+            .addProperty("animationLOD", &Model::isAnimationLOD, &Model::setAnimationLOD)
+            .addProperty("cpuMorphTargets", &Model::isCPUMorphTargets, &Model::setCPUMorphTargets)
+            .addProperty("pauseAnimationWhenCulled", &Model::isPauseAnimationWhenCulled, &Model::setPauseAnimationWhenCulled)
+            .addFunction("setAnimationLODDistances", &Model::setAnimationLODDistances)
+            .addFunction("getAnimationLODStep", &Model::getAnimationLODStep)
+            .addFunction("setAnimationBounds", &Model::setAnimationBounds)
+            .addFunction("clearAnimationBounds", &Model::clearAnimationBounds)
+            .addFunction("attachToBone", &Model::attachToBone)
+            .addFunction("detachFromBone", &Model::detachFromBone)
+            .addFunction("addAnimationLayer", &Model::addAnimationLayer)
+            .addFunction("removeAnimationLayer", &Model::removeAnimationLayer)
+            .addFunction("clearAnimationLayers", &Model::clearAnimationLayers)
+            .addFunction("getNumAnimationLayers", &Model::getNumAnimationLayers)
+            .addFunction("setLayerWeight", &Model::setLayerWeight)
+            .addFunction("getLayerWeight", &Model::getLayerWeight)
+            .addFunction("setLayerAdditive", &Model::setLayerAdditive)
+            .addFunction("isLayerAdditive", &Model::isLayerAdditive)
+            .addFunction("setLayerBoneMask", &Model::setLayerBoneMask)
+            .addFunction("fadeLayer", &Model::fadeLayer)
+            .addFunction("crossfade", &Model::crossfade)
+            .addFunction("getAnimation", &Model::getAnimation)
+            .addFunction("findAnimation", &Model::findAnimation)
             .endClass();
 
     LuaIntf::LuaBinding(L).beginClass<Vector2>("Vector2")
@@ -715,6 +815,10 @@ void LuaBinding::registerClasses(lua_State *L){
     LuaIntf::LuaBinding(L).beginClass<Sound>("Sound")
             .addConstructor(LUA_ARGS(LuaIntf::_opt<const char *>))
             .addFunction("load", &Sound::load)
+            .addFunction("loadAsync", &Sound::loadAsync)
+            .addFunction("getLoadState", &Sound::getLoadState)
+            .addProperty("loadState", &Sound::getLoadState)
+            .addProperty("onLoad", [] (Sound* sound) { return &sound->onLoad; }, [] (Sound* sound, lua_State* L) { sound->onLoad.add("luaFunction", L); })
             .addFunction("play", &Sound::play)
             .addFunction("stop", &Sound::stop)
             .endClass();
@@ -801,6 +905,13 @@ void LuaBinding::registerClasses(lua_State *L){
             .addConstructor(LUA_ARGS(LuaIntf::_opt<std::vector<int>>, LuaIntf::_opt<std::vector<int>>, LuaIntf::_opt<bool>))
             .endClass()
 
+            .beginExtendClass<Animation, Action>("Animation")
+            .addConstructor(LUA_ARGS(LuaIntf::_opt<std::string>, LuaIntf::_opt<bool>))
+            .addProperty("loop", &Animation::isLoop, &Animation::setLoop)
+            .addProperty("name", &Animation::getName, &Animation::setName)
+            .addFunction("setLimits", &Animation::setLimits)
+            .endClass()
+
             .beginExtendClass<ParticlesAnimation, Action>("ParticlesAnimation")
             .addConstructor(LUA_ARGS())
             .addFunction("addInit", &ParticlesAnimation::addInit)
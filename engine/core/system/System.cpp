@@ -23,6 +23,9 @@ using namespace Supernova;
 #ifdef  SUPERNOVA_WEB
 #include "SupernovaWeb.h"
 #endif
+#ifdef  SUPERNOVA_TEST
+#include "SupernovaTest.h"
+#endif
 
 System& System::instance(){
 #ifdef SUPERNOVA_ANDROID
@@ -34,6 +37,9 @@ System& System::instance(){
 #ifdef  SUPERNOVA_WEB
     static System *instance = new SupernovaWeb();
 #endif
+#ifdef  SUPERNOVA_TEST
+    static System *instance = new SupernovaTest();
+#endif
 
     return *instance;
 }
@@ -12,6 +12,7 @@ Text::Text(): Mesh2D() {
     submeshes.push_back(new Submesh());
     dynamic = true;
     stbtext = new STBText();
+    preloadedFontData = NULL;
     font = "";
     text = "";
     fontSize = 40;
@@ -35,6 +36,10 @@ Text::Text(std::string font): Text() {
 }
 
 Text::~Text() {
+    cancelLoadAsync();
+
+    if (preloadedFontData)
+        delete preloadedFontData;
     delete stbtext;
 }
 
@@ -185,8 +190,24 @@ void Text::createText(){
     submeshes[0]->setIndices("indices", indices_array.size());
 }
 
+bool Text::preload(){
+    if (preloadedFontData)
+        delete preloadedFontData;
+
+    preloadedFontData = stbtext->load(font, fontSize);
+    if (!preloadedFontData) {
+        return false;
+    }
+
+    return Mesh2D::preload();
+}
+
 bool Text::load(){
-    TextureData* textureData = stbtext->load(font, fontSize);
+    TextureData* textureData = preloadedFontData;
+    preloadedFontData = NULL;
+
+    if (!textureData)
+        textureData = stbtext->load(font, fontSize);
     if (!textureData) {
         return false;
     }
@@ -15,6 +15,7 @@ namespace Supernova {
         IndexBuffer indices;
         
         STBText* stbtext;
+        TextureData* preloadedFontData;
 
         std::string font;
         std::string text;
@@ -29,6 +30,8 @@ namespace Supernova {
     protected:
         void createText();
 
+        virtual bool preload();
+
     public:
         Text();
         Text(std::string font);
@@ -0,0 +1,172 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "AsyncLoader.h"
+#include "ThreadPool.h"
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+using namespace Supernova;
+
+ThreadPool* AsyncLoader::pool = NULL;
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+unsigned int AsyncLoader::numThreads = 0;
+#else
+unsigned int AsyncLoader::numThreads = (std::thread::hardware_concurrency() > 2) ? std::thread::hardware_concurrency() - 1 : 1;
+#endif
+
+std::list<std::shared_ptr<AsyncLoader::Task>> AsyncLoader::tasks;
+std::mutex AsyncLoader::tasksMutex;
+std::condition_variable AsyncLoader::taskDone;
+
+void AsyncLoader::init(){
+    if (!pool && numThreads > 0){
+        pool = new ThreadPool(numThreads);
+    }
+}
+
+void AsyncLoader::deInit(){
+    if (pool){
+        //Waits for all queued tasks
+        delete pool;
+        pool = NULL;
+    }
+}
+
+void AsyncLoader::setNumThreads(unsigned int numThreads){
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    numThreads = 0;
+#endif
+    if (AsyncLoader::numThreads != numThreads){
+        deInit();
+        AsyncLoader::numThreads = numThreads;
+    }
+}
+
+unsigned int AsyncLoader::getNumThreads(){
+    return numThreads;
+}
+
+void AsyncLoader::runTask(std::shared_ptr<Task> task){
+    {
+        std::unique_lock<std::mutex> lock(tasksMutex);
+        if (task->cancelled)
+            return;
+        task->state = RUNNING;
+    }
+
+    //Members are not changed while task is running
+    bool success = task->work(task->members);
+
+    {
+        std::unique_lock<std::mutex> lock(tasksMutex);
+        task->success = success;
+        task->state = DONE;
+    }
+    taskDone.notify_all();
+}
+
+void AsyncLoader::add(const void* owner, std::function<bool()> work, std::function<void(bool)> complete){
+    add(owner, std::vector<void*>(), [work](const std::vector<void*>&){
+        return work();
+    }, complete);
+}
+
+void AsyncLoader::add(const void* owner, std::vector<void*> members, std::function<bool(const std::vector<void*>&)> work, std::function<void(bool)> complete){
+    std::shared_ptr<Task> task = std::make_shared<Task>();
+    task->owner = owner;
+    task->members = members;
+    task->work = work;
+    task->complete = complete;
+    task->state = PENDING;
+    task->success = false;
+    task->cancelled = false;
+
+    {
+        std::unique_lock<std::mutex> lock(tasksMutex);
+        tasks.push_back(task);
+    }
+
+    init();
+
+    //Without loader threads work is done in main thread by processCompleted
+    if (pool)
+        pool->enqueue([task](){ runTask(task); });
+}
+
+void AsyncLoader::cancel(const void* owner){
+    std::unique_lock<std::mutex> lock(tasksMutex);
+
+    taskDone.wait(lock, [owner](){
+        for (auto it = tasks.begin(); it != tasks.end(); ++it){
+            if ((*it)->state != RUNNING)
+                continue;
+            if ((*it)->owner == owner)
+                return false;
+            if (std::find((*it)->members.begin(), (*it)->members.end(), owner) != (*it)->members.end())
+                return false;
+        }
+        return true;
+    });
+
+    for (auto it = tasks.begin(); it != tasks.end();){
+        if ((*it)->owner == owner){
+            (*it)->cancelled = true;
+            it = tasks.erase(it);
+        }else{
+            //Done tasks have already used members
+            if ((*it)->state == PENDING){
+                std::vector<void*>& members = (*it)->members;
+                members.erase(std::remove(members.begin(), members.end(), owner), members.end());
+            }
+            ++it;
+        }
+    }
+}
+
+bool AsyncLoader::hasPending(){
+    std::unique_lock<std::mutex> lock(tasksMutex);
+    return !tasks.empty();
+}
+
+unsigned int AsyncLoader::processCompleted(float timeBudget){
+    auto start = std::chrono::steady_clock::now();
+    unsigned int processed = 0;
+
+    while (true){
+        std::shared_ptr<Task> task;
+
+        {
+            std::unique_lock<std::mutex> lock(tasksMutex);
+            for (auto it = tasks.begin(); it != tasks.end(); ++it){
+                if ((*it)->state == DONE || (!pool && (*it)->state == PENDING)){
+                    task = *it;
+                    tasks.erase(it);
+                    break;
+                }
+            }
+        }
+
+        if (!task)
+            break;
+
+        if (task->state == PENDING){
+            task->success = task->work(task->members);
+            task->state = DONE;
+        }
+
+        if (task->complete)
+            task->complete(task->success);
+
+        processed++;
+
+        //At least one task is completed per frame
+        std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+        if (elapsed.count() >= timeBudget)
+            break;
+    }
+
+    return processed;
+}
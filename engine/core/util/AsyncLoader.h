@@ -0,0 +1,74 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef ASYNCLOADER_H
+#define ASYNCLOADER_H
+
+#define S_LOADSTATE_NONE 0
+#define S_LOADSTATE_LOADING 1
+#define S_LOADSTATE_LOADED 2
+#define S_LOADSTATE_FAILED 3
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+
+namespace Supernova {
+
+    class ThreadPool;
+
+    class AsyncLoader {
+    private:
+
+        enum TaskState{
+            PENDING,
+            RUNNING,
+            DONE
+        };
+
+        struct Task{
+            const void* owner;
+            //Other objects used by work, a cancelled one is only removed from list
+            std::vector<void*> members;
+            std::function<bool(const std::vector<void*>&)> work;
+            std::function<void(bool)> complete;
+            TaskState state;
+            bool success;
+            bool cancelled;
+        };
+
+        static ThreadPool* pool;
+        static unsigned int numThreads;
+
+        static std::list<std::shared_ptr<Task>> tasks;
+        static std::mutex tasksMutex;
+        static std::condition_variable taskDone;
+
+        static void runTask(std::shared_ptr<Task> task);
+
+    public:
+
+        static void init();
+        static void deInit();
+
+        static void setNumThreads(unsigned int numThreads);
+        static unsigned int getNumThreads();
+
+        //work is called in a loader thread and must not touch render API, complete is called in main thread
+        static void add(const void* owner, std::function<bool()> work, std::function<void(bool)> complete);
+        //Members list is made in main thread, work must use it instead of reading them from owner
+        static void add(const void* owner, std::vector<void*> members, std::function<bool(const std::vector<void*>&)> work, std::function<void(bool)> complete);
+        //Waits running work of owner or using it as member, then discards pending one
+        static void cancel(const void* owner);
+
+        static bool hasPending();
+        static unsigned int processCompleted(float timeBudget);
+    };
+
+}
+
+#endif //ASYNCLOADER_H
@@ -0,0 +1,66 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "BonePartition.h"
+#include <algorithm>
+
+using namespace Supernova;
+
+std::vector<BonePartition::Batch> BonePartition::partition(const std::vector<unsigned int>& indices, const std::vector<int>& vertexBones, size_t maxBones){
+    std::vector<Batch> batches;
+
+    size_t vertexCount = vertexBones.size() / 4;
+
+    for (size_t t = 0; t + 2 < indices.size(); t += 3){
+        std::vector<int> triangleBones;
+
+        for (int v = 0; v < 3; v++){
+            unsigned int vertex = indices[t + v];
+            if (vertex >= vertexCount)
+                continue;
+
+            for (int j = 0; j < 4; j++){
+                int bone = vertexBones[vertex * 4 + j];
+                if (bone >= 0 && std::find(triangleBones.begin(), triangleBones.end(), bone) == triangleBones.end())
+                    triangleBones.push_back(bone);
+            }
+        }
+
+        //First batch where missing bones fit
+        size_t b = 0;
+        for (; b < batches.size(); b++){
+            size_t missing = 0;
+            for (size_t i = 0; i < triangleBones.size(); i++){
+                if (getSlot(batches[b], triangleBones[i]) < 0)
+                    missing++;
+            }
+
+            if (batches[b].bones.size() + missing <= maxBones)
+                break;
+        }
+
+        if (b == batches.size())
+            batches.push_back(Batch());
+
+        for (size_t i = 0; i < triangleBones.size(); i++){
+            if (getSlot(batches[b], triangleBones[i]) < 0)
+                batches[b].bones.push_back(triangleBones[i]);
+        }
+
+        batches[b].indices.push_back(indices[t]);
+        batches[b].indices.push_back(indices[t + 1]);
+        batches[b].indices.push_back(indices[t + 2]);
+    }
+
+    return batches;
+}
+
+int BonePartition::getSlot(const Batch& batch, int bone){
+    for (size_t i = 0; i < batch.bones.size(); i++){
+        if (batch.bones[i] == bone)
+            return (int)i;
+    }
+
+    return -1;
+}
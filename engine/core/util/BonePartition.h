@@ -0,0 +1,32 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef BONEPARTITION_H
+#define BONEPARTITION_H
+
+#include <vector>
+#include <stddef.h>
+
+namespace Supernova {
+
+    //Splits skinned triangles in batches that use at most maxBones, without render dependencies
+    class BonePartition {
+    public:
+        struct Batch{
+            //Triangle indices of original vertices
+            std::vector<unsigned int> indices;
+            //Palette slot to original bone
+            std::vector<int> bones;
+        };
+
+        //Vertex bones have 4 values for each vertex, -1 or zero weight joints are not used
+        static std::vector<Batch> partition(const std::vector<unsigned int>& indices, const std::vector<int>& vertexBones, size_t maxBones);
+
+        //Slot of bone in batch palette, -1 if batch does not use it
+        static int getSlot(const Batch& batch, int bone);
+    };
+
+}
+
+#endif //BONEPARTITION_H
@@ -10,6 +10,7 @@
 #define FUNCTIONSUBSCRIBE_H
 
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 #include "Function.h"
@@ -139,6 +140,10 @@ namespace Supernova {
             return true;
         }
 
+        size_t size() const{
+            return functions.size();
+        }
+
         void call(Args... args){
             for (auto& function : functions)
             {
@@ -0,0 +1,252 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "JobSystem.h"
+#include "Log.h"
+
+using namespace Supernova;
+
+JobCounter::JobCounter(){
+    value = 0;
+}
+
+int JobCounter::get() const{
+    return value.load();
+}
+
+bool JobCounter::isDone() const{
+    return (value.load() <= 0);
+}
+
+std::vector<std::thread> JobSystem::threads;
+std::vector<std::unique_ptr<JobSystem::Worker>> JobSystem::workers;
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+unsigned int JobSystem::numThreads = 0;
+#else
+unsigned int JobSystem::numThreads = (std::thread::hardware_concurrency() > 1) ? std::thread::hardware_concurrency() - 1 : 0;
+#endif
+bool JobSystem::inited = false;
+
+std::atomic<bool> JobSystem::running(false);
+std::atomic<int> JobSystem::pendingJobs(0);
+std::atomic<unsigned int> JobSystem::nextWorker(0);
+
+std::mutex JobSystem::sleepMutex;
+std::condition_variable JobSystem::wakeCondition;
+
+thread_local int JobSystem::workerIndex = -1;
+
+void JobSystem::init(){
+    if (inited)
+        return;
+
+    workerIndex = 0;
+    running = true;
+
+    for (unsigned int i = 0; i <= numThreads; i++){
+        workers.push_back(std::unique_ptr<Worker>(new Worker()));
+    }
+
+    for (unsigned int i = 1; i <= numThreads; i++){
+        threads.emplace_back(&JobSystem::workerLoop, i);
+    }
+
+    inited = true;
+}
+
+void JobSystem::deInit(){
+    if (!inited)
+        return;
+
+    //Finishes remaining jobs before stopping workers
+    while (executeNext()) {}
+
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wakeCondition.notify_all();
+
+    for (size_t i = 0; i < threads.size(); i++){
+        threads[i].join();
+    }
+
+    threads.clear();
+    workers.clear();
+    workerIndex = -1;
+
+    inited = false;
+}
+
+void JobSystem::setNumThreads(unsigned int numThreads){
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    numThreads = 0;
+#endif
+    if (JobSystem::numThreads == numThreads)
+        return;
+
+    if (pendingJobs > 0){
+        Log::Error("Can not change number of job threads while jobs are pending");
+        return;
+    }
+
+    bool wasInited = inited;
+    deInit();
+    JobSystem::numThreads = numThreads;
+    if (wasInited)
+        init();
+}
+
+unsigned int JobSystem::getNumThreads(){
+    return numThreads;
+}
+
+bool JobSystem::isWorkerThread(){
+    return (workerIndex > 0);
+}
+
+bool JobSystem::popJob(unsigned int index, Job& job){
+    Worker* worker = workers[index].get();
+
+    std::unique_lock<std::mutex> lock(worker->mutex);
+    if (worker->jobs.empty())
+        return false;
+
+    //Owner takes newest job (LIFO)
+    job = std::move(worker->jobs.back());
+    worker->jobs.pop_back();
+    pendingJobs--;
+
+    return true;
+}
+
+bool JobSystem::stealJob(unsigned int thief, Job& job){
+    unsigned int count = (unsigned int)workers.size();
+
+    for (unsigned int i = 1; i < count; i++){
+        Worker* victim = workers[(thief + i) % count].get();
+
+        std::unique_lock<std::mutex> lock(victim->mutex);
+        if (!victim->jobs.empty()){
+            //Thieves take oldest job (FIFO), usually the biggest one
+            job = std::move(victim->jobs.front());
+            victim->jobs.pop_front();
+            pendingJobs--;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool JobSystem::executeNext(){
+    if (workers.empty())
+        return false;
+
+    Job job;
+    unsigned int index = (workerIndex >= 0) ? (unsigned int)workerIndex : 0;
+
+    bool found = false;
+    if (workerIndex >= 0)
+        found = popJob(index, job);
+    if (!found)
+        found = stealJob(index, job);
+    if (!found && workerIndex < 0)
+        found = popJob(index, job);
+
+    if (!found)
+        return false;
+
+    job.function();
+
+    if (job.counter)
+        job.counter->value--;
+
+    return true;
+}
+
+void JobSystem::workerLoop(unsigned int index){
+    workerIndex = (int)index;
+
+    while (running){
+        if (!executeNext()){
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wakeCondition.wait(lock, [](){ return !running || pendingJobs > 0; });
+        }
+    }
+}
+
+void JobSystem::run(std::function<void()> job, JobCounter* counter){
+    init();
+
+    if (counter)
+        counter->value++;
+
+    if (numThreads == 0){
+        job();
+        if (counter)
+            counter->value--;
+        return;
+    }
+
+    unsigned int index;
+    if (workerIndex >= 0){
+        index = (unsigned int)workerIndex;
+    }else{
+        index = nextWorker.fetch_add(1) % workers.size();
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(workers[index]->mutex);
+        workers[index]->jobs.push_back({job, counter});
+        pendingJobs++;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+    }
+    wakeCondition.notify_one();
+}
+
+void JobSystem::wait(JobCounter* counter){
+    if (!counter)
+        return;
+
+    //Waiting thread helps executing jobs until counter is done
+    while (!counter->isDone()){
+        if (!executeNext())
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, std::function<void(size_t, size_t)> function){
+    if (count == 0)
+        return;
+
+    init();
+
+    if (grainSize == 0){
+        grainSize = count / ((numThreads + 1) * 4);
+        if (grainSize == 0)
+            grainSize = 1;
+    }
+
+    if (numThreads == 0 || count <= grainSize){
+        function(0, count);
+        return;
+    }
+
+    JobCounter counter;
+
+    for (size_t begin = grainSize; begin < count; begin += grainSize){
+        size_t end = (begin + grainSize < count) ? begin + grainSize : count;
+        run([&function, begin, end](){ function(begin, end); }, &counter);
+    }
+
+    //First range is done by calling thread
+    function(0, grainSize);
+
+    wait(&counter);
+}
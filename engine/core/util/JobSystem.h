@@ -0,0 +1,89 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+
+namespace Supernova {
+
+    class JobSystem;
+
+    class JobCounter {
+
+        friend class JobSystem;
+
+    private:
+        std::atomic<int> value;
+
+    public:
+        JobCounter();
+
+        int get() const;
+        bool isDone() const;
+    };
+
+    class JobSystem {
+    private:
+
+        struct Job{
+            std::function<void()> function;
+            JobCounter* counter;
+        };
+
+        struct Worker{
+            std::deque<Job> jobs;
+            std::mutex mutex;
+        };
+
+        static std::vector<std::thread> threads;
+        //Index 0 is the thread that called init (main thread)
+        static std::vector<std::unique_ptr<Worker>> workers;
+        static unsigned int numThreads;
+        static bool inited;
+
+        static std::atomic<bool> running;
+        static std::atomic<int> pendingJobs;
+        static std::atomic<unsigned int> nextWorker;
+
+        static std::mutex sleepMutex;
+        static std::condition_variable wakeCondition;
+
+        static thread_local int workerIndex;
+
+        static bool popJob(unsigned int index, Job& job);
+        static bool stealJob(unsigned int thief, Job& job);
+        static bool executeNext();
+
+        static void workerLoop(unsigned int index);
+
+    public:
+
+        static void init();
+        static void deInit();
+
+        //Number of worker threads besides main thread, only changed when there is no job running
+        static void setNumThreads(unsigned int numThreads);
+        static unsigned int getNumThreads();
+
+        static bool isWorkerThread();
+
+        static void run(std::function<void()> job, JobCounter* counter = NULL);
+        static void wait(JobCounter* counter);
+
+        //Splits [0, count) in ranges of grainSize (0 for automatic) and waits all of them
+        static void parallelFor(size_t count, size_t grainSize, std::function<void(size_t, size_t)> function);
+    };
+
+}
+
+#endif //JOBSYSTEM_H
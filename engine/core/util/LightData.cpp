@@ -1,151 +1,294 @@
 #include "LightData.h"
 #include "DirectionalLight.h"
 #include "math/Angle.h"
+#include "Log.h"
+#include <algorithm>
 
 
 using namespace Supernova;
 
 LightData::LightData(){
     ambientLight = NULL;
+    version = 0;
+
+    numPointLight = 0;
+    numSpotLight = 0;
+    numDirectionalLight = 0;
+    numShadows2D = 0;
+    numShadowsCube = 0;
+
+    lightsCapacity = 0;
+    shadowsCapacity = 0;
+    storageVersion = 0;
+
+    reserveStorage(S_LIGHTDATA_RESERVED_LIGHTS, S_LIGHTDATA_RESERVED_SHADOWS);
 }
 
 LightData::~LightData(){
     
 }
 
-bool LightData::updateLights(std::vector<Light*>* lights, Vector3* ambientLight){
-    
-    this->ambientLight = ambientLight;
-    
+void LightData::reserveStorage(int lights, int shadows){
+    lightsCapacity = lights;
+    shadowsCapacity = shadows;
+
+    this->pointLightPos.reserve(lights * 3);
+    this->pointLightColor.reserve(lights * 3);
+    this->pointLightPower.reserve(lights);
+    this->pointLightShadowIdx.reserve(lights);
+    this->pointLightRange.reserve(lights);
+
+    this->spotLightPos.reserve(lights * 3);
+    this->spotLightColor.reserve(lights * 3);
+    this->spotLightTarget.reserve(lights * 3);
+    this->spotLightPower.reserve(lights);
+    this->spotLightCutOff.reserve(lights);
+    this->spotLightOuterCutOff.reserve(lights);
+    this->spotLightShadowIdx.reserve(lights);
+    this->spotLightRange.reserve(lights);
+
+    this->directionalLightDir.reserve(lights * 3);
+    this->directionalLightColor.reserve(lights * 3);
+    this->directionalLightPower.reserve(lights);
+    this->directionalLightShadowIdx.reserve(lights);
+
+    this->shadowsRect2D.reserve(shadows);
+    this->shadowsVPMatrix.reserve(shadows);
+    this->shadowsBias2D.reserve(shadows);
+    this->shadowsCameraNearFar2D.reserve(shadows);
+    this->shadowNumCascades2D.reserve(shadows);
+
+    this->shadowsRectCube.reserve(shadows);
+    this->shadowsBiasCube.reserve(shadows);
+    this->shadowsCameraNearFarCube.reserve(shadows);
+}
+
+bool LightData::isLayoutChanged(std::vector<Light*>* lights){
+    if (lights->size() != slots.size())
+        return true;
+
+    for (int i = 0; i < (int)lights->size(); i++){
+        Light* light = lights->at(i);
+        if (slots[i].light != light || slots[i].type != light->getType() || slots[i].useShadow != light->isUseShadow())
+            return true;
+
+        if (light->getType() == S_DIRECTIONAL_LIGHT && light->isUseShadow()){
+            if (slots[i].numShadows != ((DirectionalLight*)light)->getNumShadowCascades())
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void LightData::createLayout(std::vector<Light*>* lights){
     this->numPointLight = 0;
-    this->pointLightPos.clear();
-    this->pointLightColor.clear();
-    this->pointLightPower.clear();
-    this->pointLightShadowIdx.clear();
-    
     this->numSpotLight = 0;
-    this->spotLightPos.clear();
-    this->spotLightColor.clear();
-    this->spotLightTarget.clear();
-    this->spotLightPower.clear();
-    this->spotLightCutOff.clear();
-    this->spotLightOuterCutOff.clear();
-    this->spotLightShadowIdx.clear();
-    
     this->numDirectionalLight = 0;
-    this->directionalLightDir.clear();
-    this->directionalLightColor.clear();
-    this->directionalLightPower.clear();
-    this->directionalLightShadowIdx.clear();
-
     this->numShadows2D = 0;
     this->numShadowsCube = 0;
-    this->shadowsMap2D.clear();
-    this->shadowsMapCube.clear();
-    this->shadowsVPMatrix.clear();
-    this->shadowsBias2D.clear();
-    this->shadowsBiasCube.clear();
-    this->shadowsCameraNearFar2D.clear();
-    this->shadowsCameraNearFarCube.clear();
-    this->shadowNumCascades2D.clear();
-
-    for ( int i = 0; i < (int)lights->size(); i++){
-        if (lights->at(i)->getType() == S_POINT_LIGHT){
-            this->numPointLight++;
-            
-            this->pointLightPos.push_back(lights->at(i)->getWorldPosition().x);
-            this->pointLightPos.push_back(lights->at(i)->getWorldPosition().y);
-            this->pointLightPos.push_back(lights->at(i)->getWorldPosition().z);
-            
-            this->pointLightColor.push_back(lights->at(i)->getColor().x);
-            this->pointLightColor.push_back(lights->at(i)->getColor().y);
-            this->pointLightColor.push_back(lights->at(i)->getColor().z);
-            
-            this->pointLightPower.push_back(lights->at(i)->getPower());
-            
-            if (lights->at(i)->isUseShadow()){
-                this->pointLightShadowIdx.push_back(this->numShadowsCube);
-            }else{
-                this->pointLightShadowIdx.push_back(-1);
+
+    slots.resize(lights->size());
+
+    for (int i = 0; i < (int)lights->size(); i++){
+        Light* light = lights->at(i);
+
+        slots[i].light = light;
+        slots[i].type = light->getType();
+        slots[i].useShadow = light->isUseShadow();
+        slots[i].numShadows = 0;
+        slots[i].shadowIndex = -1;
+
+        if (light->getType() == S_POINT_LIGHT){
+            slots[i].index = this->numPointLight++;
+            if (light->isUseShadow()){
+                slots[i].numShadows = 1;
+                slots[i].shadowIndex = this->numShadowsCube;
+                this->numShadowsCube++;
             }
-        }
-        if (lights->at(i)->getType() == S_SPOT_LIGHT){
-            this->numSpotLight++;
-            
-            this->spotLightPos.push_back(lights->at(i)->getWorldPosition().x);
-            this->spotLightPos.push_back(lights->at(i)->getWorldPosition().y);
-            this->spotLightPos.push_back(lights->at(i)->getWorldPosition().z);
-            
-            this->spotLightColor.push_back(lights->at(i)->getColor().x);
-            this->spotLightColor.push_back(lights->at(i)->getColor().y);
-            this->spotLightColor.push_back(lights->at(i)->getColor().z);
-            
-            this->spotLightTarget.push_back(lights->at(i)->getWorldTarget().x);
-            this->spotLightTarget.push_back(lights->at(i)->getWorldTarget().y);
-            this->spotLightTarget.push_back(lights->at(i)->getWorldTarget().z);
-            
-            this->spotLightPower.push_back(lights->at(i)->getPower());
-            
-            this->spotLightCutOff.push_back(cos(lights->at(i)->getSpotAngle() / 2.0));
-            this->spotLightOuterCutOff.push_back(cos(lights->at(i)->getSpotOuterAngle() / 2.0));
-            
-            if (lights->at(i)->isUseShadow()){
-                this->spotLightShadowIdx.push_back(this->numShadows2D);
-            }else{
-                this->spotLightShadowIdx.push_back(-1);
+        }else if (light->getType() == S_SPOT_LIGHT){
+            slots[i].index = this->numSpotLight++;
+            if (light->isUseShadow()){
+                slots[i].numShadows = 1;
+                slots[i].shadowIndex = this->numShadows2D;
+                this->numShadows2D++;
             }
-        }
-        if (lights->at(i)->getType() == S_DIRECTIONAL_LIGHT){
-            this->numDirectionalLight++;
-            
-            this->directionalLightDir.push_back(lights->at(i)->getDirection().x);
-            this->directionalLightDir.push_back(lights->at(i)->getDirection().y);
-            this->directionalLightDir.push_back(lights->at(i)->getDirection().z);
-            
-            this->directionalLightColor.push_back(lights->at(i)->getColor().x);
-            this->directionalLightColor.push_back(lights->at(i)->getColor().y);
-            this->directionalLightColor.push_back(lights->at(i)->getColor().z);
-            
-            this->directionalLightPower.push_back(lights->at(i)->getPower());
-            
-            if (lights->at(i)->isUseShadow()){
-                this->directionalLightShadowIdx.push_back(this->numShadows2D);
-            }else{
-                this->directionalLightShadowIdx.push_back(-1);
+        }else if (light->getType() == S_DIRECTIONAL_LIGHT){
+            slots[i].index = this->numDirectionalLight++;
+            if (light->isUseShadow()){
+                slots[i].numShadows = ((DirectionalLight*)light)->getNumShadowCascades();
+                slots[i].shadowIndex = this->numShadows2D;
+                this->numShadows2D += slots[i].numShadows;
             }
         }
+    }
 
-        if (lights->at(i)->isUseShadow()){
+    //Resize inside reserved capacity keeps data address, only growing beyond it reallocates
+    int numLights = std::max(this->numPointLight, std::max(this->numSpotLight, this->numDirectionalLight));
+    int numShadows = std::max(this->numShadows2D, this->numShadowsCube);
+    if (numLights > lightsCapacity || numShadows > shadowsCapacity){
+        Log::Warn("Light data storage is growing, loaded objects will be reloaded");
+        reserveStorage(std::max(numLights, lightsCapacity * 2), std::max(numShadows, shadowsCapacity * 2));
+        storageVersion++;
+    }
 
-            if (lights->at(i)->getType() == S_SPOT_LIGHT) {
-                this->numShadows2D++;
-                this->shadowsMap2D.push_back(lights->at(i)->getShadowMap());
-                this->shadowsVPMatrix.push_back(lights->at(i)->getDepthVPMatrix());
-                this->shadowsBias2D.push_back(lights->at(i)->getShadowBias());
-                this->shadowsCameraNearFar2D.push_back(lights->at(i)->getLightCamera()->getNearFarPlane());
-                this->shadowNumCascades2D.push_back(0);
-
-            }else if (lights->at(i)->getType() == S_DIRECTIONAL_LIGHT) {
-                for (int ca = 0; ca < ((DirectionalLight*)lights->at(i))->getNumShadowCascades(); ca++) {
-                    this->numShadows2D++;
-                    this->shadowsMap2D.push_back(lights->at(i)->getShadowMap(ca));
-                    this->shadowsVPMatrix.push_back(lights->at(i)->getDepthVPMatrix(ca));
-                    this->shadowsBias2D.push_back(lights->at(i)->getShadowBias());
-                    this->shadowsCameraNearFar2D.push_back(((DirectionalLight *) lights->at(i))->getCascadeCameraNearFar(ca));
-                    this->shadowNumCascades2D.push_back(((DirectionalLight *) lights->at(i))->getNumShadowCascades());
-                }
-            }else if (lights->at(i)->getType() == S_POINT_LIGHT) {
-                this->numShadowsCube++;
-                this->shadowsMapCube.push_back(lights->at(i)->getShadowMap());
-                this->shadowsBiasCube.push_back(lights->at(i)->getShadowBias());
-                this->shadowsCameraNearFarCube.push_back(lights->at(i)->getLightCamera()->getNearFarPlane());
-            }
+    this->pointLightPos.resize(this->numPointLight * 3);
+    this->pointLightColor.resize(this->numPointLight * 3);
+    this->pointLightPower.resize(this->numPointLight);
+    this->pointLightShadowIdx.resize(this->numPointLight);
+    this->pointLightRange.resize(this->numPointLight);
+
+    this->spotLightPos.resize(this->numSpotLight * 3);
+    this->spotLightColor.resize(this->numSpotLight * 3);
+    this->spotLightTarget.resize(this->numSpotLight * 3);
+    this->spotLightPower.resize(this->numSpotLight);
+    this->spotLightCutOff.resize(this->numSpotLight);
+    this->spotLightOuterCutOff.resize(this->numSpotLight);
+    this->spotLightShadowIdx.resize(this->numSpotLight);
+    this->spotLightRange.resize(this->numSpotLight);
+
+    this->directionalLightDir.resize(this->numDirectionalLight * 3);
+    this->directionalLightColor.resize(this->numDirectionalLight * 3);
+    this->directionalLightPower.resize(this->numDirectionalLight);
+    this->directionalLightShadowIdx.resize(this->numDirectionalLight);
+
+    this->shadowsRect2D.resize(this->numShadows2D);
+    this->shadowsVPMatrix.resize(this->numShadows2D);
+    this->shadowsBias2D.resize(this->numShadows2D);
+    this->shadowsCameraNearFar2D.resize(this->numShadows2D);
+    this->shadowNumCascades2D.resize(this->numShadows2D);
 
+    this->shadowsRectCube.resize(this->numShadowsCube);
+    this->shadowsBiasCube.resize(this->numShadowsCube);
+    this->shadowsCameraNearFarCube.resize(this->numShadowsCube);
+}
+
+void LightData::updateLight(const LightSlot& slot){
+    Light* light = slot.light;
+    int i = slot.index;
+
+    if (slot.type == S_POINT_LIGHT){
+        Vector3 position = light->getWorldPosition();
+        Vector3 color = light->getColor();
+
+        this->pointLightPos[i*3] = position.x;
+        this->pointLightPos[i*3+1] = position.y;
+        this->pointLightPos[i*3+2] = position.z;
+
+        this->pointLightColor[i*3] = color.x;
+        this->pointLightColor[i*3+1] = color.y;
+        this->pointLightColor[i*3+2] = color.z;
+
+        this->pointLightPower[i] = light->getPower();
+        this->pointLightRange[i] = light->getRange();
+        this->pointLightShadowIdx[i] = slot.shadowIndex;
+
+        if (slot.useShadow){
+            this->shadowsRectCube[slot.shadowIndex] = light->getShadowAtlasRect(0);
+            this->shadowsBiasCube[slot.shadowIndex] = light->getShadowBias();
+            this->shadowsCameraNearFarCube[slot.shadowIndex] = light->getLightCamera()->getNearFarPlane();
         }
     }
+
+    if (slot.type == S_SPOT_LIGHT){
+        Vector3 position = light->getWorldPosition();
+        Vector3 color = light->getColor();
+        Vector3 target = light->getWorldTarget();
+
+        this->spotLightPos[i*3] = position.x;
+        this->spotLightPos[i*3+1] = position.y;
+        this->spotLightPos[i*3+2] = position.z;
+
+        this->spotLightColor[i*3] = color.x;
+        this->spotLightColor[i*3+1] = color.y;
+        this->spotLightColor[i*3+2] = color.z;
+
+        this->spotLightTarget[i*3] = target.x;
+        this->spotLightTarget[i*3+1] = target.y;
+        this->spotLightTarget[i*3+2] = target.z;
+
+        this->spotLightPower[i] = light->getPower();
+        this->spotLightRange[i] = light->getRange();
+
+        this->spotLightCutOff[i] = cos(light->getSpotAngle() / 2.0);
+        this->spotLightOuterCutOff[i] = cos(light->getSpotOuterAngle() / 2.0);
+        this->spotLightShadowIdx[i] = slot.shadowIndex;
+
+        if (slot.useShadow){
+            this->shadowsRect2D[slot.shadowIndex] = light->getShadowAtlasRect(0);
+            this->shadowsVPMatrix[slot.shadowIndex] = light->getDepthVPMatrix();
+            this->shadowsBias2D[slot.shadowIndex] = light->getShadowBias();
+            this->shadowsCameraNearFar2D[slot.shadowIndex] = light->getLightCamera()->getNearFarPlane();
+            this->shadowNumCascades2D[slot.shadowIndex] = 0;
+        }
+    }
+
+    if (slot.type == S_DIRECTIONAL_LIGHT){
+        Vector3 direction = light->getDirection();
+        Vector3 color = light->getColor();
+
+        this->directionalLightDir[i*3] = direction.x;
+        this->directionalLightDir[i*3+1] = direction.y;
+        this->directionalLightDir[i*3+2] = direction.z;
+
+        this->directionalLightColor[i*3] = color.x;
+        this->directionalLightColor[i*3+1] = color.y;
+        this->directionalLightColor[i*3+2] = color.z;
+
+        this->directionalLightPower[i] = light->getPower();
+        this->directionalLightShadowIdx[i] = slot.shadowIndex;
+
+        for (int ca = 0; ca < slot.numShadows; ca++) {
+            int s = slot.shadowIndex + ca;
+            this->shadowsRect2D[s] = light->getShadowAtlasRect(ca);
+            this->shadowsVPMatrix[s] = light->getDepthVPMatrix(ca);
+            this->shadowsBias2D[s] = light->getShadowBias();
+            this->shadowsCameraNearFar2D[s] = ((DirectionalLight*)light)->getCascadeCameraNearFar(ca);
+            this->shadowNumCascades2D[s] = slot.numShadows;
+        }
+    }
+
+    light->lightDataDirty = false;
+}
+
+bool LightData::updateLights(std::vector<Light*>* lights, Vector3* ambientLight){
+
+    bool changed = false;
+
+    if (this->ambientLight != ambientLight){
+        this->ambientLight = ambientLight;
+        changed = true;
+    }
+
+    if (isLayoutChanged(lights)){
+        createLayout(lights);
+
+        for (int i = 0; i < (int)slots.size(); i++){
+            updateLight(slots[i]);
+        }
+        changed = true;
+    }else{
+        for (int i = 0; i < (int)slots.size(); i++){
+            if (slots[i].light->lightDataDirty){
+                updateLight(slots[i]);
+                changed = true;
+            }
+        }
+    }
+
+    if (changed)
+        version++;
     
     if ((int)lights->size() > 0){
         return true;
     }
     return false;
 }
+
+unsigned long LightData::getStorageVersion(){
+    return storageVersion;
+}
+
+unsigned long LightData::getVersion(){
+    return version;
+}
@@ -1,13 +1,42 @@
 #ifndef LightData_h
 #define LightData_h
 
+//Lights and shadows reserved at start, render keeps pointers to this storage
+#define S_LIGHTDATA_RESERVED_LIGHTS 32
+#define S_LIGHTDATA_RESERVED_SHADOWS 32
+
 #include <vector>
 #include "math/Vector3.h"
+#include "math/Vector4.h"
 #include <Light.h>
 
 namespace Supernova {
 
     class LightData {
+
+    private:
+
+        //Where each light is written in arrays
+        struct LightSlot {
+            Light* light;
+            int type;
+            bool useShadow;
+            int numShadows;
+            int index;
+            int shadowIndex;
+        };
+
+        std::vector<LightSlot> slots;
+        unsigned long version;
+
+        int lightsCapacity;
+        int shadowsCapacity;
+        unsigned long storageVersion;
+
+        bool isLayoutChanged(std::vector<Light*>* lights);
+        void createLayout(std::vector<Light*>* lights);
+        void updateLight(const LightSlot& slot);
+        void reserveStorage(int lights, int shadows);
         
     public:
         
@@ -18,6 +47,7 @@ namespace Supernova {
         std::vector<float> pointLightPower;
         std::vector<float> pointLightColor;
         std::vector<int> pointLightShadowIdx;
+        std::vector<float> pointLightRange;
         
         int numSpotLight;
         std::vector<float> spotLightPos;
@@ -27,6 +57,7 @@ namespace Supernova {
         std::vector<float> spotLightCutOff;
         std::vector<float> spotLightOuterCutOff;
         std::vector<int> spotLightShadowIdx;
+        std::vector<float> spotLightRange;
         
         int numDirectionalLight;
         std::vector<float> directionalLightDir;
@@ -35,14 +66,14 @@ namespace Supernova {
         std::vector<int> directionalLightShadowIdx;
 
         int numShadows2D;
-        std::vector<Texture*> shadowsMap2D;
+        std::vector<Vector4> shadowsRect2D;
         std::vector<Matrix4> shadowsVPMatrix;
         std::vector<float> shadowsBias2D;
         std::vector<Vector2> shadowsCameraNearFar2D;
         std::vector<int> shadowNumCascades2D;
 
         int numShadowsCube;
-        std::vector<Texture*> shadowsMapCube;
+        std::vector<Vector4> shadowsRectCube;
         std::vector<float> shadowsBiasCube;
         std::vector<Vector2> shadowsCameraNearFarCube;
 
@@ -50,7 +81,14 @@ namespace Supernova {
         LightData();
         virtual ~LightData();
         
+        //Arrays are only resized when lights are added, removed or change shadow,
+        //otherwise only lights changed since last call are written again
         bool updateLights(std::vector<Light*>* lights, Vector3* ambientLight);
+
+        //Increased when any value is changed
+        unsigned long getVersion();
+        //Increased when storage is reallocated and registered pointers are invalid
+        unsigned long getStorageVersion();
     };
     
 }
@@ -0,0 +1,166 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "LightList.h"
+#include <algorithm>
+#include <math.h>
+
+//Far from any fragment to avoid zero attenuation in unused slots
+#define S_LIGHTLIST_UNUSED_POSITION 1e6
+
+using namespace Supernova;
+
+LightList::LightList(){
+    numPointLight = 0;
+    numSpotLight = 0;
+
+    updated = false;
+    lightDataVersion = 0;
+    lastRadius = 0;
+}
+
+LightList::~LightList(){
+
+}
+
+void LightList::resize(int numPointLight, int numSpotLight){
+    this->numPointLight = numPointLight;
+    pointLightPos.resize(numPointLight * 3);
+    pointLightPower.resize(numPointLight);
+    pointLightColor.resize(numPointLight * 3);
+    pointLightShadowIdx.resize(numPointLight);
+
+    this->numSpotLight = numSpotLight;
+    spotLightPos.resize(numSpotLight * 3);
+    spotLightColor.resize(numSpotLight * 3);
+    spotLightTarget.resize(numSpotLight * 3);
+    spotLightPower.resize(numSpotLight);
+    spotLightCutOff.resize(numSpotLight);
+    spotLightOuterCutOff.resize(numSpotLight);
+    spotLightShadowIdx.resize(numSpotLight);
+
+    updated = false;
+}
+
+float LightList::coneIntensity(Vector3 position, Vector3 target, float cutOff, float outerCutOff, Vector3 center, float radius){
+    Vector3 toCenter = center - position;
+    float distance = toCenter.length();
+    Vector3 axis = target - position;
+    float axisLength = axis.length();
+
+    if (distance <= radius || axisLength == 0)
+        return 1;
+
+    float cosCenter = axis.dotProduct(toCenter) / (axisLength * distance);
+    //Angle to nearest point of sphere is reduced by its angular radius
+    float angle = acos(std::max(-1.0f, std::min(1.0f, cosCenter))) - asin(std::min(1.0f, radius / distance));
+    float cosAngle = cos(std::max(0.0f, angle));
+
+    if (cutOff <= outerCutOff)
+        return (cosAngle > outerCutOff) ? 1 : 0;
+
+    return std::max(0.0f, std::min(1.0f, (cosAngle - outerCutOff) / (cutOff - outerCutOff)));
+}
+
+int LightList::select(const std::vector<float>& positions, const std::vector<float>& powers, const std::vector<float>& ranges, const std::vector<float>* targets, const std::vector<float>* cutOffs, const std::vector<float>* outerCutOffs, int numLights, int capacity, Vector3 center, float radius){
+    selected.resize(capacity);
+    scores.resize(capacity);
+
+    int count = 0;
+    if (capacity == 0)
+        return count;
+
+    for (int i = 0; i < numLights; i++){
+        Vector3 position(positions[i*3], positions[i*3+1], positions[i*3+2]);
+
+        float distance = std::max(0.0f, (position - center).length() - radius);
+        if (distance > ranges[i] || powers[i] <= 0)
+            continue;
+
+        //Same linear attenuation of shader
+        float score = powers[i] / std::max(distance, 1.0f);
+
+        if (targets){
+            Vector3 target((*targets)[i*3], (*targets)[i*3+1], (*targets)[i*3+2]);
+            score *= coneIntensity(position, target, (*cutOffs)[i], (*outerCutOffs)[i], center, radius);
+            if (score <= 0)
+                continue;
+        }
+
+        if (count == capacity && score <= scores[count - 1])
+            continue;
+
+        int slot = (count < capacity) ? count++ : count - 1;
+        while (slot > 0 && scores[slot - 1] < score){
+            selected[slot] = selected[slot - 1];
+            scores[slot] = scores[slot - 1];
+            slot--;
+        }
+        selected[slot] = i;
+        scores[slot] = score;
+    }
+
+    return count;
+}
+
+bool LightList::update(LightData* lightData, Vector3 center, float radius){
+    if (updated && lightDataVersion == lightData->getVersion() && lastCenter == center && lastRadius == radius)
+        return false;
+
+    updated = true;
+    lightDataVersion = lightData->getVersion();
+    lastCenter = center;
+    lastRadius = radius;
+
+    int count = select(lightData->pointLightPos, lightData->pointLightPower, lightData->pointLightRange, NULL, NULL, NULL, lightData->numPointLight, numPointLight, center, radius);
+
+    for (int i = 0; i < numPointLight; i++){
+        if (i < count){
+            int l = selected[i];
+            for (int c = 0; c < 3; c++){
+                pointLightPos[i*3+c] = lightData->pointLightPos[l*3+c];
+                pointLightColor[i*3+c] = lightData->pointLightColor[l*3+c];
+            }
+            pointLightPower[i] = lightData->pointLightPower[l];
+            pointLightShadowIdx[i] = lightData->pointLightShadowIdx[l];
+        }else{
+            for (int c = 0; c < 3; c++){
+                pointLightPos[i*3+c] = S_LIGHTLIST_UNUSED_POSITION;
+                pointLightColor[i*3+c] = 0;
+            }
+            pointLightPower[i] = 0;
+            pointLightShadowIdx[i] = -1;
+        }
+    }
+
+    count = select(lightData->spotLightPos, lightData->spotLightPower, lightData->spotLightRange, &lightData->spotLightTarget, &lightData->spotLightCutOff, &lightData->spotLightOuterCutOff, lightData->numSpotLight, numSpotLight, center, radius);
+
+    for (int i = 0; i < numSpotLight; i++){
+        if (i < count){
+            int l = selected[i];
+            for (int c = 0; c < 3; c++){
+                spotLightPos[i*3+c] = lightData->spotLightPos[l*3+c];
+                spotLightColor[i*3+c] = lightData->spotLightColor[l*3+c];
+                spotLightTarget[i*3+c] = lightData->spotLightTarget[l*3+c];
+            }
+            spotLightPower[i] = lightData->spotLightPower[l];
+            spotLightCutOff[i] = lightData->spotLightCutOff[l];
+            spotLightOuterCutOff[i] = lightData->spotLightOuterCutOff[l];
+            spotLightShadowIdx[i] = lightData->spotLightShadowIdx[l];
+        }else{
+            for (int c = 0; c < 3; c++){
+                spotLightPos[i*3+c] = S_LIGHTLIST_UNUSED_POSITION;
+                spotLightColor[i*3+c] = 0;
+                spotLightTarget[i*3+c] = 0;
+            }
+            spotLightPower[i] = 0;
+            //Different cutoffs to avoid division by zero in shader
+            spotLightCutOff[i] = 1;
+            spotLightOuterCutOff[i] = 0;
+            spotLightShadowIdx[i] = -1;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,60 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef LIGHTLIST_H
+#define LIGHTLIST_H
+
+#include "LightData.h"
+#include "math/Vector3.h"
+#include <vector>
+
+namespace Supernova {
+
+    //Most influential point and spot lights of one object, same layout as LightData
+    class LightList {
+    private:
+        std::vector<int> selected;
+        std::vector<float> scores;
+
+        //Last update, lights are not selected again when nothing changed
+        bool updated;
+        unsigned long lightDataVersion;
+        Vector3 lastCenter;
+        float lastRadius;
+
+        //Spot intensity in most lit point of sphere, same smooth cone of shader
+        static float coneIntensity(Vector3 position, Vector3 target, float cutOff, float outerCutOff, Vector3 center, float radius);
+
+        //Fills selected with best lights for sphere, ordered by score. Spot arrays are NULL for point lights
+        int select(const std::vector<float>& positions, const std::vector<float>& powers, const std::vector<float>& ranges, const std::vector<float>* targets, const std::vector<float>* cutOffs, const std::vector<float>* outerCutOffs, int numLights, int capacity, Vector3 center, float radius);
+
+    public:
+        int numPointLight;
+        std::vector<float> pointLightPos;
+        std::vector<float> pointLightPower;
+        std::vector<float> pointLightColor;
+        std::vector<int> pointLightShadowIdx;
+
+        int numSpotLight;
+        std::vector<float> spotLightPos;
+        std::vector<float> spotLightColor;
+        std::vector<float> spotLightTarget;
+        std::vector<float> spotLightPower;
+        std::vector<float> spotLightCutOff;
+        std::vector<float> spotLightOuterCutOff;
+        std::vector<int> spotLightShadowIdx;
+
+        LightList();
+        virtual ~LightList();
+
+        //Storage is allocated once because renders keep pointers to it
+        void resize(int numPointLight, int numSpotLight);
+
+        //Unused slots are filled with lights without power, returns false when nothing changed
+        bool update(LightData* lightData, Vector3 center, float radius);
+    };
+
+}
+
+#endif //LIGHTLIST_H
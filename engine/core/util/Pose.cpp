@@ -0,0 +1,80 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Pose.h"
+#include <algorithm>
+
+using namespace Supernova;
+
+Pose::Pose(){
+    changed = false;
+}
+
+Pose::~Pose(){
+
+}
+
+void Pose::resize(size_t size){
+    positions.resize(size, Vector3(0, 0, 0));
+    rotations.resize(size, Quaternion());
+    scales.resize(size, Vector3(1, 1, 1));
+    sampled.resize(size, 0);
+}
+
+size_t Pose::size() const{
+    return positions.size();
+}
+
+void Pose::clear(){
+    positions.clear();
+    rotations.clear();
+    scales.clear();
+    sampled.clear();
+
+    changed = false;
+}
+
+void Pose::setPosition(int joint, const Vector3& position){
+    positions[joint] = position;
+    sampled[joint] = 1;
+    changed = true;
+}
+
+void Pose::setRotation(int joint, const Quaternion& rotation){
+    rotations[joint] = rotation;
+    sampled[joint] = 1;
+    changed = true;
+}
+
+void Pose::setScale(int joint, const Vector3& scale){
+    scales[joint] = scale;
+    sampled[joint] = 1;
+    changed = true;
+}
+
+void Pose::interpolate(const Pose& from, const Pose& to, float t){
+    size_t count = std::min(size(), std::min(from.size(), to.size()));
+
+    for (size_t i = 0; i < count; i++){
+        Quaternion toRotation = to.rotations[i];
+        if (from.rotations[i].dot(toRotation) < 0)
+            toRotation = -toRotation;
+
+        positions[i] = from.positions[i] + (to.positions[i] - from.positions[i]) * t;
+        scales[i] = from.scales[i] + (to.scales[i] - from.scales[i]) * t;
+        rotations[i] = from.rotations[i] * (1 - t) + toRotation * t;
+        rotations[i].normalise();
+    }
+
+    changed = true;
+}
+
+void Pose::copy(const Pose& pose){
+    positions = pose.positions;
+    rotations = pose.rotations;
+    scales = pose.scales;
+    sampled = pose.sampled;
+
+    changed = true;
+}
@@ -0,0 +1,46 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef POSE_H
+#define POSE_H
+
+#include "math/Vector3.h"
+#include "math/Quaternion.h"
+#include <vector>
+#include <stddef.h>
+
+namespace Supernova {
+
+    //Local transforms of skeleton joints, keyframe tracks are sampled here before blending
+    class Pose {
+    public:
+        std::vector<Vector3> positions;
+        std::vector<Quaternion> rotations;
+        std::vector<Vector3> scales;
+
+        //Joints written by tracks, joints not sampled are not blended
+        std::vector<unsigned char> sampled;
+
+        //Any value written since last evaluation
+        bool changed;
+
+        Pose();
+        virtual ~Pose();
+
+        void resize(size_t size);
+        size_t size() const;
+        void clear();
+
+        void setPosition(int joint, const Vector3& position);
+        void setRotation(int joint, const Quaternion& rotation);
+        void setScale(int joint, const Vector3& scale);
+
+        void copy(const Pose& pose);
+        //Linear for positions and scales, normalized lerp for rotations
+        void interpolate(const Pose& from, const Pose& to, float t);
+    };
+
+}
+
+#endif //POSE_H
@@ -0,0 +1,115 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "ResolutionController.h"
+#include <algorithm>
+
+using namespace Supernova;
+
+ResolutionController::ResolutionController(){
+    targetFrameTime = 1.0f / 60.0f;
+    minScale = 0.5;
+    maxScale = 1.0;
+    step = 0.05;
+    tolerance = 0.1;
+    smoothing = 0.1;
+    cooldownFrames = 15;
+
+    reset();
+}
+
+void ResolutionController::reset(){
+    scale = maxScale;
+    averageFrameTime = 0;
+    framesSinceChange = 0;
+}
+
+float ResolutionController::update(float frameTime){
+    if (frameTime <= 0)
+        return scale;
+
+    //Exponential moving average ignores single slow frames
+    if (averageFrameTime == 0)
+        averageFrameTime = frameTime;
+    else
+        averageFrameTime += (frameTime - averageFrameTime) * smoothing;
+
+    framesSinceChange++;
+    if (framesSinceChange < cooldownFrames)
+        return scale;
+
+    float newScale = scale;
+    if (averageFrameTime > targetFrameTime * (1 + tolerance)){
+        //Pixel cost is proportional to area, faster steps when far from target
+        float ratio = targetFrameTime / averageFrameTime;
+        newScale = std::min(scale - step, scale * ratio);
+    }else if (averageFrameTime < targetFrameTime * (1 - tolerance)){
+        newScale = scale + step;
+    }
+
+    newScale = std::max(minScale, std::min(maxScale, newScale));
+
+    if (newScale != scale){
+        scale = newScale;
+        framesSinceChange = 0;
+    }
+
+    return scale;
+}
+
+float ResolutionController::getScale(){
+    return scale;
+}
+
+float ResolutionController::getAverageFrameTime(){
+    return averageFrameTime;
+}
+
+void ResolutionController::setTargetFrameTime(unsigned int targetFrameTimeMS){
+    if (targetFrameTimeMS == 0)
+        targetFrameTimeMS = 1;
+    this->targetFrameTime = targetFrameTimeMS / 1000.0f;
+}
+
+unsigned int ResolutionController::getTargetFrameTime(){
+    return (unsigned int)(targetFrameTime * 1000.0f + 0.5f);
+}
+
+void ResolutionController::setScaleRange(float minScale, float maxScale){
+    this->minScale = std::max(0.1f, std::min(minScale, maxScale));
+    this->maxScale = std::min(1.0f, std::max(minScale, maxScale));
+    scale = std::max(this->minScale, std::min(this->maxScale, scale));
+}
+
+float ResolutionController::getMinScale(){
+    return minScale;
+}
+
+float ResolutionController::getMaxScale(){
+    return maxScale;
+}
+
+void ResolutionController::setStep(float step){
+    this->step = std::max(0.01f, step);
+}
+
+float ResolutionController::getStep(){
+    return step;
+}
+
+void ResolutionController::setTolerance(float tolerance){
+    this->tolerance = std::max(0.0f, tolerance);
+}
+
+float ResolutionController::getTolerance(){
+    return tolerance;
+}
+
+void ResolutionController::setCooldownFrames(unsigned int cooldownFrames){
+    this->cooldownFrames = cooldownFrames;
+}
+
+unsigned int ResolutionController::getCooldownFrames(){
+    return cooldownFrames;
+}
@@ -0,0 +1,57 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef RESOLUTIONCONTROLLER_H
+#define RESOLUTIONCONTROLLER_H
+
+namespace Supernova {
+
+    //Changes render scale in steps to keep frame time close to target, has no render dependency
+    class ResolutionController {
+    private:
+        float targetFrameTime;
+        float minScale;
+        float maxScale;
+        float step;
+        float tolerance;
+        float smoothing;
+        unsigned int cooldownFrames;
+
+        float scale;
+        float averageFrameTime;
+        unsigned int framesSinceChange;
+
+    public:
+        ResolutionController();
+
+        //Frame time in seconds, returns scale to be used in next frame
+        float update(float frameTime);
+        void reset();
+
+        float getScale();
+        float getAverageFrameTime();
+
+        void setTargetFrameTime(unsigned int targetFrameTimeMS);
+        unsigned int getTargetFrameTime();
+
+        void setScaleRange(float minScale, float maxScale);
+        float getMinScale();
+        float getMaxScale();
+
+        //Scale changed by each step
+        void setStep(float step);
+        float getStep();
+
+        //Fraction of target frame time where scale is not changed
+        void setTolerance(float tolerance);
+        float getTolerance();
+
+        //Frames waited after a change before next one
+        void setCooldownFrames(unsigned int cooldownFrames);
+        unsigned int getCooldownFrames();
+    };
+
+}
+
+#endif //RESOLUTIONCONTROLLER_H
@@ -0,0 +1,214 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "ShadowAtlas.h"
+#include "UniqueToken.h"
+#include <algorithm>
+#include <numeric>
+
+using namespace Supernova;
+
+ShadowAtlas::ShadowAtlas(){
+    texture = NULL;
+    size = 4096;
+    minTileSize = 128;
+    repackThreshold = 0.25;
+    needPack = true;
+}
+
+ShadowAtlas::~ShadowAtlas(){
+    destroy();
+}
+
+int ShadowAtlas::nextPowerOfTwo(int value){
+    int power = 1;
+    while (power < value)
+        power <<= 1;
+    return power;
+}
+
+unsigned int ShadowAtlas::compactBits(unsigned int value){
+    //Keeps even bits of a Morton code
+    value &= 0x55555555;
+    value = (value | (value >> 1)) & 0x33333333;
+    value = (value | (value >> 2)) & 0x0F0F0F0F;
+    value = (value | (value >> 4)) & 0x00FF00FF;
+    value = (value | (value >> 8)) & 0x0000FFFF;
+    return value;
+}
+
+void ShadowAtlas::setSize(int size){
+    this->size = nextPowerOfTwo(size);
+    needPack = true;
+}
+
+int ShadowAtlas::getSize(){
+    return size;
+}
+
+void ShadowAtlas::setMinTileSize(int minTileSize){
+    this->minTileSize = nextPowerOfTwo(minTileSize);
+    needPack = true;
+}
+
+int ShadowAtlas::getMinTileSize(){
+    return minTileSize;
+}
+
+void ShadowAtlas::setRepackThreshold(float repackThreshold){
+    this->repackThreshold = repackThreshold;
+}
+
+float ShadowAtlas::getRepackThreshold(){
+    return repackThreshold;
+}
+
+Texture* ShadowAtlas::getTexture(){
+    return texture;
+}
+
+bool ShadowAtlas::load(int textureType){
+    if (!texture){
+        texture = new Texture(size, size);
+        texture->setId("shadowAtlas|" + UniqueToken::get());
+    }else if (texture->getTextureFrameWidth() != size){
+        //Same texture object is kept because renders point to it
+        texture->destroy();
+        texture->setTextureFrameSize(size, size);
+        texture->setId("shadowAtlas|" + UniqueToken::get());
+    }
+
+    texture->setType(textureType);
+    //Depth values must not be filtered between tiles
+    texture->setNearestScale(true);
+
+    return texture->load();
+}
+
+void ShadowAtlas::destroy(){
+    if (texture){
+        texture->destroy();
+        delete texture;
+        texture = NULL;
+    }
+}
+
+void ShadowAtlas::clearRequests(){
+    requests.clear();
+    priorities.clear();
+}
+
+int ShadowAtlas::addRequest(int tileSize, float priority){
+    requests.push_back(tileSize);
+    priorities.push_back(priority);
+
+    return (int)requests.size() - 1;
+}
+
+size_t ShadowAtlas::getNumRequests(){
+    return requests.size();
+}
+
+bool ShadowAtlas::isRequestsChanged(){
+    if (requests.size() != packedRequests.size())
+        return true;
+
+    for (size_t i = 0; i < requests.size(); i++){
+        float packed = (float)packedRequests[i];
+        if (requests[i] > packed * (1 + repackThreshold) || requests[i] < packed * (1 - repackThreshold))
+            return true;
+    }
+
+    return false;
+}
+
+bool ShadowAtlas::pack(){
+    //Moving tiles invalidates cached shadows, so coverage changes of each frame are ignored
+    if (!needPack && !isRequestsChanged())
+        return false;
+
+    needPack = false;
+    packedRequests = requests;
+
+    size_t count = requests.size();
+
+    tileSizes.resize(count);
+    tiles.assign(count, Rect(0, 0, 0, 0));
+
+    if (count == 0 || size < minTileSize)
+        return true;
+
+    //Area is counted in cells of minTileSize
+    unsigned long capacity = (unsigned long)(size / minTileSize) * (size / minTileSize);
+    unsigned long total = 0;
+
+    for (size_t i = 0; i < count; i++){
+        tileSizes[i] = std::max(minTileSize, std::min(size, nextPowerOfTwo(requests[i])));
+        total += (unsigned long)(tileSizes[i] / minTileSize) * (tileSizes[i] / minTileSize);
+    }
+
+    //Halve tile with most area for its priority until everything fits
+    while (total > capacity){
+        int candidate = -1;
+        float candidateCost = 0;
+        for (size_t i = 0; i < count; i++){
+            if (tileSizes[i] > minTileSize){
+                float cost = (float)tileSizes[i] * tileSizes[i] / std::max(priorities[i], 0.0001f);
+                if (candidate == -1 || cost > candidateCost){
+                    candidate = (int)i;
+                    candidateCost = cost;
+                }
+            }
+        }
+        if (candidate == -1)
+            break;
+
+        unsigned long cells = (unsigned long)(tileSizes[candidate] / minTileSize) * (tileSizes[candidate] / minTileSize);
+        total -= cells - (cells / 4);
+        tileSizes[candidate] /= 2;
+    }
+
+    //Lowest priorities have no tile if minimum tiles still not fit
+    while (total > capacity){
+        int candidate = -1;
+        for (size_t i = 0; i < count; i++){
+            if (tileSizes[i] > 0 && (candidate == -1 || priorities[i] < priorities[candidate]))
+                candidate = (int)i;
+        }
+        if (candidate == -1)
+            break;
+
+        total -= (unsigned long)(tileSizes[candidate] / minTileSize) * (tileSizes[candidate] / minTileSize);
+        tileSizes[candidate] = 0;
+    }
+
+    //Biggest tiles first in Z-order, then each tile starts aligned to its own size
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b){
+        return tileSizes[a] > tileSizes[b];
+    });
+
+    unsigned int cell = 0;
+    for (size_t k = 0; k < count; k++){
+        size_t i = order[k];
+        if (tileSizes[i] == 0)
+            continue;
+
+        float x = (float)(compactBits(cell) * minTileSize);
+        float y = (float)(compactBits(cell >> 1) * minTileSize);
+        tiles[i] = Rect(x, y, tileSizes[i], tileSizes[i]);
+
+        cell += (tileSizes[i] / minTileSize) * (tileSizes[i] / minTileSize);
+    }
+
+    return true;
+}
+
+Rect ShadowAtlas::getTile(int index){
+    if (index < 0 || index >= tiles.size())
+        return Rect(0, 0, 0, 0);
+
+    return tiles[index];
+}
@@ -0,0 +1,70 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef SHADOWATLAS_H
+#define SHADOWATLAS_H
+
+#include "Texture.h"
+#include "math/Rect.h"
+#include <vector>
+
+namespace Supernova {
+
+    //One texture shared by all shadow maps, tiles are square and power of two
+    class ShadowAtlas {
+    private:
+        Texture* texture;
+
+        int size;
+        int minTileSize;
+        float repackThreshold;
+        bool needPack;
+
+        std::vector<int> requests;
+        std::vector<float> priorities;
+        std::vector<int> tileSizes;
+        std::vector<Rect> tiles;
+        //Requests of last pack, small changes keep same tiles
+        std::vector<int> packedRequests;
+
+        static int nextPowerOfTwo(int value);
+        static unsigned int compactBits(unsigned int value);
+
+        bool isRequestsChanged();
+
+    public:
+        ShadowAtlas();
+        virtual ~ShadowAtlas();
+
+        void setSize(int size);
+        int getSize();
+
+        void setMinTileSize(int minTileSize);
+        int getMinTileSize();
+
+        //Relative change of a requested size that makes atlas pack again
+        void setRepackThreshold(float repackThreshold);
+        float getRepackThreshold();
+
+        Texture* getTexture();
+
+        //Texture type is S_TEXTURE_DEPTH_FRAME or S_TEXTURE_FRAME
+        bool load(int textureType);
+        void destroy();
+
+        void clearRequests();
+        //Returns request index, bigger priority keeps bigger tile when atlas is full
+        int addRequest(int tileSize, float priority);
+        size_t getNumRequests();
+
+        //Returns false when requests are close to last pack and tiles are kept
+        bool pack();
+
+        //Pixels in atlas, zero size when request does not fit
+        Rect getTile(int index);
+    };
+
+}
+
+#endif //SHADOWATLAS_H
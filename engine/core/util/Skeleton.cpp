@@ -0,0 +1,230 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Skeleton.h"
+#include "Object.h"
+#include "Log.h"
+#include <algorithm>
+
+using namespace Supernova;
+
+Skeleton::Skeleton(){
+}
+
+Skeleton::~Skeleton(){
+
+}
+
+int Skeleton::addJoint(int parent, int bone, std::string name, Vector3 position, Quaternion rotation, Vector3 scale, Matrix4 offsetMatrix){
+    int joint = (int)parents.size();
+
+    if (parent >= joint){
+        Log::Error("Skeleton joint parent must be added before its children");
+        parent = -1;
+    }
+
+    parents.push_back(parent);
+    bones.push_back(bone);
+    names.push_back(name);
+
+    pose.resize(joint + 1);
+    pose.setPosition(joint, position);
+    pose.setRotation(joint, rotation);
+    pose.setScale(joint, scale);
+
+    bindPose.resize(joint + 1);
+    bindPose.setPosition(joint, position);
+    bindPose.setRotation(joint, rotation);
+    bindPose.setScale(joint, scale);
+
+    offsetMatrices.push_back(offsetMatrix);
+
+    worldMatrices.push_back(Matrix4());
+    worldRotations.push_back(Quaternion());
+    worldScales.push_back(Vector3(1, 1, 1));
+
+    return joint;
+}
+
+void Skeleton::clear(){
+    parents.clear();
+    bones.clear();
+    names.clear();
+    pose.clear();
+    bindPose.clear();
+    offsetMatrices.clear();
+    worldMatrices.clear();
+    worldRotations.clear();
+    worldScales.clear();
+    attachments.clear();
+}
+
+size_t Skeleton::size() const{
+    return parents.size();
+}
+
+int Skeleton::findJoint(std::string name) const{
+    for (size_t i = 0; i < names.size(); i++){
+        if (names[i] == name)
+            return (int)i;
+    }
+
+    return -1;
+}
+
+int Skeleton::getParent(int joint) const{
+    return parents[joint];
+}
+
+int Skeleton::getBone(int joint) const{
+    return bones[joint];
+}
+
+const std::string& Skeleton::getName(int joint) const{
+    return names[joint];
+}
+
+void Skeleton::setPosition(int joint, const Vector3& position){
+    pose.setPosition(joint, position);
+}
+
+void Skeleton::setRotation(int joint, const Quaternion& rotation){
+    pose.setRotation(joint, rotation);
+}
+
+void Skeleton::setScale(int joint, const Vector3& scale){
+    pose.setScale(joint, scale);
+}
+
+Vector3 Skeleton::getPosition(int joint) const{
+    return pose.positions[joint];
+}
+
+Quaternion Skeleton::getRotation(int joint) const{
+    return pose.rotations[joint];
+}
+
+Vector3 Skeleton::getScale(int joint) const{
+    return pose.scales[joint];
+}
+
+void Skeleton::moveToBind(){
+    pose.copy(bindPose);
+}
+
+Pose* Skeleton::getPose(){
+    return &pose;
+}
+
+const Pose* Skeleton::getBindPose() const{
+    return &bindPose;
+}
+
+bool Skeleton::isDirty() const{
+    return pose.changed;
+}
+
+void Skeleton::update(Matrix4* palette, size_t paletteSize){
+    size_t count = parents.size();
+
+    for (size_t i = 0; i < count; i++){
+        //Translate * rotation * scale written directly, matrices are [col][row]
+        const Vector3& position = pose.positions[i];
+        Quaternion rotation = pose.rotations[i];
+        const Vector3& scale = pose.scales[i];
+
+        Matrix4 rotationMatrix = rotation.getRotationMatrix();
+        const float* rot = rotationMatrix;
+        const float scl[3] = {scale.x, scale.y, scale.z};
+
+        Matrix4 local;
+        float* m = local;
+        for (int c = 0; c < 3; c++){
+            for (int r = 0; r < 3; r++){
+                m[c*4+r] = rot[c*4+r] * scl[c];
+            }
+            m[c*4+3] = 0.0f;
+        }
+        m[12] = position.x;
+        m[13] = position.y;
+        m[14] = position.z;
+        m[15] = 1.0f;
+
+        int parent = parents[i];
+        if (parent >= 0){
+            worldMatrices[i] = worldMatrices[parent].affineMultiply(local);
+            worldRotations[i] = worldRotations[parent] * rotation;
+            worldScales[i] = worldScales[parent] * scale;
+        }else{
+            worldMatrices[i] = local;
+            worldRotations[i] = rotation;
+            worldScales[i] = scale;
+        }
+
+        int bone = bones[i];
+        if (bone >= 0 && bone < paletteSize)
+            palette[bone] = worldMatrices[i].affineMultiply(offsetMatrices[i]);
+    }
+
+    pose.changed = false;
+}
+
+Matrix4 Skeleton::getWorldMatrix(int joint) const{
+    return worldMatrices[joint];
+}
+
+AlignedBox Skeleton::getJointsBounds() const{
+    AlignedBox box;
+
+    for (size_t i = 0; i < parents.size(); i++){
+        if (bones[i] >= 0)
+            box.merge(worldMatrices[i] * Vector3(0, 0, 0));
+    }
+
+    return box;
+}
+
+AlignedBox Skeleton::getBindJointsBounds() const{
+    AlignedBox box;
+
+    //Bind world matrix is the inverse of offset matrix
+    for (size_t i = 0; i < parents.size(); i++){
+        if (bones[i] >= 0)
+            box.merge(offsetMatrices[i].affineInverse() * Vector3(0, 0, 0));
+    }
+
+    return box;
+}
+
+void Skeleton::addAttachment(Object* object, int joint){
+    if (joint < 0 || joint >= parents.size()){
+        Log::Error("Skeleton joint %i not exist", joint);
+        return;
+    }
+
+    removeAttachment(object);
+
+    Attachment attachment;
+    attachment.object = object;
+    attachment.joint = joint;
+
+    attachments.push_back(attachment);
+}
+
+void Skeleton::removeAttachment(Object* object){
+    attachments.erase(std::remove_if(attachments.begin(), attachments.end(), [object](const Attachment& attachment){
+        return attachment.object == object;
+    }), attachments.end());
+}
+
+void Skeleton::updateAttachments(){
+    for (size_t i = 0; i < attachments.size(); i++){
+        int joint = attachments[i].joint;
+        const float* world = worldMatrices[joint];
+
+        attachments[i].object->setPosition(Vector3(world[12], world[13], world[14]));
+        attachments[i].object->setRotation(worldRotations[joint]);
+        attachments[i].object->setScale(worldScales[joint]);
+    }
+}
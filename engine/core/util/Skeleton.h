@@ -0,0 +1,93 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef SKELETON_H
+#define SKELETON_H
+
+#include "math/Vector3.h"
+#include "math/Quaternion.h"
+#include "math/Matrix4.h"
+#include "math/AlignedBox.h"
+#include "Pose.h"
+#include <vector>
+#include <string>
+
+namespace Supernova {
+
+    class Object;
+
+    //Joints of a skinned model without scene objects, parents are always before children
+    class Skeleton {
+    private:
+        struct Attachment{
+            Object* object;
+            int joint;
+        };
+
+        std::vector<int> parents;
+        //Index in bones palette, -1 when node is not a skin joint
+        std::vector<int> bones;
+        std::vector<std::string> names;
+
+        //Final local pose, written by tracks or by model animation layers
+        Pose pose;
+        Pose bindPose;
+
+        //Inverse bind matrices
+        std::vector<Matrix4> offsetMatrices;
+
+        //Relative to model, same space of Bone objects
+        std::vector<Matrix4> worldMatrices;
+        std::vector<Quaternion> worldRotations;
+        std::vector<Vector3> worldScales;
+
+        std::vector<Attachment> attachments;
+
+    public:
+        Skeleton();
+        virtual ~Skeleton();
+
+        //Parent must be added before, returns joint index
+        int addJoint(int parent, int bone, std::string name, Vector3 position, Quaternion rotation, Vector3 scale, Matrix4 offsetMatrix);
+        void clear();
+
+        size_t size() const;
+        int findJoint(std::string name) const;
+        int getParent(int joint) const;
+        int getBone(int joint) const;
+        const std::string& getName(int joint) const;
+
+        void setPosition(int joint, const Vector3& position);
+        void setRotation(int joint, const Quaternion& rotation);
+        void setScale(int joint, const Vector3& scale);
+
+        Vector3 getPosition(int joint) const;
+        Quaternion getRotation(int joint) const;
+        Vector3 getScale(int joint) const;
+
+        void moveToBind();
+
+        Pose* getPose();
+        const Pose* getBindPose() const;
+
+        bool isDirty() const;
+
+        //One linear pass over joints, skinning matrices are written in palette
+        void update(Matrix4* palette, size_t paletteSize);
+
+        Matrix4 getWorldMatrix(int joint) const;
+
+        //Positions of skin joints in last update and in bind pose, relative to model
+        AlignedBox getJointsBounds() const;
+        AlignedBox getBindJointsBounds() const;
+
+        //Attached objects must be children of the model, they follow joint transform
+        void addAttachment(Object* object, int joint);
+        void removeAttachment(Object* object);
+        void updateAttachments();
+    };
+
+}
+
+#endif //SKELETON_H
@@ -0,0 +1,58 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "ThreadPool.h"
+
+using namespace Supernova;
+
+ThreadPool::ThreadPool(unsigned int numThreads){
+    stopping = false;
+
+    for (unsigned int i = 0; i < numThreads; i++){
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    condition.notify_all();
+
+    for (size_t i = 0; i < workers.size(); i++){
+        workers[i].join();
+    }
+}
+
+unsigned int ThreadPool::getNumThreads() const{
+    return (unsigned int)workers.size();
+}
+
+void ThreadPool::workerLoop(){
+    while (true){
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            condition.wait(lock, [this]{ return stopping || !tasks.empty(); });
+
+            if (stopping && tasks.empty())
+                return;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        task();
+    }
+}
+
+void ThreadPool::enqueue(std::function<void()> task){
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        tasks.push_back(std::move(task));
+    }
+    condition.notify_one();
+}
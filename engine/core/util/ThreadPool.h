@@ -0,0 +1,39 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace Supernova {
+
+    class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> tasks;
+
+        std::mutex queueMutex;
+        std::condition_variable condition;
+        bool stopping;
+
+        void workerLoop();
+
+    public:
+        ThreadPool(unsigned int numThreads);
+        virtual ~ThreadPool();
+
+        unsigned int getNumThreads() const;
+
+        void enqueue(std::function<void()> task);
+    };
+
+}
+
+#endif //THREADPOOL_H
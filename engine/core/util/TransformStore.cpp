@@ -0,0 +1,271 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "TransformStore.h"
+#include "Scene.h"
+#include "JobSystem.h"
+#include <cmath>
+
+using namespace Supernova;
+
+TransformStore::TransformStore(){
+    valid = false;
+}
+
+TransformStore::~TransformStore(){
+}
+
+void TransformStore::addTree(Object* object, int parentIndex, size_t depth, std::vector<size_t>& depths){
+    int index = (int)objects.size();
+
+    objects.push_back(object);
+    parents.push_back(parentIndex);
+    dirty.push_back(object->markToUpdate ? 1 : 0);
+    depths.push_back(depth);
+
+    positions.push_back(object->position);
+    rotations.push_back(object->rotation);
+    scales.push_back(object->scale);
+    centers.push_back(object->center);
+    transformMatrices.push_back(object->transformMatrix);
+    worldMatrices.push_back((object->interpolated) ? object->fixedModelMatrix : object->modelMatrix);
+    computed.push_back(0);
+
+    object->transformStore = this;
+    object->transformIndex = index;
+
+    std::vector<Object*>::iterator it;
+    for (it = object->objects.begin(); it != object->objects.end(); ++it) {
+        //Child scenes have their own store
+        if ((*it)->scene != *it)
+            addTree(*it, index, depth + 1, depths);
+    }
+}
+
+void TransformStore::build(Object* root){
+    invalidate();
+
+    std::vector<size_t> depths;
+    addTree(root, -1, 0, depths);
+
+    size_t numLevels = 0;
+    for (size_t i = 0; i < depths.size(); i++){
+        if (depths[i] + 1 > numLevels)
+            numLevels = depths[i] + 1;
+    }
+
+    //Counting sort keeps depth-first order inside each level
+    levelOffsets.assign(numLevels + 1, 0);
+    for (size_t i = 0; i < depths.size(); i++){
+        levelOffsets[depths[i] + 1]++;
+    }
+    for (size_t l = 0; l < numLevels; l++){
+        levelOffsets[l + 1] += levelOffsets[l];
+    }
+
+    std::vector<size_t> next(levelOffsets.begin(), levelOffsets.end() - 1);
+    levelIndexes.resize(objects.size());
+    for (size_t i = 0; i < depths.size(); i++){
+        levelIndexes[next[depths[i]]++] = i;
+    }
+
+    valid = true;
+}
+
+void TransformStore::invalidate(){
+    for (size_t i = 0; i < objects.size(); i++){
+        objects[i]->transformStore = NULL;
+        objects[i]->transformIndex = -1;
+    }
+
+    objects.clear();
+    parents.clear();
+    dirty.clear();
+    positions.clear();
+    rotations.clear();
+    scales.clear();
+    centers.clear();
+    transformMatrices.clear();
+    worldMatrices.clear();
+    computed.clear();
+    levelIndexes.clear();
+    levelOffsets.clear();
+
+    valid = false;
+}
+
+bool TransformStore::isValid() const{
+    return valid;
+}
+
+size_t TransformStore::size() const{
+    return objects.size();
+}
+
+//Zero entries of full matrix products get sign from all summed zero terms
+static inline float productZero(float value, bool negative){
+    if (value != 0.0f)
+        return value;
+    return (negative) ? -0.0f : 0.0f;
+}
+
+void TransformStore::computeMatrices(const Vector3& position, const Quaternion& rotation, const Vector3& scale, const Vector3& center,
+                                     const Matrix4* parentMatrix, const Vector3& parentCenter, Matrix4& transformMatrix, Matrix4& worldMatrix){
+    //Avoids full matrix multiplications
+    Matrix4 rotationMatrix = rotation.getRotationMatrix();
+    Matrix4 localMatrix;
+    const float* rot = rotationMatrix;
+    float* transform = transformMatrix;
+    float* model = localMatrix;
+
+    const float pos[3] = {position.x, position.y, position.z};
+    const float scl[3] = {scale.x, scale.y, scale.z};
+
+    bool positionNegative[3];
+    float translateRotation[3][3];
+
+    for (int r = 0; r < 3; r++){
+        positionNegative[r] = (pos[r] < 0);
+    }
+
+    //Matrices are [col][row]
+    for (int c = 0; c < 3; c++){
+        bool columnNegative = std::signbit(rot[c*4+0]) && std::signbit(rot[c*4+1]) && std::signbit(rot[c*4+2]);
+        for (int r = 0; r < 3; r++){
+            translateRotation[c][r] = productZero(rot[c*4+r], columnNegative && std::signbit(pos[r]));
+        }
+    }
+
+    for (int c = 0; c < 3; c++){
+        for (int r = 0; r < 3; r++){
+            float value = scl[c] * translateRotation[c][r];
+            bool negative = positionNegative[r] && std::signbit(value);
+            for (int k = 0; k < 3; k++){
+                if (k != c)
+                    negative = negative && std::signbit(translateRotation[k][r]);
+            }
+            transform[c*4+r] = productZero(value, negative);
+        }
+        transform[c*4+3] = 0.0f;
+    }
+    for (int r = 0; r < 3; r++){
+        transform[12+r] = productZero(pos[r], false);
+    }
+    transform[15] = 1.0f;
+
+    for (int r = 0; r < 3; r++){
+        bool rowNegative = positionNegative[r] && std::signbit(transform[r]) && std::signbit(transform[4+r]) && std::signbit(transform[8+r]);
+        for (int c = 0; c < 3; c++){
+            model[c*4+r] = productZero(transform[c*4+r], rowNegative);
+        }
+        model[12+r] = -center.x * transform[r] + -center.y * transform[4+r] + -center.z * transform[8+r] + transform[12+r];
+    }
+    model[3] = 0.0f;
+    model[7] = 0.0f;
+    model[11] = 0.0f;
+    model[15] = 1.0f;
+
+    if (parentMatrix != NULL){
+        //Parent model matrix * translate(parent center)
+        const float* parentModel = *parentMatrix;
+        Matrix4 parentCenteredMatrix;
+        float* parentCentered = parentCenteredMatrix;
+        for (int r = 0; r < 3; r++){
+            bool rowNegative = std::signbit(parentModel[r]) && std::signbit(parentModel[4+r]) && std::signbit(parentModel[8+r]) && std::signbit(parentModel[12+r]);
+            for (int c = 0; c < 3; c++){
+                parentCentered[c*4+r] = productZero(parentModel[c*4+r], rowNegative);
+            }
+            parentCentered[12+r] = parentCenter.x * parentModel[r] + parentCenter.y * parentModel[4+r] + parentCenter.z * parentModel[8+r] + parentModel[12+r];
+        }
+
+        worldMatrix = parentCenteredMatrix.affineMultiply(localMatrix);
+    }else{
+        worldMatrix = localMatrix;
+    }
+}
+
+void TransformStore::setDirty(int index, bool value){
+    dirty[index] = (value) ? 1 : 0;
+    if (!value)
+        computed[index] = 0;
+}
+
+void TransformStore::setLocalTransform(int index, const Vector3& position, const Quaternion& rotation, const Vector3& scale, const Vector3& center){
+    positions[index] = position;
+    rotations[index] = rotation;
+    scales[index] = scale;
+    centers[index] = center;
+    dirty[index] = 1;
+    computed[index] = 0;
+}
+
+void TransformStore::setMatrices(int index, const Matrix4& transformMatrix, const Matrix4& worldMatrix){
+    transformMatrices[index] = transformMatrix;
+    worldMatrices[index] = worldMatrix;
+}
+
+bool TransformStore::isComputed(int index) const{
+    return computed[index] != 0;
+}
+
+const Matrix4& TransformStore::getTransformMatrix(int index) const{
+    return transformMatrices[index];
+}
+
+const Matrix4& TransformStore::getWorldMatrix(int index) const{
+    return worldMatrices[index];
+}
+
+void TransformStore::updateActions(){
+    //Actions can change hierarchy and invalidate store, then remaining actions run in Object::update
+    for (size_t i = 0; i < objects.size(); i++){
+        //Flag is set before because action callbacks can delete the object
+        objects[i]->actionsUpdated = true;
+        objects[i]->updateActions();
+
+        if (!valid)
+            break;
+    }
+}
+
+size_t TransformStore::propagateDirty(){
+    size_t count = 0;
+
+    for (size_t i = 0; i < objects.size(); i++){
+        if (!dirty[i] && parents[i] >= 0 && dirty[parents[i]]){
+            dirty[i] = 1;
+            objects[i]->markToUpdate = true;
+        }
+        if (dirty[i])
+            count++;
+    }
+
+    return count;
+}
+
+void TransformStore::updateWorldTransforms(size_t grainSize){
+    for (size_t l = 0; l + 1 < levelOffsets.size(); l++){
+        levelDirty.clear();
+        for (size_t k = levelOffsets[l]; k < levelOffsets[l + 1]; k++){
+            size_t index = levelIndexes[k];
+            if (dirty[index])
+                levelDirty.push_back(index);
+        }
+
+        JobSystem::parallelFor(levelDirty.size(), grainSize, [this](size_t start, size_t end){
+            for (size_t i = start; i < end; i++){
+                size_t index = levelDirty[i];
+                int parent = parents[index];
+                if (parent < 0){
+                    //Root can have a parent outside this store
+                    objects[index]->updateWorldTransform();
+                }else{
+                    computeMatrices(positions[index], rotations[index], scales[index], centers[index],
+                                    &worldMatrices[parent], centers[parent], transformMatrices[index], worldMatrices[index]);
+                }
+                computed[index] = 1;
+            }
+        });
+    }
+}
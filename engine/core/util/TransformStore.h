@@ -0,0 +1,79 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef TRANSFORMSTORE_H
+#define TRANSFORMSTORE_H
+
+#include <vector>
+#include <stddef.h>
+#include "math/Vector3.h"
+#include "math/Quaternion.h"
+#include "math/Matrix4.h"
+
+namespace Supernova {
+
+    class Object;
+
+    //Flat hierarchy of a scene: parents are always before children
+    class TransformStore {
+    private:
+        //Depth-first order, same order of Object::update
+        std::vector<Object*> objects;
+        std::vector<int> parents;
+        std::vector<unsigned char> dirty;
+
+        //Local transforms, written when object is marked to update
+        std::vector<Vector3> positions;
+        std::vector<Quaternion> rotations;
+        std::vector<Vector3> scales;
+        std::vector<Vector3> centers;
+
+        //Matrices of last update, computed is set when they are ahead of object
+        std::vector<Matrix4> transformMatrices;
+        std::vector<Matrix4> worldMatrices;
+        std::vector<unsigned char> computed;
+
+        //Object indexes sorted by depth, levelOffsets[d] is where depth d starts
+        std::vector<size_t> levelIndexes;
+        std::vector<size_t> levelOffsets;
+
+        std::vector<size_t> levelDirty;
+
+        bool valid;
+
+        void addTree(Object* object, int parentIndex, size_t depth, std::vector<size_t>& depths);
+
+    public:
+        TransformStore();
+        virtual ~TransformStore();
+
+        void build(Object* root);
+        void invalidate();
+        bool isValid() const;
+        size_t size() const;
+
+        //Same result of translate * rotation * scale * translate(-center) and parent products, bit by bit
+        static void computeMatrices(const Vector3& position, const Quaternion& rotation, const Vector3& scale, const Vector3& center,
+                                    const Matrix4* parentMatrix, const Vector3& parentCenter, Matrix4& transformMatrix, Matrix4& worldMatrix);
+
+        //Cleaning dirty also discards computed matrices
+        void setDirty(int index, bool value);
+        //Marks dirty
+        void setLocalTransform(int index, const Vector3& position, const Quaternion& rotation, const Vector3& scale, const Vector3& center);
+        void setMatrices(int index, const Matrix4& transformMatrix, const Matrix4& worldMatrix);
+
+        bool isComputed(int index) const;
+        const Matrix4& getTransformMatrix(int index) const;
+        const Matrix4& getWorldMatrix(int index) const;
+
+        void updateActions();
+        //Marks descendants of dirty objects, returns number of dirty objects
+        size_t propagateDirty();
+        //Dirty matrices from arrays only, by tree level in parallel
+        void updateWorldTransforms(size_t grainSize);
+    };
+
+}
+
+#endif //TRANSFORMSTORE_H
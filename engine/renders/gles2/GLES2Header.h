@@ -6,6 +6,10 @@
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
 #endif
+#ifdef SUPERNOVA_TEST
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#endif
 #ifdef SUPERNOVA_IOS
 #include <OpenGLES/ES2/gl.h>
 #include <OpenGLES/ES2/glext.h>
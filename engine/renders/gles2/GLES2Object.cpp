@@ -61,6 +61,26 @@ void GLES2Object::updateBuffer(std::string name, unsigned int size, void* data){
         loadBuffer(name, buffers[name]);
 }
 
+void GLES2Object::updateBufferRange(std::string name, size_t offset, size_t size){
+    if (!buffers.count(name))
+        return;
+
+    BufferData buff = buffers[name];
+
+    //Not created or smaller buffer is fully loaded
+    if (!vertexBuffersGL.count(name) || vertexBuffersGL[name].size < buff.size || offset + size > buff.size){
+        loadBuffer(name, buff);
+        return;
+    }
+
+    GLenum target = GL_ARRAY_BUFFER;
+    if (buff.type == S_BUFFERTYPE_INDEX){
+        target = GL_ELEMENT_ARRAY_BUFFER;
+    }
+
+    GLES2Util::updateVBO(vertexBuffersGL[name].buffer, target, offset, size, (unsigned char*)buff.data + offset);
+}
+
 bool GLES2Object::load(){
     if (!ObjectRender::load()){
         return false;
@@ -151,10 +171,8 @@ bool GLES2Object::load(){
             samplerName = "u_TextureUnit";
         }else if (type == S_TEXTURESAMPLER_SHADOWMAP2D){
             samplerName = "u_shadowsMap2D";
-            arraySize = programRender->getNumShadows2D();
         }else if (type == S_TEXTURESAMPLER_SHADOWMAPCUBE){
             samplerName = "u_shadowsMapCube";
-            arraySize = programRender->getNumShadowsCube();
         }else if (type == S_TEXTURESAMPLER_HEIGHTDATA){
             samplerName = "u_heightData";
         }else if (type == S_TEXTURESAMPLER_BLENDMAP){
@@ -248,6 +266,10 @@ bool GLES2Object::load(){
             propertyName = "u_shadowCameraNearFarCube";
         }else if (type == S_PROPERTY_NUMCASCADES2D){
             propertyName = "u_shadowNumCascades2D";
+        }else if (type == S_PROPERTY_SHADOWRECT2D){
+            propertyName = "u_shadowRect2D";
+        }else if (type == S_PROPERTY_SHADOWRECTCUBE){
+            propertyName = "u_shadowRectCube";
         }else if (type == S_PROPERTY_BONESMATRIX){
             propertyName = "u_bonesMatrix";
         }else if (type == S_PROPERTY_MORPHWEIGHTS){
@@ -296,11 +318,27 @@ bool GLES2Object::prepareDraw(){
         return false;
     }
     //Log::Debug("Start prepare");
+
+    //Global properties are already in program when it was used in this scene pass
+    bool useGlobalsStamp = (sceneRender && parent == NULL);
+    bool uploadGlobals = !useGlobalsStamp || (programRender->getGlobalsStamp() != sceneRender->getFrameStamp());
+    bool overwriteGlobals = false;
+    unsigned int uniformUploads = 0;
     
     for (std::unordered_map<int, PropertyData>::iterator it = properties.begin(); it != properties.end(); ++it)
     {
+        if (it->second.global){
+            if (!uploadGlobals)
+                continue;
+            programRender->addGlobalProperty(it->first);
+        }else if (programRender->isGlobalProperty(it->first)){
+            //Other objects must send global value again
+            overwriteGlobals = true;
+        }
+
         PropertyGlData pb = propertyGL[it->first];
         if (pb.handle != -1){
+            uniformUploads++;
             if (it->second.datatype == S_PROPERTYDATA_FLOAT1){
                 glUniform1fv(pb.handle, (GLsizei)it->second.size, (GLfloat*)it->second.data);
             }else if (it->second.datatype == S_PROPERTYDATA_FLOAT2){
@@ -329,6 +367,15 @@ bool GLES2Object::prepareDraw(){
     }
     GLES2Util::checkGlError("Error on use property on draw");
 
+    if (sceneRender)
+        sceneRender->addUniformUploads(uniformUploads);
+
+    if (overwriteGlobals){
+        programRender->setGlobalsStamp(0);
+    }else if (useGlobalsStamp && uploadGlobals){
+        programRender->setGlobalsStamp(sceneRender->getFrameStamp());
+    }
+
     GLuint lastBuffer = 0;
     GLuint actualBuffer = 0;
     for (std::unordered_map<int, AttributeData>::iterator it = vertexAttributes.begin(); it != vertexAttributes.end(); ++it)
@@ -49,6 +49,7 @@ namespace Supernova {
         virtual ~GLES2Object();
 
         virtual void updateBuffer(std::string name, unsigned int size, void* data);
+        virtual void updateBufferRange(std::string name, size_t offset, size_t size);
 
         virtual bool load();
         virtual bool prepareDraw();
@@ -9,6 +9,8 @@
 
 using namespace Supernova;
 
+GLint GLES2Program::maxFragmentUniformVectors = 0;
+
 std::string GLES2Program::getVertexShader(int shaderType){
     if (shaderType == S_SHADER_MESH){
         return gVertexMeshPerPixelLightShader;
@@ -75,10 +77,30 @@ void GLES2Program::createProgram(int shaderType, int programDefs, int numPointLi
     std::string definitions = "";
 
     this->numPointLights = std::min(MAXLIGHTS_GLES2, numPointLights);
-    this->numSpotLights = std::min(MAXLIGHTS_GLES2 - numPointLights, numSpotLights);
-    this->numDirLights = std::min(MAXLIGHTS_GLES2 - numPointLights - numSpotLights, numDirLights);
+    this->numSpotLights = std::min(MAXLIGHTS_GLES2 - this->numPointLights, numSpotLights);
+    this->numDirLights = std::min(MAXLIGHTS_GLES2 - this->numPointLights - this->numSpotLights, numDirLights);
     this->numShadows2D = std::min(MAXSHADOWS_GLES2, numShadows2D);
-    this->numShadowsCube = std::min(MAXSHADOWS_GLES2 - numShadows2D, numShadowsCube);
+    this->numShadowsCube = std::min(MAXSHADOWS_GLES2 - this->numShadows2D, numShadowsCube);
+
+    //Shadow matrices are in fragment shader, shadows that exceed uniform space are not drawn
+    if (maxFragmentUniformVectors == 0)
+        glGetIntegerv(GL_MAX_FRAGMENT_UNIFORM_VECTORS, &maxFragmentUniformVectors);
+
+    int shadows2D = this->numShadows2D;
+    int shadowsCube = this->numShadowsCube;
+
+    int freeVectors = maxFragmentUniformVectors - RESERVED_VECTORS_GLES2;
+    freeVectors -= this->numPointLights * POINTLIGHT_VECTORS_GLES2;
+    freeVectors -= this->numSpotLights * SPOTLIGHT_VECTORS_GLES2;
+    freeVectors -= this->numDirLights * DIRLIGHT_VECTORS_GLES2;
+
+    this->numShadows2D = std::max(0, std::min(this->numShadows2D, freeVectors / SHADOW2D_VECTORS_GLES2));
+    freeVectors -= this->numShadows2D * SHADOW2D_VECTORS_GLES2;
+    this->numShadowsCube = std::max(0, std::min(this->numShadowsCube, freeVectors / SHADOWCUBE_VECTORS_GLES2));
+
+    if (this->numShadows2D < shadows2D || this->numShadowsCube < shadowsCube)
+        Log::Warn("Not enough fragment uniforms, using %i of %i 2D shadows and %i of %i cube shadows", this->numShadows2D, shadows2D, this->numShadowsCube, shadowsCube);
+
     this->numBlendMapColors = numBlendMapColors;
 
     if (programDefs & S_PROGRAM_USE_FOG){
@@ -156,8 +178,8 @@ void GLES2Program::createProgram(int shaderType, int programDefs, int numPointLi
         pFragmentSource = replaceAll(pFragmentSource, "NUMBLENDMAPCOLORS", std::to_string(this->numBlendMapColors));
     }
     if (programDefs & S_PROGRAM_USE_SKINNING){
-        pVertexSource = replaceAll(pVertexSource, "MAXBONES", "70");
-        pFragmentSource = replaceAll(pFragmentSource, "MAXBONES", "70");
+        pVertexSource = replaceAll(pVertexSource, "MAXBONES", std::to_string(S_MAX_BONES));
+        pFragmentSource = replaceAll(pFragmentSource, "MAXBONES", std::to_string(S_MAX_BONES));
     }
 
     pFragmentSource = unrollLoops(pFragmentSource);
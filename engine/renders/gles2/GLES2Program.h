@@ -2,7 +2,16 @@
 #ifndef GLES2Program_h
 #define GLES2Program_h
 
+//Shadows share one atlas sampler, limit is also clamped by fragment uniform vectors
 #define MAXSHADOWS_GLES2 12
+//Fragment uniform vectors used by each light and shadow, and by other fragment uniforms
+#define POINTLIGHT_VECTORS_GLES2 4
+#define SPOTLIGHT_VECTORS_GLES2 7
+#define DIRLIGHT_VECTORS_GLES2 4
+#define SHADOW2D_VECTORS_GLES2 8
+#define SHADOWCUBE_VECTORS_GLES2 3
+#define RESERVED_VECTORS_GLES2 16
+//Lights in one draw, scenes with more lights use Scene::setMaxLightsPerObject
 #define MAXLIGHTS_GLES2 16
 
 #include "GLES2Header.h"
@@ -17,14 +26,15 @@ namespace Supernova {
         
         GLuint program;
 
+        static GLint maxFragmentUniformVectors;
+
         std::string getVertexShader(int shaderType);
         std::string getFragmentShader(int shaderType);
         
-        GLuint loadShader(GLenum shaderType, const char* pSource);
-        
-        
     public:
 
+        static GLuint loadShader(GLenum shaderType, const char* pSource);
+
         virtual void createProgram(int shaderType, int programDefs, int numPointLights, int numSpotLights, int numDirLights, int numShadows2D, int numShadowsCube, int numBlendMapColors);
         virtual void deleteProgram();
         
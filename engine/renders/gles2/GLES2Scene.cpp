@@ -3,6 +3,8 @@
 
 #include "GLES2Header.h"
 #include "GLES2Util.h"
+#include "GLES2Program.h"
+#include "GLES2Texture.h"
 #include "math/Angle.h"
 #include "Engine.h"
 #include "Log.h"
@@ -10,7 +12,29 @@
 
 using namespace Supernova;
 
+static const char* gVertexTextureShader =
+"attribute vec2 a_Position;\n"
+"uniform vec4 u_textureRect;\n"
+"varying vec2 v_TextureCoordinates;\n"
+"void main(){\n"
+"    v_TextureCoordinates = u_textureRect.xy + a_Position * u_textureRect.zw;\n"
+"    gl_Position = vec4(a_Position * 2.0 - 1.0, 0.0, 1.0);\n"
+"}\n";
+
+static const char* gFragmentTextureShader =
+"precision mediump float;\n"
+"uniform sampler2D u_TextureUnit;\n"
+"varying vec2 v_TextureCoordinates;\n"
+"void main(){\n"
+"    gl_FragColor = texture2D(u_TextureUnit, v_TextureCoordinates);\n"
+"}\n";
+
 GLES2Scene::GLES2Scene(): SceneRender() {
+    textureProgram = 0;
+    textureBuffer = 0;
+    texturePositionHandle = -1;
+    textureRectHandle = -1;
+    textureUnitHandle = -1;
 /*
     GLint redBits = 0;
     GLint greenBits = 0;
@@ -34,6 +58,10 @@ GLES2Scene::GLES2Scene(): SceneRender() {
 }
 
 GLES2Scene::~GLES2Scene() {
+    if (textureProgram)
+        glDeleteProgram(textureProgram);
+    if (textureBuffer)
+        glDeleteBuffers(1, &textureBuffer);
 }
 
 
@@ -101,22 +129,112 @@ bool GLES2Scene::enableScissor(Rect rect){
 
     glEnable(GL_SCISSOR_TEST);
 
+    scissorEnabled = true;
+    activeScissor = rect;
+
     return true;
 }
 
 bool GLES2Scene::disableScissor(){
     glDisable(GL_SCISSOR_TEST);
 
+    scissorEnabled = false;
+
+    return true;
+}
+
+bool GLES2Scene::beginDepthPrePass(){
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LEQUAL);
+
     return true;
 }
 
-bool GLES2Scene::isEnabledScissor(){
-    return glIsEnabled(GL_SCISSOR_TEST);
+bool GLES2Scene::beginDepthTestedPass(){
+    //Same depth is accepted, positions are invariant between depth and color programs
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_FALSE);
+    glDepthFunc(GL_LEQUAL);
+
+    return true;
+}
+
+bool GLES2Scene::endDepthPrePass(){
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LEQUAL);
+
+    GLES2Util::checkGlError("Error on depth pre-pass");
+
+    return true;
+}
+
+bool GLES2Scene::loadTextureProgram(){
+    GLuint vertexShader = GLES2Program::loadShader(GL_VERTEX_SHADER, gVertexTextureShader);
+    GLuint pixelShader = GLES2Program::loadShader(GL_FRAGMENT_SHADER, gFragmentTextureShader);
+    if (!vertexShader || !pixelShader){
+        Log::Error("Could not load texture shaders");
+        return false;
+    }
+
+    textureProgram = glCreateProgram();
+    glAttachShader(textureProgram, vertexShader);
+    glAttachShader(textureProgram, pixelShader);
+    glLinkProgram(textureProgram);
+    glDeleteShader(vertexShader);
+    glDeleteShader(pixelShader);
+
+    GLint linkStatus = GL_FALSE;
+    glGetProgramiv(textureProgram, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus != GL_TRUE){
+        Log::Error("Could not link texture program");
+        glDeleteProgram(textureProgram);
+        textureProgram = 0;
+        return false;
+    }
+
+    texturePositionHandle = glGetAttribLocation(textureProgram, "a_Position");
+    textureRectHandle = glGetUniformLocation(textureProgram, "u_textureRect");
+    textureUnitHandle = glGetUniformLocation(textureProgram, "u_TextureUnit");
+
+    static const GLfloat quad[] = { 0, 0, 1, 0, 0, 1, 1, 1 };
+    textureBuffer = GLES2Util::createVBO();
+    GLES2Util::dataVBO(textureBuffer, GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
+
+    GLES2Util::checkGlError("Error on load texture program");
+
+    return true;
 }
 
-Rect GLES2Scene::getActiveScissor(){
-    int rect[4];
-    glGetIntegerv(GL_SCISSOR_BOX, rect);
+bool GLES2Scene::drawTexture(Texture* texture, Rect textureRect){
+    if (!texture || !texture->getTextureRender())
+        return false;
+
+    if (!textureProgram && !loadTextureProgram())
+        return false;
 
-    return Rect(rect[0], rect[1], rect[2], rect[3]);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+
+    glUseProgram(textureProgram);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, ((GLES2Texture*)(texture->getTextureRender().get()))->getTexture());
+    glUniform1i(textureUnitHandle, 0);
+    glUniform4f(textureRectHandle, textureRect.getX(), textureRect.getY(), textureRect.getWidth(), textureRect.getHeight());
+
+    glBindBuffer(GL_ARRAY_BUFFER, textureBuffer);
+    glEnableVertexAttribArray(texturePositionHandle);
+    glVertexAttribPointer(texturePositionHandle, 2, GL_FLOAT, GL_FALSE, 0, 0);
+
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    glDisableVertexAttribArray(texturePositionHandle);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    GLES2Util::checkGlError("Error on draw texture");
+
+    return true;
 }
+
@@ -13,6 +13,16 @@ namespace Supernova {
         
     friend class GLES2Mesh;
     friend class GLES2Point;
+
+    private:
+
+        GLuint textureProgram;
+        GLuint textureBuffer;
+        GLint texturePositionHandle;
+        GLint textureRectHandle;
+        GLint textureUnitHandle;
+
+        bool loadTextureProgram();
         
     public:
         
@@ -26,8 +36,12 @@ namespace Supernova {
         virtual bool enableScissor(Rect rect);
         virtual bool disableScissor();
 
-        virtual bool isEnabledScissor();
-        virtual Rect getActiveScissor();
+        virtual bool beginDepthPrePass();
+        virtual bool beginDepthTestedPass();
+        virtual bool endDepthPrePass();
+
+        virtual bool drawTexture(Texture* texture, Rect textureRect);
+
     };
     
 }
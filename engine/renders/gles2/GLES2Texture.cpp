@@ -3,6 +3,7 @@
 #include "Scene.h"
 #include "Log.h"
 #include "GLES2Util.h"
+#include <string.h>
 
 using namespace Supernova;
 
@@ -64,3 +64,11 @@ void GLES2Util::updateVBO(GLuint vbo_object, GLenum target, const GLsizeiptr siz
 
 }
 
+void GLES2Util::updateVBO(GLuint vbo_object, GLenum target, const GLintptr offset, const GLsizeiptr size, const GLvoid* data) {
+
+    glBindBuffer(target, vbo_object);
+    glBufferSubData(target, offset, size, data);
+    glBindBuffer(target, 0);
+
+}
+
@@ -23,6 +23,7 @@ namespace Supernova {
         static GLuint createVBO();
         static void dataVBO(GLuint vbo_object, GLenum target, const GLsizeiptr size, const GLvoid* data, const GLenum usage);
         static void updateVBO(GLuint vbo_object, GLenum target, const GLsizeiptr size, const GLvoid* data);
+        static void updateVBO(GLuint vbo_object, GLenum target, const GLintptr offset, const GLsizeiptr size, const GLvoid* data);
 
     };
     
@@ -13,11 +13,6 @@ std::string lightingVertexDec =
         "  varying vec3 v_worldPos;\n"
         "  varying vec3 v_worldNormal;\n"
 
-        "  #ifdef USE_SHADOWS2D\n"
-        "    uniform mat4 u_ShadowVP[NUMSHADOWS2D];\n"
-        "    varying vec4 v_ShadowCoordinates[NUMSHADOWS2D];\n"
-        "  #endif\n"
-
         "#endif\n";
 
 std::string lightingVertexImp =
@@ -26,13 +21,6 @@ std::string lightingVertexImp =
         "  v_worldPos = vec3(u_mMatrix * vec4(localPos, 1.0));\n"
         "  v_worldNormal = normalize(vec3(u_nMatrix * vec4(localNormal, 1.0)));\n"
 
-        "  #ifdef USE_SHADOWS2D\n"
-        "    #pragma unroll_loop\n"
-        "    for(int i = 0; i < NUMSHADOWS2D; ++i){\n"
-        "        v_ShadowCoordinates[i] = u_ShadowVP[i] * vec4(v_worldPos, 1.0);\n"
-        "    }\n"
-        "  #endif\n"
-
         "#endif\n";
 
 std::string lightingFragmentDec =
@@ -67,15 +55,18 @@ std::string lightingFragmentDec =
         "  varying vec3 v_worldPos;\n"
         "  varying vec3 v_worldNormal;\n"
 
+        //Shadow maps are tiles of one atlas, rects have offset in xy and scale in zw
         "  #ifdef USE_SHADOWS2D\n"
-        "    uniform sampler2D u_shadowsMap2D[NUMSHADOWS2D];\n"
+        "    uniform sampler2D u_shadowsMap2D;\n"
+        "    uniform mat4 u_ShadowVP[NUMSHADOWS2D];\n"
+        "    uniform vec4 u_shadowRect2D[NUMSHADOWS2D];\n"
         "    uniform float u_shadowBias2D[NUMSHADOWS2D];\n"
         "    uniform vec2 u_shadowCameraNearFar2D[NUMSHADOWS2D];\n"
         "    uniform int u_shadowNumCascades2D[NUMSHADOWS2D];\n"
-        "    varying vec4 v_ShadowCoordinates[NUMSHADOWS2D];\n"
         "  #endif\n"
         "  #ifdef USE_SHADOWSCUBE\n"
-        "    uniform samplerCube u_shadowsMapCube[NUMSHADOWSCUBE];\n"
+        "    uniform sampler2D u_shadowsMapCube;\n"
+        "    uniform vec4 u_shadowRectCube[NUMSHADOWSCUBE];\n"
         "    uniform float u_shadowBiasCube[NUMSHADOWSCUBE];\n"
         "    uniform vec2 u_shadowCameraNearFarCube[NUMSHADOWSCUBE];\n"
         "  #endif\n"
@@ -86,10 +77,14 @@ std::string lightingFragmentDec =
         "  }\n"
 
         "  #ifdef USE_SHADOWS2D\n"
-        "    bool checkShadow(vec4 shadowCoordinates, sampler2D shadowMap, float shadowBias, vec2 shadowCameraNearFar, float cosTheta, float clipSpacePosZ) {\n"
+        "    bool checkShadow(mat4 shadowVP, vec4 shadowRect, float shadowBias, vec2 shadowCameraNearFar, float cosTheta, float clipSpacePosZ) {\n"
         "        if ((clipSpacePosZ >= shadowCameraNearFar.x) && (clipSpacePosZ <= shadowCameraNearFar.y)){\n"
+        "            vec4 shadowCoordinates = shadowVP * vec4(v_worldPos, 1.0);\n"
         "            vec3 shadowCoord = (shadowCoordinates.xyz/shadowCoordinates.w)/2.0 + 0.5;\n"
-        "            vec4 rgbaDepth = texture2D(shadowMap, shadowCoord.xy);\n"
+        //Outside of tile is other shadow map
+        "            if (shadowRect.z <= 0.0 || any(lessThan(shadowCoord.xy, vec2(0.0))) || any(greaterThan(shadowCoord.xy, vec2(1.0))))\n"
+        "                return false;\n"
+        "            vec4 rgbaDepth = texture2D(u_shadowsMap2D, shadowRect.xy + shadowCoord.xy * shadowRect.zw);\n"
         //"          float depth = unpackDepth(rgbaDepth);\n"
         "            float depth = rgbaDepth.r;\n"
         "            float bias = shadowBias*tan(acos(cosTheta));\n"
@@ -103,10 +98,35 @@ std::string lightingFragmentDec =
         "  #endif\n"
 
         "  #ifdef USE_SHADOWSCUBE\n"
-        "    bool checkShadowCube(vec3 lightPos, samplerCube shadowMap, float shadowBias, vec2 shadowCameraNearFar) {\n"
-        "        lightPos = vec3(lightPos.x, lightPos.y, lightPos.z);\n"
+        //Same face selection of cube map sampling, faces are a 3x2 grid in tile
+        "    vec2 cubeFaceCoord(vec3 dir, out float face) {\n"
+        "        vec3 absDir = abs(dir);\n"
+        "        float ma;\n"
+        "        vec2 sc;\n"
+        "        if (absDir.x >= absDir.y && absDir.x >= absDir.z){\n"
+        "            ma = absDir.x;\n"
+        "            if (dir.x > 0.0){ face = 0.0; sc = vec2(-dir.z, -dir.y); }\n"
+        "            else { face = 1.0; sc = vec2(dir.z, -dir.y); }\n"
+        "        }else if (absDir.y >= absDir.z){\n"
+        "            ma = absDir.y;\n"
+        "            if (dir.y > 0.0){ face = 2.0; sc = vec2(dir.x, dir.z); }\n"
+        "            else { face = 3.0; sc = vec2(dir.x, -dir.z); }\n"
+        "        }else{\n"
+        "            ma = absDir.z;\n"
+        "            if (dir.z > 0.0){ face = 4.0; sc = vec2(dir.x, -dir.y); }\n"
+        "            else { face = 5.0; sc = vec2(-dir.x, -dir.y); }\n"
+        "        }\n"
+        "        return (sc / ma + 1.0) * 0.5;\n"
+        "    }\n"
+
+        "    bool checkShadowCube(vec3 lightPos, vec4 shadowRect, float shadowBias, vec2 shadowCameraNearFar) {\n"
+        "        if (shadowRect.z <= 0.0)\n"
+        "            return false;\n"
         "        vec3 fragToLight = v_worldPos - lightPos;\n"
-        "        float lenDepthMap = unpackDepth(textureCube(shadowMap, fragToLight));\n"
+        "        float face;\n"
+        "        vec2 faceCoord = clamp(cubeFaceCoord(fragToLight, face), 0.0, 0.999);\n"
+        "        vec2 faceOffset = vec2(mod(face, 3.0), floor(face / 3.0));\n"
+        "        float lenDepthMap = unpackDepth(texture2D(u_shadowsMapCube, shadowRect.xy + (faceOffset + faceCoord) * shadowRect.zw));\n"
         "        float lenToLight = (length(fragToLight) - shadowCameraNearFar.x) / (shadowCameraNearFar.y - shadowCameraNearFar.x);\n"
         "        float bias = shadowBias;\n"
         "        if ((lenToLight < 1.0 - bias) && (lenToLight > lenDepthMap + bias)){\n"
@@ -146,7 +166,7 @@ std::string lightingFragmentImp =
         "          #pragma unroll_loop\n"
         "          for(int j = 0; j < NUMSHADOWSCUBE; j++){\n"
         "              if (u_PointLightShadowIdx[i] == (j))\n"
-        "                  inShadow = checkShadowCube(u_PointLightPos[i], u_shadowsMapCube[j], u_shadowBiasCube[j], u_shadowCameraNearFarCube[j]);\n"
+        "                  inShadow = checkShadowCube(u_PointLightPos[i], u_shadowRectCube[j], u_shadowBiasCube[j], u_shadowCameraNearFarCube[j]);\n"
         "          }\n"
         "        #endif\n"
 
@@ -183,7 +203,7 @@ std::string lightingFragmentImp =
         "          #pragma unroll_loop\n"
         "          for(int j = 0; j < NUMSHADOWS2D; j++){\n"
         "              if (u_SpotLightShadowIdx[i] == (j))\n"
-        "                  inShadow = checkShadow(v_ShadowCoordinates[j], u_shadowsMap2D[j], u_shadowBias2D[j], u_shadowCameraNearFar2D[j], SpotLightcosTheta, clipSpacePosZ);\n"
+        "                  inShadow = checkShadow(u_ShadowVP[j], u_shadowRect2D[j], u_shadowBias2D[j], u_shadowCameraNearFar2D[j], SpotLightcosTheta, clipSpacePosZ);\n"
         "          }\n"
         "        #endif\n"
 
@@ -222,7 +242,7 @@ std::string lightingFragmentImp =
         "          #pragma unroll_loop\n"
         "          for(int j = 0; j < NUMSHADOWS2D; j++){\n"
         "              if ((u_DirectionalLightShadowIdx[i] <= (j)) && ((u_DirectionalLightShadowIdx[i] + u_shadowNumCascades2D[j]) > (j)))\n"
-        "                  if (checkShadow(v_ShadowCoordinates[j], u_shadowsMap2D[j], u_shadowBias2D[j], u_shadowCameraNearFar2D[j], DirectionalLightcosTheta, clipSpacePosZ))\n"
+        "                  if (checkShadow(u_ShadowVP[j], u_shadowRect2D[j], u_shadowBias2D[j], u_shadowCameraNearFar2D[j], DirectionalLightcosTheta, clipSpacePosZ))\n"
         "                      nShadows += 1;\n"
         "          }\n"
         "        #endif\n"
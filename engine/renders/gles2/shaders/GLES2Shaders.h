@@ -89,6 +89,7 @@ std::string gFragmentPointsPerPixelLightShader =
 "}\n";
 
 std::string gVertexMeshPerPixelLightShader =
+"invariant gl_Position;\n"
 "uniform mat4 u_mvpMatrix;\n"
 "uniform mat4 u_mMatrix;\n"
 "uniform vec3 u_EyePos;\n"
@@ -144,6 +145,7 @@ std::string gFragmentMeshPerPixelLightShader =
 "}\n";
 
 std::string gVertexDepthShader =
+"invariant gl_Position;\n"
 "uniform mat4 u_mvpMatrix;\n"
 "uniform mat4 u_mMatrix;\n"
 "uniform vec3 u_EyePos;\n"
@@ -0,0 +1,170 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Object.h"
+#include "util/AsyncLoader.h"
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+using namespace Supernova;
+
+//Main thread changes and deletes children while loader threads preload the tree
+
+static std::mutex aliveMutex;
+static std::set<const void*> alive;
+static int deadPreloads = 0;
+
+class PreloadObject: public Object{
+public:
+    int preloads;
+
+    PreloadObject(){
+        preloads = 0;
+        std::unique_lock<std::mutex> lock(aliveMutex);
+        alive.insert(this);
+    }
+
+    virtual ~PreloadObject(){
+        cancelLoadAsync();
+        std::unique_lock<std::mutex> lock(aliveMutex);
+        alive.erase(this);
+    }
+
+    virtual bool preload(){
+        {
+            std::unique_lock<std::mutex> lock(aliveMutex);
+            if (alive.find(this) == alive.end())
+                deadPreloads++;
+        }
+        preloads++;
+        //Gives time to main thread to change tree
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+
+        return Object::preload();
+    }
+};
+
+static void waitLoader(){
+    while (AsyncLoader::hasPending()){
+        AsyncLoader::processCompleted(1);
+        std::this_thread::yield();
+    }
+}
+
+static void testTree(unsigned int numThreads){
+    AsyncLoader::setNumThreads(numThreads);
+
+    for (int round = 0; round < 50; round++){
+        PreloadObject* root = new PreloadObject();
+        std::vector<PreloadObject*> children;
+        std::vector<PreloadObject*> grandchildren;
+
+        for (int i = 0; i < 20; i++){
+            PreloadObject* child = new PreloadObject();
+            root->addObject(child);
+            children.push_back(child);
+            for (int j = 0; j < 2; j++){
+                PreloadObject* grandchild = new PreloadObject();
+                child->addObject(grandchild);
+                grandchildren.push_back(grandchild);
+            }
+        }
+
+        int loadCalls = 0;
+        root->onLoad = [&loadCalls](Object* object){
+            loadCalls++;
+        };
+
+        S_CHECK(root->loadAsync());
+        S_CHECK(!root->loadAsync());
+
+        //Tree is changed while preload can be running
+        for (int i = 0; i < 20; i += 3){
+            delete grandchildren[i * 2];
+            grandchildren[i * 2] = NULL;
+            delete children[i];
+            children[i] = NULL;
+        }
+        PreloadObject* added = new PreloadObject();
+        root->addObject(added);
+
+        waitLoader();
+
+        S_CHECK(loadCalls == 1);
+        S_CHECK(root->getLoadState() == S_LOADSTATE_LOADED);
+        S_CHECK(root->preloads == 1);
+        //Added after list was made, only loaded in main thread
+        S_CHECK(added->preloads == 0);
+        S_CHECK(added->isLoaded());
+
+        bool preloadedOnce = true;
+        bool loaded = true;
+        for (int i = 0; i < 20; i++){
+            if (children[i]){
+                if (children[i]->preloads > 1)
+                    preloadedOnce = false;
+                if (!children[i]->isLoaded())
+                    loaded = false;
+            }
+        }
+        S_CHECK(preloadedOnce);
+        S_CHECK(loaded);
+
+        for (size_t i = 0; i < grandchildren.size(); i++)
+            delete grandchildren[i];
+        for (size_t i = 0; i < children.size(); i++)
+            delete children[i];
+        delete added;
+        delete root;
+    }
+
+    S_CHECK(deadPreloads == 0);
+    S_CHECK(!AsyncLoader::hasPending());
+}
+
+static void testMainThread(){
+    //Without loader threads work is done by processCompleted, so results are deterministic
+    AsyncLoader::setNumThreads(0);
+
+    PreloadObject* root = new PreloadObject();
+    PreloadObject* first = new PreloadObject();
+    PreloadObject* second = new PreloadObject();
+    root->addObject(first);
+    root->addObject(second);
+
+    S_CHECK(root->loadAsync());
+    delete first;
+
+    waitLoader();
+
+    S_CHECK(root->preloads == 1);
+    S_CHECK(second->preloads == 1);
+    S_CHECK(second->isLoaded());
+
+    //Destroyed owner discards pending task
+    PreloadObject* cancelled = new PreloadObject();
+    S_CHECK(cancelled->loadAsync());
+    delete cancelled;
+    S_CHECK(!AsyncLoader::hasPending());
+
+    delete second;
+    delete root;
+
+    S_CHECK(deadPreloads == 0);
+}
+
+int main(){
+    testMainThread();
+    testTree(1);
+    testTree(3);
+
+    AsyncLoader::deInit();
+
+    return S_TEST_RESULT();
+}
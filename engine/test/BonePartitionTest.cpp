@@ -0,0 +1,81 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "util/BonePartition.h"
+#include <stdlib.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Every triangle must be in one batch and all its bones must be in batch palette
+
+int main(){
+    srand(7);
+
+    const int numBones = 120;
+    const int numVertices = 3000;
+    const size_t maxBones = 32;
+
+    std::vector<int> vertexBones(numVertices * 4);
+    for (int v = 0; v < numVertices; v++){
+        //Neighbour vertices use near bones, last influence sometimes unused
+        int base = (v * numBones) / numVertices;
+        for (int j = 0; j < 4; j++)
+            vertexBones[v * 4 + j] = (base + rand() % 4) % numBones;
+        if (rand() % 2)
+            vertexBones[v * 4 + 3] = -1;
+    }
+
+    std::vector<unsigned int> indices;
+    for (int v = 0; v + 2 < numVertices; v++){
+        indices.push_back(v);
+        indices.push_back(v + 1);
+        indices.push_back(v + 2);
+    }
+
+    std::vector<BonePartition::Batch> batches = BonePartition::partition(indices, vertexBones, maxBones);
+
+    S_CHECK(batches.size() > 1);
+
+    size_t numIndices = 0;
+    bool palettesFit = true;
+    bool bonesFound = true;
+    bool uniqueSlots = true;
+    for (size_t b = 0; b < batches.size(); b++){
+        const BonePartition::Batch& batch = batches[b];
+        numIndices += batch.indices.size();
+
+        if (batch.bones.size() > maxBones)
+            palettesFit = false;
+
+        for (size_t i = 0; i < batch.bones.size(); i++){
+            if (BonePartition::getSlot(batch, batch.bones[i]) != (int)i)
+                uniqueSlots = false;
+        }
+
+        for (size_t i = 0; i < batch.indices.size(); i++){
+            unsigned int vertex = batch.indices[i];
+            for (int j = 0; j < 4; j++){
+                int bone = vertexBones[vertex * 4 + j];
+                if (bone >= 0 && BonePartition::getSlot(batch, bone) < 0)
+                    bonesFound = false;
+            }
+        }
+    }
+
+    S_CHECK(numIndices == indices.size());
+    S_CHECK(palettesFit);
+    S_CHECK(bonesFound);
+    S_CHECK(uniqueSlots);
+
+    //Skin with less bones than limit is one batch with original order
+    std::vector<BonePartition::Batch> single = BonePartition::partition(indices, vertexBones, numBones);
+    S_CHECK(single.size() == 1);
+    S_CHECK(single.size() == 1 && single[0].indices == indices);
+
+    S_CHECK(BonePartition::getSlot(single[0], numBones + 1) == -1);
+
+    return S_TEST_RESULT();
+}
@@ -0,0 +1,71 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Engine.h"
+
+using namespace Supernova;
+
+//Fixed timestep loop driven by a fake clock, no scene
+
+static unsigned long fakeTime = 1000;
+
+static unsigned long fakeClock(){
+    return fakeTime;
+}
+
+static int updates = 0;
+
+static void countUpdate(){
+    updates++;
+}
+
+static void frame(unsigned long ms){
+    fakeTime += ms;
+    Engine::systemDraw();
+}
+
+int main(){
+    Engine::onUpdate = countUpdate;
+    Engine::setClockFunction(fakeClock);
+
+    Engine::setUpdateTime(10);
+    Engine::setMaxFrameDelta(100);
+    Engine::setMaxUpdateSteps(5);
+
+    //Steady frames: updates follow elapsed time, alpha is the remaining fraction
+    bool alphaInRange = true;
+    for (int i = 0; i < 100; i++){
+        frame(16);
+        if (Engine::getUpdateAlpha() < 0 || Engine::getUpdateAlpha() >= 1)
+            alphaInRange = false;
+    }
+    S_CHECK(alphaInRange);
+    S_CHECK(updates >= 159 && updates <= 160);
+    S_CHECK((int)Engine::getUpdateSteps() == updates);
+    S_CHECK_NEAR(Engine::getDeltatime(), 0.016, 0.0001);
+    S_CHECK_NEAR(Engine::getDroppedTime(), 0, 0.0001);
+
+    //Hitch: frame delta is clamped and remaining time is dropped
+    int before = updates;
+    frame(1000);
+    S_CHECK(updates - before == 5);
+    S_CHECK_NEAR(Engine::getDroppedTime(), 0.950, 0.011);
+
+    //Next frames are not slowed by the hitch
+    before = updates;
+    frame(20);
+    S_CHECK(updates - before >= 1 && updates - before <= 3);
+
+    //Fast frames only accumulate time
+    before = updates;
+    frame(3);
+    frame(3);
+    frame(3);
+    S_CHECK(updates - before <= 1);
+
+    Engine::setClockFunction(NULL);
+
+    return S_TEST_RESULT();
+}
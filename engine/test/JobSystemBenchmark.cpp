@@ -0,0 +1,45 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "util/JobSystem.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+using namespace Supernova;
+
+//parallelFor over a transform-like workload with 1 to 16 threads (calling thread included)
+
+int main(){
+    const size_t count = 1000000;
+    const int iterations = 20;
+
+    std::vector<float> values(count, 1.0f);
+
+    for (unsigned int threads = 1; threads <= 16; threads *= 2){
+        JobSystem::setNumThreads(threads - 1);
+        JobSystem::init();
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int it = 0; it < iterations; it++){
+            JobSystem::parallelFor(count, 0, [&values](size_t begin, size_t end){
+                for (size_t i = begin; i < end; i++){
+                    float v = values[i];
+                    for (int k = 0; k < 16; k++)
+                        v = sqrtf(v * 1.0001f + 0.5f);
+                    values[i] = v;
+                }
+            });
+        }
+
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        printf("JobSystem parallelFor %zu items, %2u threads: %8.3f ms\n", count, threads, ms / iterations);
+    }
+
+    JobSystem::deInit();
+
+    return 0;
+}
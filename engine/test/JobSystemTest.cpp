@@ -0,0 +1,84 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "util/JobSystem.h"
+#include <atomic>
+#include <vector>
+
+using namespace Supernova;
+
+static void testRun(){
+    std::atomic<int> sum(0);
+    JobCounter counter;
+
+    for (int i = 1; i <= 10000; i++){
+        JobSystem::run([&sum, i](){ sum += i; }, &counter);
+    }
+    JobSystem::wait(&counter);
+
+    S_CHECK(counter.isDone());
+    S_CHECK(sum.load() == 50005000);
+}
+
+static void testNested(){
+    std::atomic<int> sum(0);
+    JobCounter counter;
+
+    //Jobs creating jobs, inner waits must help executing instead of blocking workers
+    for (int i = 0; i < 64; i++){
+        JobSystem::run([&sum](){
+            JobCounter inner;
+            for (int j = 0; j < 64; j++){
+                JobSystem::run([&sum](){ sum++; }, &inner);
+            }
+            JobSystem::wait(&inner);
+            sum++;
+        }, &counter);
+    }
+    JobSystem::wait(&counter);
+
+    S_CHECK(sum.load() == 64 * 65);
+}
+
+static void testParallelFor(size_t count, size_t grainSize){
+    std::vector<int> values(count, 0);
+
+    JobSystem::parallelFor(count, grainSize, [&values](size_t begin, size_t end){
+        for (size_t i = begin; i < end; i++)
+            values[i]++;
+    });
+
+    //Every index must be visited exactly once
+    bool once = true;
+    for (size_t i = 0; i < count; i++){
+        if (values[i] != 1)
+            once = false;
+    }
+    S_CHECK(once);
+}
+
+static void testAll(){
+    testRun();
+    testNested();
+    testParallelFor(1, 0);
+    testParallelFor(1000, 1);
+    testParallelFor(100003, 0);
+    testParallelFor(100003, 4096);
+}
+
+int main(){
+    unsigned int threads[] = {0, 1, 3, 7};
+
+    for (unsigned int t = 0; t < 4; t++){
+        JobSystem::setNumThreads(threads[t]);
+        JobSystem::init();
+        for (int i = 0; i < 10; i++)
+            testAll();
+    }
+
+    JobSystem::deInit();
+
+    return S_TEST_RESULT();
+}
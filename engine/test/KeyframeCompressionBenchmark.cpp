@@ -0,0 +1,121 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Object.h"
+#include "action/keyframe/TranslateTracks.h"
+#include "action/keyframe/RotateTracks.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Memory and sampling cost of baked clips, raw tracks against tracks compressed with 1cm and 0.005 rad tolerances
+
+#define NUM_OBJECTS 200
+#define NUM_KEYS 1800
+#define KEYS_PER_SECOND 30.0f
+
+class MeasuredTranslateTracks: public TranslateTracks {
+public:
+    MeasuredTranslateTracks(std::vector<float> times, std::vector<Vector3> values): TranslateTracks(times, values){ }
+
+    size_t getBytes(){
+        return times.size() * sizeof(float) + values.size() * sizeof(Vector3) + packedValues.size() * sizeof(uint16_t);
+    }
+};
+
+class MeasuredRotateTracks: public RotateTracks {
+public:
+    MeasuredRotateTracks(std::vector<float> times, std::vector<Quaternion> values): RotateTracks(times, values){ }
+
+    size_t getBytes(){
+        return times.size() * sizeof(float) + values.size() * sizeof(Quaternion) + packedValues.size() * sizeof(uint16_t);
+    }
+};
+
+static float noise(){
+    return ((float)rand() / (float)RAND_MAX - 0.5f) * 0.0002f;
+}
+
+static void benchmark(bool compressed){
+    const int frames = 600;
+
+    srand(11);
+
+    std::vector<Object*> objects;
+    std::vector<MeasuredTranslateTracks*> translates;
+    std::vector<MeasuredRotateTracks*> rotates;
+    size_t bytes = 0;
+    size_t keys = 0;
+
+    for (int o = 0; o < NUM_OBJECTS; o++){
+        std::vector<float> times;
+        std::vector<Vector3> positions;
+        std::vector<Quaternion> rotations;
+        float phase = o * 0.1f;
+        for (int k = 0; k < NUM_KEYS; k++){
+            float t = k / KEYS_PER_SECOND;
+            times.push_back(t);
+            positions.push_back(Vector3(sinf(t + phase) * 10 + noise(), t * 2 + noise(), cosf(t * 0.5f) * 3 + noise()));
+            Quaternion rotation;
+            rotation.fromAngleAxis(sinf(t + phase) * 90, Vector3(0, 1, 0));
+            rotations.push_back(rotation);
+        }
+
+        MeasuredTranslateTracks* translate = new MeasuredTranslateTracks(times, positions);
+        MeasuredRotateTracks* rotate = new MeasuredRotateTracks(times, rotations);
+        if (compressed){
+            translate->compress(0.01);
+            rotate->compress(0.005);
+        }
+
+        Object* object = new Object();
+        object->addAction(translate);
+        object->addAction(rotate);
+        translate->setDuration(times.back());
+        rotate->setDuration(times.back());
+        translate->run();
+        rotate->run();
+
+        bytes += translate->getBytes() + rotate->getBytes();
+        keys += translate->getTimes().size() + rotate->getTimes().size();
+
+        objects.push_back(object);
+        translates.push_back(translate);
+        rotates.push_back(rotate);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < frames; f++){
+        for (int o = 0; o < NUM_OBJECTS; o++){
+            translates[o]->update(1.0f / 60.0f);
+            rotates[o]->update(1.0f / 60.0f);
+        }
+    }
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    printf("%s: %zu keys, %.1f KB, %.3f ms per frame\n", compressed ? "Compressed" : "Raw", keys, bytes / 1024.0, elapsed);
+
+    for (int o = 0; o < NUM_OBJECTS; o++){
+        objects[o]->removeAction(translates[o]);
+        objects[o]->removeAction(rotates[o]);
+        delete translates[o];
+        delete rotates[o];
+        delete objects[o];
+    }
+}
+
+int main(){
+    printf("Objects: %i, translate and rotate tracks of %i keys\n", NUM_OBJECTS, NUM_KEYS);
+
+    benchmark(false);
+    benchmark(true);
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Object.h"
+#include "action/keyframe/TranslateTracks.h"
+#include "action/keyframe/RotateTracks.h"
+#include "action/keyframe/KeyframeCompression.h"
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Compressed tracks sampled at removed keys stay within tolerance plus quantization error
+
+static const int numKeys = 600;
+
+static float noise(){
+    return ((float)rand() / (float)RAND_MAX - 0.5f) * 0.0002f;
+}
+
+//Plays track sampling object at each original key time
+template<class T, class V>
+static float maxError(T* track, const std::vector<float>& times, const std::vector<V>& values, std::function<float(Object*, const V&)> error){
+    Object object;
+    object.addAction(track);
+    track->setDuration(times.back());
+    track->run();
+
+    float result = 0;
+    float time = 0;
+    for (size_t k = 1; k < times.size() - 1; k++){
+        track->update(times[k] - time);
+        time = times[k];
+        result = std::max(result, error(&object, values[k]));
+    }
+
+    object.removeAction(track);
+
+    return result;
+}
+
+static void testTranslate(float tolerance){
+    std::vector<float> times;
+    std::vector<Vector3> values;
+    for (int k = 0; k < numKeys; k++){
+        float t = k / 30.0f;
+        times.push_back(t);
+        values.push_back(Vector3(sinf(t) * 10 + noise(), t * 2 + noise(), cosf(t * 0.5f) * 3 + noise()));
+    }
+
+    TranslateTracks track(times, values);
+    track.compress(tolerance);
+
+    S_CHECK(track.isCompressed());
+    S_CHECK(track.getTimes().size() < times.size() / 2);
+    S_CHECK(track.getTimes().front() == times.front() && track.getTimes().back() == times.back());
+
+    Vector3 minimum, range;
+    KeyframeCompression::getRange(values, minimum, range);
+    float quantization = range.length() / 65535.0f;
+
+    float error = maxError<TranslateTracks, Vector3>(&track, times, values, [](Object* object, const Vector3& value){
+        return object->getPosition().distance(value);
+    });
+    S_CHECK(error <= tolerance + quantization + 0.0001f);
+}
+
+static void testRotate(float tolerance){
+    std::vector<float> times;
+    std::vector<Quaternion> values;
+    for (int k = 0; k < numKeys; k++){
+        float t = k / 30.0f;
+        times.push_back(t);
+        Quaternion q;
+        q.fromAngleAxis(t * 40 + sinf(t) * 20, Vector3(sinf(t * 0.3f), 1, 0.2f).normalize());
+        values.push_back(q);
+    }
+
+    RotateTracks track(times, values);
+    track.compress(tolerance);
+
+    S_CHECK(track.isCompressed());
+    S_CHECK(track.getTimes().size() < times.size());
+
+    float error = maxError<RotateTracks, Quaternion>(&track, times, values, [](Object* object, const Quaternion& value){
+        return KeyframeCompression::getQuaternionAngle(object->getRotation(), value);
+    });
+    S_CHECK(error <= tolerance + 0.002f);
+}
+
+static void testQuantization(){
+    bool quaternions = true;
+    bool vectors = true;
+
+    for (int i = 0; i < 10000; i++){
+        Quaternion q(rand() - RAND_MAX / 2, rand() - RAND_MAX / 2, rand() - RAND_MAX / 2, rand() - RAND_MAX / 2);
+        q.normalise();
+
+        uint16_t packed[3];
+        KeyframeCompression::packQuaternion(q, packed);
+        //Angle from float acos has about 0.001 rad of resolution
+        if (KeyframeCompression::getQuaternionAngle(q, KeyframeCompression::unpackQuaternion(packed)) > 0.002f)
+            quaternions = false;
+
+        Vector3 minimum(-5, 0, 10);
+        Vector3 range(10, 1, 100);
+        Vector3 v(minimum.x + range.x * rand() / RAND_MAX, minimum.y + range.y * rand() / RAND_MAX, minimum.z + range.z * rand() / RAND_MAX);
+        uint16_t packedVector[3];
+        KeyframeCompression::packVector3(v, minimum, range, packedVector);
+        if (KeyframeCompression::unpackVector3(packedVector, minimum, range).distance(v) > range.length() / 65535.0f)
+            vectors = false;
+    }
+
+    S_CHECK(quaternions);
+    S_CHECK(vectors);
+}
+
+int main(){
+    srand(3);
+
+    testQuantization();
+
+    testTranslate(0.01f);
+    testTranslate(0.1f);
+    testRotate(0.01f);
+    testRotate(0.05f);
+
+    return S_TEST_RESULT();
+}
@@ -0,0 +1,84 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "action/keyframe/KeyframeTrack.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+using namespace Supernova;
+
+//200 tracks of 5000 keys played forward, playhead cursor against previous scan from first key
+
+class LinearScanTrack: public KeyframeTrack {
+public:
+    LinearScanTrack(std::vector<float> times): KeyframeTrack(times){ }
+
+    virtual bool update(float interval){
+        if (!TimeAction::update(interval))
+            return false;
+
+        if (times.size() == 0)
+            return false;
+
+        float actualTime = duration * value;
+
+        if (actualTime < times[0]) {
+            index = 0;
+            progress = 0;
+            return true;
+        }
+
+        index = 0;
+        while ((index+1) < times.size() && times[index+1] < actualTime){
+            index++;
+        }
+
+        return true;
+    }
+};
+
+template<class T>
+static double benchmark(int numTracks, int numKeys, int frames){
+    std::vector<float> times(numKeys);
+    for (int k = 0; k < numKeys; k++)
+        times[k] = k / 30.0f;
+
+    std::vector<T*> tracks;
+    for (int t = 0; t < numTracks; t++){
+        T* track = new T(times);
+        track->setDuration(times.back());
+        track->setLoop(true);
+        track->run();
+        tracks.push_back(track);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < frames; f++){
+        for (int t = 0; t < numTracks; t++)
+            tracks[t]->update(1 / 60.0f);
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    for (int t = 0; t < numTracks; t++)
+        delete tracks[t];
+
+    return ms;
+}
+
+int main(){
+    const int numTracks = 200;
+    const int numKeys = 5000;
+    //Plays all keys at 60 frames per second, cursor also wraps on loop
+    const int frames = numKeys * 2 + 100;
+
+    double scan = benchmark<LinearScanTrack>(numTracks, numKeys, frames);
+    double cursor = benchmark<KeyframeTrack>(numTracks, numKeys, frames);
+
+    printf("Keyframe tracks %d x %d keys: scan %8.4f ms, cursor %8.4f ms per frame\n", numTracks, numKeys, scan, cursor);
+
+    return 0;
+}
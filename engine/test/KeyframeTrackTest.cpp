@@ -0,0 +1,83 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Object.h"
+#include "action/keyframe/KeyframeTrack.h"
+#include "action/keyframe/TranslateTracks.h"
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+using namespace Supernova;
+
+//Playhead cursor must find same keyframe of a linear scan, single key tracks write their value
+
+class CursorTrack: public KeyframeTrack {
+public:
+    CursorTrack(std::vector<float> times): KeyframeTrack(times){ }
+
+    bool matchesScan(){
+        float actualTime = duration * value;
+
+        //Last key not after time, interpolating with next one
+        int scan = 0;
+        while (scan + 2 < (int)times.size() && times[scan + 1] <= actualTime)
+            scan++;
+
+        float keyDuration = times[scan + 1] - times[scan];
+        float scanProgress = (keyDuration > 0) ? std::max(0.0f, std::min(1.0f, (actualTime - times[scan]) / keyDuration)) : 0;
+
+        return index == scan && nextIndex == scan + 1 && fabs(progress - scanProgress) < 0.0001;
+    }
+};
+
+int main(){
+    srand(5);
+
+    std::vector<float> times;
+    float time = 0;
+    for (int k = 0; k < 300; k++){
+        times.push_back(time);
+        //Irregular keys, some with same time
+        time += (rand() % 5 == 0) ? 0 : (float)(rand() % 100) / 1000.0f;
+    }
+
+    CursorTrack track(times);
+    track.setDuration(times.back());
+    track.setLoop(true);
+    track.run();
+
+    //Small steps, steps over many keys and loops
+    bool forward = true;
+    for (int f = 0; f < 5000; f++){
+        float interval = (f % 50 == 0) ? (float)(rand() % 3000) / 1000.0f : (float)(rand() % 40) / 1000.0f;
+        track.update(interval);
+        if (!track.matchesScan())
+            forward = false;
+    }
+    S_CHECK(forward);
+
+    //Seeks back and forth
+    bool seek = true;
+    for (int s = 0; s < 500; s++){
+        track.setTimecount((float)(rand() % 1000) / 1000.0f * times.back());
+        track.update(0);
+        if (!track.matchesScan())
+            seek = false;
+    }
+    S_CHECK(seek);
+
+    //Constant channel of one key
+    Object object;
+    TranslateTracks single(std::vector<float>{0.5}, std::vector<Vector3>{Vector3(1, 2, 3)});
+    object.addAction(&single);
+    single.setDuration(1);
+    single.run();
+    single.update(0.1);
+    S_CHECK(object.getPosition() == Vector3(1, 2, 3));
+    object.removeAction(&single);
+
+    return S_TEST_RESULT();
+}
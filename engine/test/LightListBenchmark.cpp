@@ -0,0 +1,92 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "util/LightList.h"
+#include "math/Angle.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Assignment of 8 point and 8 spot lights per object from 1k scene lights to 10k moving objects
+
+#define NUM_LIGHTS 1000
+#define NUM_OBJECTS 10000
+#define LIGHTS_PER_OBJECT 8
+#define WORLD_SIZE 500
+
+static float random(float range){
+    return ((float)rand() / (float)RAND_MAX) * range;
+}
+
+int main(){
+    srand(7);
+
+    LightData data;
+    for (int i = 0; i < NUM_LIGHTS / 2; i++){
+        Vector3 position(random(WORLD_SIZE), random(20), random(WORLD_SIZE));
+
+        data.pointLightPos.insert(data.pointLightPos.end(), {position.x, position.y, position.z});
+        data.pointLightColor.insert(data.pointLightColor.end(), {1, 1, 1});
+        data.pointLightPower.push_back(1 + random(10));
+        data.pointLightRange.push_back(50 + random(100));
+        data.pointLightShadowIdx.push_back(-1);
+        data.numPointLight++;
+
+        Vector3 target = position + Vector3(random(10) - 5, -10, random(10) - 5);
+
+        data.spotLightPos.insert(data.spotLightPos.end(), {position.x, position.y + 10, position.z});
+        data.spotLightColor.insert(data.spotLightColor.end(), {1, 1, 1});
+        data.spotLightTarget.insert(data.spotLightTarget.end(), {target.x, target.y, target.z});
+        data.spotLightPower.push_back(1 + random(10));
+        data.spotLightRange.push_back(50 + random(100));
+        data.spotLightCutOff.push_back(cos(Angle::degToRad(20)));
+        data.spotLightOuterCutOff.push_back(cos(Angle::degToRad(30)));
+        data.spotLightShadowIdx.push_back(-1);
+        data.numSpotLight++;
+    }
+
+    std::vector<LightList> lists(NUM_OBJECTS);
+    std::vector<Vector3> centers(NUM_OBJECTS);
+    for (int i = 0; i < NUM_OBJECTS; i++){
+        lists[i].resize(LIGHTS_PER_OBJECT, LIGHTS_PER_OBJECT);
+        centers[i] = Vector3(random(WORLD_SIZE), 0, random(WORLD_SIZE));
+    }
+
+    const int frames = 10;
+    int usedSpots = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < frames; f++){
+        for (int i = 0; i < NUM_OBJECTS; i++){
+            centers[i].x += 0.1;
+            lists[i].update(&data, centers[i], 1);
+        }
+    }
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    for (int i = 0; i < NUM_OBJECTS; i++){
+        for (int s = 0; s < LIGHTS_PER_OBJECT; s++){
+            if (lists[i].spotLightPower[s] > 0)
+                usedSpots++;
+        }
+    }
+
+    printf("Lights: %i, objects: %i, %i point and %i spot slots\n", NUM_LIGHTS, NUM_OBJECTS, LIGHTS_PER_OBJECT, LIGHTS_PER_OBJECT);
+    printf("Assignment: %.3f ms per frame\n", elapsed);
+    printf("Spot slots lit after cone test: %.2f per object\n", (float)usedSpots / NUM_OBJECTS);
+
+    //Nothing moved, lists are kept
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < NUM_OBJECTS; i++)
+        lists[i].update(&data, centers[i], 1);
+    printf("Unchanged frame: %.3f ms\n", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "util/LightList.h"
+#include "math/Angle.h"
+#include <math.h>
+
+using namespace Supernova;
+
+static void addPointLight(LightData& data, float x, float y, float z, float power, float range){
+    data.pointLightPos.insert(data.pointLightPos.end(), {x, y, z});
+    data.pointLightColor.insert(data.pointLightColor.end(), {1, 1, 1});
+    data.pointLightPower.push_back(power);
+    data.pointLightRange.push_back(range);
+    data.pointLightShadowIdx.push_back((int)data.pointLightPower.size() - 1);
+    data.numPointLight++;
+}
+
+static void addSpotLight(LightData& data, Vector3 position, Vector3 target, float power){
+    data.spotLightPos.insert(data.spotLightPos.end(), {position.x, position.y, position.z});
+    data.spotLightColor.insert(data.spotLightColor.end(), {1, 1, 1});
+    data.spotLightTarget.insert(data.spotLightTarget.end(), {target.x, target.y, target.z});
+    data.spotLightPower.push_back(power);
+    data.spotLightRange.push_back(1000);
+    //20 and 30 degrees half angles
+    data.spotLightCutOff.push_back(cos(Angle::degToRad(20)));
+    data.spotLightOuterCutOff.push_back(cos(Angle::degToRad(30)));
+    data.spotLightShadowIdx.push_back((int)data.spotLightPower.size() - 1);
+    data.numSpotLight++;
+}
+
+int main(){
+    LightData data;
+    data.numPointLight = 0;
+    data.numSpotLight = 0;
+
+    addPointLight(data, 100, 0, 0, 1, 1000);   //0: far and weak
+    addPointLight(data, 5, 0, 0, 10, 1000);    //1: best
+    addPointLight(data, 10, 0, 0, 10, 1000);   //2: second
+    addPointLight(data, 2, 0, 0, 100, 1);      //3: out of range
+    addPointLight(data, 1, 0, 0, 0, 1000);     //4: no power
+    addPointLight(data, 20, 0, 0, 10, 1000);   //5: third
+
+    LightList list;
+    list.resize(2, 0);
+
+    S_CHECK(list.update(&data, Vector3(0, 0, 0), 0.5));
+    S_CHECK(list.numPointLight == 2);
+    S_CHECK(list.pointLightShadowIdx[0] == 1);
+    S_CHECK(list.pointLightShadowIdx[1] == 2);
+    S_CHECK_NEAR(list.pointLightPos[0], 5, 0.0001);
+
+    //Nothing changed
+    S_CHECK(!list.update(&data, Vector3(0, 0, 0), 0.5));
+
+    //Object moved near other lights
+    S_CHECK(list.update(&data, Vector3(21, 0, 0), 0.5));
+    S_CHECK(list.pointLightShadowIdx[0] == 5);
+    S_CHECK(list.pointLightShadowIdx[1] == 2);
+
+    //Bigger list than lights in range, unused slots have no power
+    LightList bigList;
+    bigList.resize(6, 0);
+    S_CHECK(bigList.update(&data, Vector3(0, 0, 0), 0.5));
+    S_CHECK(bigList.pointLightShadowIdx[3] == 0);
+    S_CHECK(bigList.pointLightShadowIdx[4] == -1);
+    S_CHECK(bigList.pointLightPower[4] == 0);
+    S_CHECK(bigList.pointLightPower[5] == 0);
+
+    //Spot cone is part of score, strong spot looking away does not light object
+    addSpotLight(data, Vector3(0, 5, 0), Vector3(0, 10, 0), 100);  //0: looking away
+    addSpotLight(data, Vector3(0, 8, 0), Vector3(0, 0, 0), 10);    //1: looking to object
+    addSpotLight(data, Vector3(3, 5, 0), Vector3(3, 0, 0), 10);    //2: object in outer cone
+    addSpotLight(data, Vector3(8, 5, 0), Vector3(8, 0, 0), 100);   //3: object out of cone
+
+    LightList spotList;
+    spotList.resize(0, 4);
+    S_CHECK(spotList.update(&data, Vector3(0, 0, 0), 0.5));
+    S_CHECK(spotList.spotLightShadowIdx[0] == 1);
+    S_CHECK(spotList.spotLightShadowIdx[1] == 2);
+    S_CHECK(spotList.spotLightShadowIdx[2] == -1);
+    S_CHECK(spotList.spotLightShadowIdx[3] == -1);
+
+    //Big sphere contains first light and reaches inside cone of last one
+    S_CHECK(spotList.update(&data, Vector3(0, 0, 0), 6));
+    S_CHECK(spotList.spotLightShadowIdx[0] == 0);
+    S_CHECK(spotList.spotLightShadowIdx[1] == 3);
+
+    return S_TEST_RESULT();
+}
@@ -0,0 +1,138 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "math/Matrix4.h"
+#include "math/AlignedBox.h"
+#include "math/SIMD.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Matrix operations used in transform updates and culling, SIMD build against scalar loops
+
+#define NUM_MATRICES 10000
+#define NUM_POINTS 100000
+
+static float random(float range){
+    return ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * range;
+}
+
+static Matrix4 randomAffine(){
+    return Matrix4::translateMatrix(random(100), random(100), random(100)) *
+           Matrix4::rotateMatrix(random(180), Vector3(random(1), random(1), 1).normalize()) *
+           Matrix4::scaleMatrix(Vector3(1 + random(0.5), 1 + random(0.5), 1 + random(0.5)));
+}
+
+template<typename F>
+static double measure(F function){
+    const int repeats = 20;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; r++)
+        function();
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repeats;
+}
+
+int main(){
+    srand(5);
+
+    std::vector<Matrix4> matrices(NUM_MATRICES);
+    std::vector<Matrix4> results(NUM_MATRICES);
+    std::vector<AlignedBox> boxes(NUM_MATRICES);
+    for (int i = 0; i < NUM_MATRICES; i++)
+        matrices[i] = randomAffine();
+
+    std::vector<Vector3> points(NUM_POINTS);
+    std::vector<Vector3> transformed(NUM_POINTS);
+    for (int i = 0; i < NUM_POINTS; i++)
+        points[i] = Vector3(random(50), random(50), random(50));
+
+    const Matrix4& matrix = matrices[0];
+    float checksum = 0;
+
+#ifdef SUPERNOVA_SIMD
+    printf("SIMD: on\n");
+#else
+    printf("SIMD: off\n");
+#endif
+
+    double time = measure([&](){
+        for (int i = 1; i < NUM_MATRICES; i++)
+            results[i] = matrices[i - 1] * matrices[i];
+    });
+    checksum += results[NUM_MATRICES - 1].get(3, 0);
+    printf("%i matrix products: %.3f ms\n", NUM_MATRICES, time);
+
+    time = measure([&](){
+        for (int i = 1; i < NUM_MATRICES; i++)
+            results[i] = matrices[i - 1].affineMultiply(matrices[i]);
+    });
+    checksum += results[NUM_MATRICES - 1].get(3, 0);
+    printf("%i affine products: %.3f ms\n", NUM_MATRICES, time);
+
+    time = measure([&](){
+        for (int i = 0; i < NUM_POINTS; i++)
+            transformed[i] = matrix * points[i];
+    });
+    checksum += transformed[NUM_POINTS - 1].x;
+    printf("%i points with operator*: %.3f ms\n", NUM_POINTS, time);
+
+    time = measure([&](){
+        for (int i = 0; i < NUM_POINTS; i++){
+            const Vector3& p = points[i];
+            transformed[i].x = p.x*matrix[0][0] + p.y*matrix[1][0] + p.z*matrix[2][0] + matrix[3][0];
+            transformed[i].y = p.x*matrix[0][1] + p.y*matrix[1][1] + p.z*matrix[2][1] + matrix[3][1];
+            transformed[i].z = p.x*matrix[0][2] + p.y*matrix[1][2] + p.z*matrix[2][2] + matrix[3][2];
+        }
+    });
+    checksum += transformed[NUM_POINTS - 1].x;
+    printf("%i points with scalar loop: %.3f ms\n", NUM_POINTS, time);
+
+    time = measure([&](){
+        matrix.transformPoints(&points.front(), &transformed.front(), NUM_POINTS);
+    });
+    checksum += transformed[NUM_POINTS - 1].x;
+    printf("%i points with transformPoints: %.3f ms\n", NUM_POINTS, time);
+
+    time = measure([&](){
+        for (int i = 0; i < NUM_MATRICES; i++){
+            boxes[i] = AlignedBox(-1, -1, -1, 1, 1, 1);
+            boxes[i].transform(matrices[i]);
+        }
+    });
+    checksum += boxes[NUM_MATRICES - 1].getMinimum().x;
+    printf("%i boxes with transform: %.3f ms\n", NUM_MATRICES, time);
+
+    time = measure([&](){
+        for (int i = 0; i < NUM_MATRICES; i++){
+            boxes[i] = AlignedBox(-1, -1, -1, 1, 1, 1);
+            boxes[i].transformAffine(matrices[i]);
+        }
+    });
+    checksum += boxes[NUM_MATRICES - 1].getMinimum().x;
+    printf("%i boxes with transformAffine: %.3f ms\n", NUM_MATRICES, time);
+
+    time = measure([&](){
+        for (int i = 0; i < NUM_MATRICES; i++)
+            results[i] = matrices[i].inverse();
+    });
+    checksum += results[NUM_MATRICES - 1].get(3, 0);
+    printf("%i inverse: %.3f ms\n", NUM_MATRICES, time);
+
+    time = measure([&](){
+        for (int i = 0; i < NUM_MATRICES; i++)
+            results[i] = matrices[i].affineInverse();
+    });
+    checksum += results[NUM_MATRICES - 1].get(3, 0);
+    printf("%i affineInverse: %.3f ms\n", NUM_MATRICES, time);
+
+    //Keeps results used
+    printf("Checksum: %f\n", checksum);
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "math/Matrix4.h"
+#include "math/AlignedBox.h"
+#include <algorithm>
+#include <math.h>
+#include <stdlib.h>
+
+using namespace Supernova;
+
+//SIMD and batched transforms must match scalar math in same operation order exactly
+
+static float random(float range){
+    return ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * range;
+}
+
+static Matrix4 randomAffine(){
+    return Matrix4::translateMatrix(random(100), random(100), random(100)) *
+           Matrix4::rotateMatrix(random(180), Vector3(random(1), random(1), 1).normalize()) *
+           Matrix4::scaleMatrix(Vector3(random(4), random(4), random(4)));
+}
+
+static Vector3 scalarTransform(const Matrix4& m, const Vector3& p){
+    return Vector3(p.x*m.get(0,0) + p.y*m.get(1,0) + p.z*m.get(2,0) + m.get(3,0),
+                   p.x*m.get(0,1) + p.y*m.get(1,1) + p.z*m.get(2,1) + m.get(3,1),
+                   p.x*m.get(0,2) + p.y*m.get(1,2) + p.z*m.get(2,2) + m.get(3,2));
+}
+
+static Matrix4 scalarMultiply(const Matrix4& a, const Matrix4& b){
+    Matrix4 prod;
+    for (int c = 0; c < 4; c++){
+        for (int r = 0; r < 4; r++)
+            prod.set(c, r, a.get(0,r)*b.get(c,0) + a.get(1,r)*b.get(c,1) + a.get(2,r)*b.get(c,2) + a.get(3,r)*b.get(c,3));
+    }
+    return prod;
+}
+
+static bool sameVector(const Vector3& a, const Vector3& b){
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+int main(){
+    srand(1);
+
+    for (int m = 0; m < 1000; m++){
+        Matrix4 matrix = randomAffine();
+
+        Vector3 points[16];
+        Vector3 result[16];
+        for (int i = 0; i < 16; i++)
+            points[i] = Vector3(random(50), random(50), random(50));
+
+        matrix.transformPoints(points, result, 16);
+
+        bool equal = true;
+        for (int i = 0; i < 16; i++){
+            if (!sameVector(result[i], scalarTransform(matrix, points[i])) || !sameVector(result[i], matrix * points[i]))
+                equal = false;
+        }
+        S_CHECK(equal);
+
+        //In place
+        matrix.transformPoints(points, points, 16);
+        bool inPlace = true;
+        for (int i = 0; i < 16; i++){
+            if (!sameVector(points[i], result[i]))
+                inPlace = false;
+        }
+        S_CHECK(inPlace);
+
+        Matrix4 other = randomAffine();
+        S_CHECK(matrix * other == scalarMultiply(matrix, other));
+
+        //Box from scalar transformed corners
+        Vector3 minimum(random(10) - 10, random(10) - 10, random(10) - 10);
+        Vector3 maximum(random(10) + 10, random(10) + 10, random(10) + 10);
+        AlignedBox box(minimum, maximum);
+        AlignedBox affineBox = box;
+        box.transform(matrix);
+        affineBox.transformAffine(matrix);
+
+        Vector3 scalarMin, scalarMax;
+        for (int c = 0; c < 8; c++){
+            Vector3 corner((c & 1) ? maximum.x : minimum.x, (c & 2) ? maximum.y : minimum.y, (c & 4) ? maximum.z : minimum.z);
+            corner = scalarTransform(matrix, corner);
+            if (c == 0){
+                scalarMin = corner;
+                scalarMax = corner;
+            }
+            scalarMin = Vector3(std::min(scalarMin.x, corner.x), std::min(scalarMin.y, corner.y), std::min(scalarMin.z, corner.z));
+            scalarMax = Vector3(std::max(scalarMax.x, corner.x), std::max(scalarMax.y, corner.y), std::max(scalarMax.z, corner.z));
+        }
+
+        S_CHECK(sameVector(affineBox.getMinimum(), scalarMin) && sameVector(affineBox.getMaximum(), scalarMax));
+        S_CHECK(sameVector(box.getMinimum(), affineBox.getMinimum()) && sameVector(box.getMaximum(), affineBox.getMaximum()));
+
+        //Affine inverse against general inverse, relative to matrix size
+        Matrix4 inverse = matrix.inverse();
+        Matrix4 affineInverse = matrix.affineInverse();
+        float maxError = 0;
+        float maxValue = 1;
+        for (int c = 0; c < 4; c++){
+            for (int r = 0; r < 4; r++){
+                maxError = std::max(maxError, (float)fabs(inverse.get(c, r) - affineInverse.get(c, r)));
+                maxValue = std::max(maxValue, (float)fabs(inverse.get(c, r)));
+            }
+        }
+        S_CHECK_NEAR(maxError / maxValue, 0, 0.0001);
+    }
+
+    return S_TEST_RESULT();
+}
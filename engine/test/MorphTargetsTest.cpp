@@ -0,0 +1,187 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Model.h"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace Supernova;
+
+//Sparse CPU morph must match shader sum of all targets: base + weight * target
+
+#define NUM_VERTICES 64
+#define NUM_TARGETS 6
+
+class MorphModel: public Model{
+public:
+    MorphModel(const char* path): Model(path){ }
+
+    //There is no render context
+    virtual bool renderLoad(bool){
+        return true;
+    }
+
+    void updateMorphs(){
+        updateActions();
+    }
+
+    const std::vector<float>& getMorphValues(){
+        return cpuMorphs.front()->values;
+    }
+
+    size_t getNumCPUMorphs(){
+        return cpuMorphs.size();
+    }
+};
+
+static float random(float range){
+    return ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * range;
+}
+
+static std::string base64(const unsigned char* data, size_t size){
+    static const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string result;
+
+    for (size_t i = 0; i < size; i += 3){
+        unsigned int n = data[i] << 16;
+        if (i + 1 < size) n |= data[i + 1] << 8;
+        if (i + 2 < size) n |= data[i + 2];
+
+        result += chars[(n >> 18) & 63];
+        result += chars[(n >> 12) & 63];
+        result += (i + 1 < size) ? chars[(n >> 6) & 63] : '=';
+        result += (i + 2 < size) ? chars[n & 63] : '=';
+    }
+
+    return result;
+}
+
+static std::vector<unsigned char> data;
+static std::string bufferViews;
+static std::string accessors;
+static int numAccessors = 0;
+
+static int addAccessor(const void* values, size_t size, int target, int componentType, size_t count, const char* type, std::string extra){
+    size_t offset = data.size();
+    data.insert(data.end(), (const unsigned char*)values, (const unsigned char*)values + size);
+    while (data.size() % 4)
+        data.push_back(0);
+
+    if (numAccessors > 0){
+        bufferViews += ",";
+        accessors += ",";
+    }
+    bufferViews += "{\"buffer\":0,\"byteOffset\":" + std::to_string(offset) + ",\"byteLength\":" + std::to_string(size) + ",\"target\":" + std::to_string(target) + "}";
+    accessors += "{\"bufferView\":" + std::to_string(numAccessors) + ",\"componentType\":" + std::to_string(componentType) + ",\"count\":" + std::to_string(count) + ",\"type\":\"" + type + "\"" + extra + "}";
+
+    return numAccessors++;
+}
+
+int main(){
+    srand(3);
+
+    float positions[NUM_VERTICES * 3];
+    float normals[NUM_VERTICES * 3];
+    for (int i = 0; i < NUM_VERTICES * 3; i++){
+        positions[i] = random(1);
+        normals[i] = random(1);
+    }
+
+    unsigned short indices[(NUM_VERTICES - 2) * 3];
+    for (int v = 0; v < NUM_VERTICES - 2; v++){
+        indices[v * 3] = v;
+        indices[v * 3 + 1] = v + 1;
+        indices[v * 3 + 2] = v + 2;
+    }
+
+    //Each target moves only a part of vertices
+    float targetPositions[NUM_TARGETS][NUM_VERTICES * 3];
+    float targetNormals[NUM_TARGETS][NUM_VERTICES * 3];
+    for (int t = 0; t < NUM_TARGETS; t++){
+        for (int v = 0; v < NUM_VERTICES; v++){
+            bool moved = (v >= t * 8) && (v < t * 8 + 20) && (rand() % 4 != 0);
+            for (int c = 0; c < 3; c++){
+                targetPositions[t][v * 3 + c] = moved ? random(0.5) : 0;
+                targetNormals[t][v * 3 + c] = moved ? random(0.2) : 0;
+            }
+        }
+    }
+
+    int positionAccessor = addAccessor(positions, sizeof(positions), 34962, 5126, NUM_VERTICES, "VEC3", ",\"min\":[-1,-1,-1],\"max\":[1,1,1]");
+    int normalAccessor = addAccessor(normals, sizeof(normals), 34962, 5126, NUM_VERTICES, "VEC3", "");
+    int indexAccessor = addAccessor(indices, sizeof(indices), 34963, 5123, (NUM_VERTICES - 2) * 3, "SCALAR", "");
+
+    std::string targets;
+    for (int t = 0; t < NUM_TARGETS; t++){
+        int targetPosition = addAccessor(targetPositions[t], sizeof(targetPositions[t]), 34962, 5126, NUM_VERTICES, "VEC3", "");
+        int targetNormal = addAccessor(targetNormals[t], sizeof(targetNormals[t]), 34962, 5126, NUM_VERTICES, "VEC3", "");
+        if (t > 0)
+            targets += ",";
+        targets += "{\"POSITION\":" + std::to_string(targetPosition) + ",\"NORMAL\":" + std::to_string(targetNormal) + "}";
+    }
+
+    std::string gltf = std::string("{\"asset\":{\"version\":\"2.0\"},")
+            + "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],"
+            + "\"materials\":[{}],"
+            + "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":" + std::to_string(positionAccessor) + ",\"NORMAL\":" + std::to_string(normalAccessor) + "},"
+            + "\"indices\":" + std::to_string(indexAccessor) + ",\"material\":0,\"targets\":[" + targets + "]}]}],"
+            + "\"buffers\":[{\"byteLength\":" + std::to_string(data.size()) + ",\"uri\":\"data:application/octet-stream;base64," + base64(data.data(), data.size()) + "\"}],"
+            + "\"bufferViews\":[" + bufferViews + "],"
+            + "\"accessors\":[" + accessors + "]}";
+
+    const char* path = "/tmp/supernova_morph_test.gltf";
+    FILE* file = fopen(path, "wb");
+    fwrite(gltf.c_str(), 1, gltf.size(), file);
+    fclose(file);
+
+    MorphModel model(path);
+    model.setCPUMorphTargets(true);
+    S_CHECK(model.load());
+    S_CHECK(model.getNumCPUMorphs() == 1);
+
+    if (model.getNumCPUMorphs() == 0){
+        remove(path);
+        return S_TEST_RESULT();
+    }
+
+    //Weights change a few targets each update, unchanged ranges keep last values
+    float weights[NUM_TARGETS] = {0, 0, 0, 0, 0, 0};
+    for (int update = 0; update < 20; update++){
+        for (int t = 0; t < NUM_TARGETS; t++){
+            if (rand() % 3 == 0)
+                weights[t] = (rand() % 4 == 0) ? 0 : random(1);
+            model.setMorphWeight(t, weights[t]);
+        }
+
+        model.updateMorphs();
+
+        const std::vector<float>& values = model.getMorphValues();
+
+        float maxError = 0;
+        for (int v = 0; v < NUM_VERTICES; v++){
+            for (int c = 0; c < 3; c++){
+                float position = positions[v * 3 + c];
+                float normal = normals[v * 3 + c];
+                for (int t = 0; t < NUM_TARGETS; t++){
+                    position += weights[t] * targetPositions[t][v * 3 + c];
+                    normal += weights[t] * targetNormals[t][v * 3 + c];
+                }
+                maxError = std::max(maxError, (float)fabs(values[v * 8 + c] - position));
+                maxError = std::max(maxError, (float)fabs(values[v * 8 + 4 + c] - normal));
+            }
+        }
+
+        S_CHECK_NEAR(maxError, 0, 0.0001);
+    }
+
+    remove(path);
+
+    return S_TEST_RESULT();
+}
@@ -0,0 +1,138 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Scene.h"
+#include "Object.h"
+#include "util/JobSystem.h"
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Direct world transform must be bit-identical to previous translate * rotation * scale * translate(-center) products
+
+static float random(float range){
+    return ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * range;
+}
+
+//Zeros of both signs and exact values make most signed zero cases
+static float randomValue(float range){
+    switch (rand() % 6){
+        case 0: return 0.0f;
+        case 1: return -0.0f;
+        case 2: return (rand() % 2) ? 1.0f : -1.0f;
+        default: return random(range);
+    }
+}
+
+static Quaternion randomRotation(){
+    Quaternion rotation;
+    switch (rand() % 4){
+        case 0: return Quaternion(1, 0, 0, 0);
+        case 1: rotation.fromAngleAxis((rand() % 8) * 90.0f, Vector3((rand() % 3 == 0) ? 1 : 0, (rand() % 3 == 1) ? -1 : 0, (rand() % 3 == 2) ? 1 : 0)); break;
+        case 2: return Quaternion(randomValue(1), randomValue(1), randomValue(1), randomValue(1));
+        default: rotation.fromAngleAxis(random(360), Vector3(random(1), random(1), random(1) + 2).normalize());
+    }
+    return rotation;
+}
+
+//Previous scalar operator*
+static Matrix4 multiply(const Matrix4& a, const Matrix4& m){
+    Matrix4 prod;
+    for (int c = 0; c < 4; c++){
+        for (int r = 0; r < 4; r++)
+            prod.set(c, r, m.get(c,0)*a.get(0,r) + m.get(c,1)*a.get(1,r) + m.get(c,2)*a.get(2,r) + m.get(c,3)*a.get(3,r));
+    }
+    return prod;
+}
+
+static bool sameBits(Matrix4 a, Matrix4 b){
+    return memcmp((float*)a, (float*)b, sizeof(float) * 16) == 0;
+}
+
+struct Reference{
+    Matrix4 transform;
+    Matrix4 model;
+};
+
+static void testTransforms(bool parallel){
+    Scene scene;
+    scene.setParallelTransforms(parallel);
+
+    //Enough objects to use parallel path
+    const int numObjects = 3000;
+
+    std::vector<Object*> objects;
+    std::vector<int> parents;
+    for (int i = 0; i < numObjects; i++){
+        Object* object = new Object();
+        int parent = (i < 10) ? -1 : rand() % i;
+        if (parent >= 0)
+            objects[parent]->addObject(object);
+        else
+            scene.addObject(object);
+        objects.push_back(object);
+        parents.push_back(parent);
+    }
+
+    for (int frame = 0; frame < 5; frame++){
+        for (int i = 0; i < numObjects; i++){
+            objects[i]->setPosition(randomValue(100), randomValue(100), randomValue(100));
+            objects[i]->setRotation(randomRotation());
+            objects[i]->setScale(Vector3(randomValue(3), randomValue(3), randomValue(3)));
+            objects[i]->setCenter(randomValue(2), randomValue(2), randomValue(2));
+        }
+
+        scene.update();
+
+        //Parents are always before children
+        std::vector<Reference> references(numObjects);
+        bool transformEqual = true;
+        bool modelEqual = true;
+        for (int i = 0; i < numObjects; i++){
+            Object* object = objects[i];
+
+            Matrix4 centerMatrix = Matrix4::translateMatrix(-object->getCenter());
+            Matrix4 scaleMatrix = Matrix4::scaleMatrix(object->getScale());
+            Matrix4 translateMatrix = Matrix4::translateMatrix(object->getPosition());
+            Matrix4 rotationMatrix = object->getRotation().getRotationMatrix();
+
+            references[i].transform = multiply(multiply(translateMatrix, rotationMatrix), scaleMatrix);
+            references[i].model = multiply(references[i].transform, centerMatrix);
+
+            //Scene is parent of first objects
+            Object* parent = (parents[i] >= 0) ? objects[parents[i]] : &scene;
+            Matrix4 parentModel = (parents[i] >= 0) ? references[parents[i]].model : scene.getModelMatrix();
+            Matrix4 parentCenterMatrix = Matrix4::translateMatrix(parent->getCenter());
+            references[i].model = multiply(multiply(parentModel, parentCenterMatrix), references[i].model);
+
+            if (!sameBits(object->getTransformMatrix(), references[i].transform))
+                transformEqual = false;
+            if (!sameBits(object->getModelMatrix(), references[i].model))
+                modelEqual = false;
+        }
+        S_CHECK(transformEqual);
+        S_CHECK(modelEqual);
+    }
+
+    for (int i = numObjects - 1; i >= 0; i--)
+        delete objects[i];
+}
+
+int main(){
+    srand(13);
+
+    //Workers are needed for parallel path even with one core
+    JobSystem::setNumThreads(3);
+    JobSystem::init();
+
+    testTransforms(false);
+    testTransforms(true);
+
+    JobSystem::deInit();
+
+    return S_TEST_RESULT();
+}
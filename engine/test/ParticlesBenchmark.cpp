@@ -0,0 +1,84 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Particles.h"
+#include "action/ParticlesAnimation.h"
+#include "action/particleinit/ParticleLifeInit.h"
+#include "action/particleinit/ParticleVelocityInit.h"
+#include "action/particleinit/ParticleAccelerationInit.h"
+#include "action/particlemod/ParticleAlphaMod.h"
+#include "action/particlemod/ParticleSizeMod.h"
+#include "action/particlemod/ParticleColorMod.h"
+#include "action/particlemod/ParticleRotationMod.h"
+#include "action/particlemod/ParticleVelocityMod.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Update of 100k live particles with several modifiers, modifiers by range against by particle
+
+#define NUM_PARTICLES 100000
+
+int main(){
+    const int frames = 20;
+
+    Particles particles;
+    for (int i = 0; i < NUM_PARTICLES; i++)
+        particles.addParticle();
+    //All particles are emitted in first update
+    particles.setRate(NUM_PARTICLES * 100, NUM_PARTICLES);
+
+    std::vector<ParticleMod*> mods;
+    mods.push_back(new ParticleAlphaMod(100, 0, 1, 0));
+    mods.push_back(new ParticleSizeMod(100, 0, 10, 1));
+    mods.push_back(new ParticleColorMod(100, 0, 1, 0, 0, 0, 0, 1));
+    mods.push_back(new ParticleRotationMod(100, 0, 0, 360));
+    mods.push_back(new ParticleVelocityMod(100, 0, Vector3(1, 2, 3), Vector3(0, 0, 0)));
+
+    ParticlesAnimation animation;
+    animation.addInit(new ParticleLifeInit(90, 100));
+    animation.addInit(new ParticleVelocityInit(Vector3(-1, 0, -1), Vector3(1, 2, 1)));
+    animation.addInit(new ParticleAccelerationInit(Vector3(0, -1, 0), Vector3(0, -1, 0)));
+    for (size_t m = 0; m < mods.size(); m++)
+        animation.addMod(mods[m]);
+
+    particles.addAction(&animation);
+    animation.run();
+    animation.update(0.016f);
+
+    int live = particles.getLiveParticles();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f++)
+        animation.update(0.016f);
+    double update = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    //Only modifiers, over same live particles
+    float* lifes = particles.getLifesData();
+
+    start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f++){
+        for (size_t m = 0; m < mods.size(); m++)
+            mods[m]->executeRange(&particles, 0, live);
+    }
+    double range = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    start = std::chrono::steady_clock::now();
+    for (int f = 0; f < frames; f++){
+        for (size_t m = 0; m < mods.size(); m++){
+            for (int i = 0; i < live; i++)
+                mods[m]->execute(&particles, i, lifes[i]);
+        }
+    }
+    double single = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    printf("Particles %d live, %zu modifiers: update %8.3f ms, modifiers by range %8.3f ms, by particle %8.3f ms\n",
+           live, mods.size(), update, range, single);
+
+    particles.removeAction(&animation);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Particles.h"
+
+using namespace Supernova;
+
+//Setters keep particle index, revived particles join live range only in compactParticles
+
+int main(){
+    Particles particles;
+    for (int i = 0; i < 10; i++)
+        particles.addParticle(Vector3((float)i, 0, 0));
+
+    //Emitter path, live range grows at its end
+    for (int i = 0; i < 3; i++){
+        int particle = particles.findUnusedParticle();
+        S_CHECK(particle == i);
+        particles.setParticleLife(particle, 1);
+    }
+    S_CHECK(particles.getLiveParticles() == 3);
+
+    //Dead particle after live range keeps its index and values
+    particles.setParticleLife(7, 2);
+    particles.setParticleSize(7, 5);
+    S_CHECK(particles.getParticleLife(7) == 2);
+    S_CHECK(particles.getParticleSize(7) == 5);
+    S_CHECK(particles.getParticlePosition(7).x == 7);
+    S_CHECK(particles.getLiveParticles() == 3);
+
+    //Unused particles are still dead ones
+    for (int i = 3; i < 7; i++){
+        int particle = particles.findUnusedParticle();
+        S_CHECK(particle == i);
+        particles.setParticleLife(particle, 1);
+    }
+    //Revived particle is joined when live range reaches it
+    S_CHECK(particles.getLiveParticles() == 8);
+    S_CHECK(particles.findUnusedParticle() == 8);
+
+    particles.setParticleLife(9, 3);
+    particles.setParticleLife(1, -1);
+    particles.compactParticles();
+
+    S_CHECK(particles.getLiveParticles() == 8);
+
+    int found = 0;
+    for (int i = 0; i < particles.getLiveParticles(); i++){
+        S_CHECK(particles.getParticleLife(i) > 0);
+        if (particles.getParticlePosition(i).x == 9 && particles.getParticleLife(i) == 3)
+            found++;
+        if (particles.getParticlePosition(i).x == 7 && particles.getParticleSize(i) == 5)
+            found++;
+    }
+    S_CHECK(found == 2);
+
+    return S_TEST_RESULT();
+}
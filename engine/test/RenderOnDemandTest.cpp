@@ -0,0 +1,73 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Engine.h"
+#include "Scene.h"
+#include "Object.h"
+#include "action/Action.h"
+
+using namespace Supernova;
+
+//Frames drawn with render on demand, scene is not loaded so nothing reaches the render
+
+static unsigned long fakeTime = 1000;
+
+static unsigned long fakeClock(){
+    return fakeTime;
+}
+
+static int drawFrames(int frames){
+    int drawn = 0;
+    for (int i = 0; i < frames; i++){
+        fakeTime += 16;
+        if (Engine::systemDraw())
+            drawn++;
+    }
+    return drawn;
+}
+
+int main(){
+    Engine::setClockFunction(fakeClock);
+    Engine::setFixedTimeSceneUpdate(false);
+    Engine::setRenderOnDemand(true);
+
+    Scene scene;
+    Object* object = new Object();
+    scene.addObject(object);
+    Engine::setScene(&scene);
+
+    //First frame draws pending changes, then idle scene draws nothing
+    S_CHECK(drawFrames(1) == 1);
+    S_CHECK(drawFrames(100) == 0);
+
+    //Explicit request draws one frame
+    Engine::requestRedraw();
+    S_CHECK(drawFrames(100) == 1);
+
+    //Changes made by user draw one frame
+    object->setPosition(1, 2, 3);
+    S_CHECK(drawFrames(100) == 1);
+
+    //Running action draws every frame until it stops
+    Action action;
+    object->addAction(&action);
+    action.run();
+    S_CHECK(drawFrames(100) == 100);
+
+    action.stop();
+    drawFrames(1);
+    S_CHECK(drawFrames(100) == 0);
+
+    //Without render on demand all frames are drawn
+    Engine::setRenderOnDemand(false);
+    S_CHECK(drawFrames(100) == 100);
+
+    object->removeAction(&action);
+    Engine::setScene(NULL);
+    delete object;
+    Engine::setClockFunction(NULL);
+
+    return S_TEST_RESULT();
+}
@@ -0,0 +1,58 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "util/ResolutionController.h"
+
+using namespace Supernova;
+
+int main(){
+    ResolutionController controller;
+    controller.setTargetFrameTime(16);
+    controller.setScaleRange(0.5, 1.0);
+    controller.setCooldownFrames(10);
+
+    //Frames in target keep full resolution
+    for (int i = 0; i < 100; i++)
+        controller.update(0.016);
+    S_CHECK(controller.getScale() == 1.0f);
+
+    //One slow frame is not enough to change scale
+    controller.update(0.030);
+    for (int i = 0; i < 5; i++)
+        controller.update(0.016);
+    S_CHECK(controller.getScale() == 1.0f);
+
+    //Slow frames reduce scale down to minimum, waiting cooldown between changes
+    float last = controller.getScale();
+    int changes = 0;
+    bool cooldown = true;
+    int framesSinceChange = 0;
+    for (int i = 0; i < 300; i++){
+        float scale = controller.update(0.032);
+        framesSinceChange++;
+        if (scale != last){
+            if (changes > 0 && framesSinceChange < 10)
+                cooldown = false;
+            changes++;
+            framesSinceChange = 0;
+            last = scale;
+        }
+    }
+    S_CHECK(cooldown);
+    S_CHECK(changes > 0);
+    S_CHECK(controller.getScale() == 0.5f);
+
+    //Fast frames bring resolution back
+    for (int i = 0; i < 300; i++)
+        controller.update(0.005);
+    S_CHECK(controller.getScale() == 1.0f);
+
+    //Invalid frame times are ignored
+    float average = controller.getAverageFrameTime();
+    controller.update(0);
+    S_CHECK(controller.getAverageFrameTime() == average);
+
+    return S_TEST_RESULT();
+}
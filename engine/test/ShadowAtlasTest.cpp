@@ -0,0 +1,70 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "util/ShadowAtlas.h"
+
+using namespace Supernova;
+
+static bool overlaps(Rect a, Rect b){
+    return a.getX() < b.getX() + b.getWidth() && b.getX() < a.getX() + a.getWidth() &&
+           a.getY() < b.getY() + b.getHeight() && b.getY() < a.getY() + a.getHeight();
+}
+
+static void request(ShadowAtlas& atlas, int sizes[], int count){
+    atlas.clearRequests();
+    for (int i = 0; i < count; i++)
+        atlas.addRequest(sizes[i], 1.0f / (i + 1));
+}
+
+int main(){
+    ShadowAtlas atlas;
+    atlas.setSize(4096);
+    atlas.setMinTileSize(128);
+
+    int sizes[] = {2048, 1024, 1024, 700, 512, 300, 128, 100};
+
+    request(atlas, sizes, 8);
+    S_CHECK(atlas.pack());
+
+    //Tiles are aligned to their size, inside atlas and do not overlap
+    bool valid = true;
+    for (int i = 0; i < 8; i++){
+        Rect a = atlas.getTile(i);
+        if (a.getWidth() == 0 || (int)a.getX() % (int)a.getWidth() != 0 || (int)a.getY() % (int)a.getHeight() != 0)
+            valid = false;
+        if (a.getX() + a.getWidth() > 4096 || a.getY() + a.getHeight() > 4096)
+            valid = false;
+        for (int j = 0; j < i; j++){
+            if (overlaps(a, atlas.getTile(j)))
+                valid = false;
+        }
+    }
+    S_CHECK(valid);
+    S_CHECK(atlas.getTile(0).getWidth() == 2048);
+    S_CHECK(atlas.getTile(3).getWidth() == 1024);
+
+    //Small coverage changes keep tiles
+    Rect before = atlas.getTile(4);
+    sizes[4] = 540;
+    request(atlas, sizes, 8);
+    S_CHECK(!atlas.pack());
+    S_CHECK(atlas.getTile(4).getX() == before.getX() && atlas.getTile(4).getWidth() == before.getWidth());
+
+    //Big changes, new lights and atlas size pack again
+    sizes[4] = 1024;
+    request(atlas, sizes, 8);
+    S_CHECK(atlas.pack());
+    S_CHECK(atlas.getTile(4).getWidth() == 1024);
+
+    request(atlas, sizes, 7);
+    S_CHECK(atlas.pack());
+
+    atlas.setSize(2048);
+    request(atlas, sizes, 7);
+    S_CHECK(atlas.pack());
+    S_CHECK(atlas.getTile(0).getWidth() <= 1024);
+
+    return S_TEST_RESULT();
+}
@@ -0,0 +1,123 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Scene.h"
+#include "Bone.h"
+#include "util/Skeleton.h"
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Crowd of animated characters, Bone objects updated by scene against compact Skeleton update
+
+#define NUM_CHARACTERS 50
+#define NUM_JOINTS 60
+
+static float random(float range){
+    return ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * range;
+}
+
+struct Character{
+    Object* root;
+    std::vector<Bone*> bones;
+    Skeleton skeleton;
+    std::vector<Matrix4> palette;
+};
+
+int main(){
+    const int frames = 100;
+
+    srand(9);
+
+    Scene scene;
+    scene.setParallelTransforms(false);
+
+    std::vector<Character> characters(NUM_CHARACTERS);
+    for (int c = 0; c < NUM_CHARACTERS; c++){
+        Character& character = characters[c];
+        character.root = new Object();
+        character.root->setPosition(c * 2, 0, 0);
+        scene.addObject(character.root);
+        character.palette.resize(NUM_JOINTS);
+
+        for (int i = 0; i < NUM_JOINTS; i++){
+            //Chains of 6 joints, like spine, limbs and fingers
+            int parent = (i == 0) ? -1 : ((i % 6 == 0) ? 0 : i - 1);
+
+            Vector3 position(0, 0.2, 0);
+            Quaternion rotation;
+            rotation.fromAngleAxis(random(30), Vector3(0, 0, 1));
+            Matrix4 offset = Matrix4::translateMatrix(0, -0.2 * (i % 6), 0);
+
+            Bone* bone = new Bone();
+            bone->setPosition(position);
+            bone->setRotation(rotation);
+            bone->setOffsetMatrix(offset);
+            bone->setIndex(i);
+            if (parent >= 0)
+                character.bones[parent]->addObject(bone);
+            else
+                character.root->addObject(bone);
+            character.bones.push_back(bone);
+
+            character.skeleton.addJoint(parent, i, "joint" + std::to_string(i), position, rotation, Vector3(1, 1, 1), offset);
+        }
+    }
+
+    scene.update();
+
+    //Same rotations in both paths, all joints animated each frame
+    std::vector<Quaternion> rotations(frames * NUM_JOINTS);
+    for (int i = 0; i < (int)rotations.size(); i++)
+        rotations[i].fromAngleAxis(random(30), Vector3(0, 0, 1));
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < frames; f++){
+        for (int c = 0; c < NUM_CHARACTERS; c++){
+            for (int i = 0; i < NUM_JOINTS; i++)
+                characters[c].bones[i]->setRotation(rotations[f * NUM_JOINTS + i]);
+        }
+
+        scene.update();
+
+        //Skinning matrices as written by Bone::updateModelMatrix
+        for (int c = 0; c < NUM_CHARACTERS; c++){
+            Matrix4 inverseRoot = characters[c].root->getModelMatrix().affineInverse();
+            for (int i = 0; i < NUM_JOINTS; i++)
+                characters[c].palette[i] = inverseRoot * characters[c].bones[i]->getModelMatrix() * characters[c].bones[i]->getOffsetMatrix();
+        }
+    }
+
+    double boneTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < frames; f++){
+        for (int c = 0; c < NUM_CHARACTERS; c++){
+            for (int i = 0; i < NUM_JOINTS; i++)
+                characters[c].skeleton.setRotation(i, rotations[f * NUM_JOINTS + i]);
+
+            characters[c].skeleton.update(&characters[c].palette.front(), characters[c].palette.size());
+        }
+    }
+
+    double skeletonTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    printf("Characters: %i, joints: %i\n", NUM_CHARACTERS, NUM_JOINTS);
+    printf("Bone objects: %.3f ms per frame\n", boneTime);
+    printf("Skeleton update: %.3f ms per frame\n", skeletonTime);
+    printf("Speedup: %.2fx\n", boneTime / skeletonTime);
+
+    for (int c = 0; c < NUM_CHARACTERS; c++){
+        for (int i = NUM_JOINTS - 1; i >= 0; i--)
+            delete characters[c].bones[i];
+        delete characters[c].root;
+    }
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Scene.h"
+#include "Bone.h"
+#include "util/Skeleton.h"
+#include <stdlib.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Compact skeleton palette must match skinning matrices of Bone objects
+
+static float random(float range){
+    return ((float)rand() / (float)RAND_MAX * 2.0f - 1.0f) * range;
+}
+
+static Quaternion randomRotation(){
+    Quaternion rotation;
+    rotation.fromAngleAxis(random(180), Vector3(random(1), random(1), random(1) + 2).normalize());
+    return rotation;
+}
+
+static bool matrixNear(Matrix4 a, Matrix4 b, float tolerance){
+    for (int c = 0; c < 4; c++){
+        for (int r = 0; r < 4; r++){
+            if (fabs(a[c][r] - b[c][r]) > tolerance)
+                return false;
+        }
+    }
+    return true;
+}
+
+int main(){
+    srand(7);
+
+    const int numJoints = 40;
+
+    Scene scene;
+    Object* root = new Object();
+    scene.addObject(root);
+
+    Skeleton skeleton;
+    std::vector<Bone*> bones;
+
+    for (int i = 0; i < numJoints; i++){
+        int parent = (i == 0) ? -1 : rand() % i;
+
+        Vector3 position(random(2), random(2), random(2));
+        Quaternion rotation = randomRotation();
+        Vector3 scale(1 + random(0.3), 1 + random(0.3), 1 + random(0.3));
+        Matrix4 offset = Matrix4::translateMatrix(random(1), random(1), random(1)) * randomRotation().getRotationMatrix();
+
+        Bone* bone = new Bone();
+        bone->setPosition(position);
+        bone->setRotation(rotation);
+        bone->setScale(scale);
+        bone->setBindPosition(position);
+        bone->setBindRotation(rotation);
+        bone->setBindScale(scale);
+        bone->setOffsetMatrix(offset);
+        bone->setIndex(i);
+
+        if (parent >= 0)
+            bones[parent]->addObject(bone);
+        else
+            root->addObject(bone);
+        bones.push_back(bone);
+
+        //Bone index in palette is reversed to test joint and bone mapping
+        skeleton.addJoint(parent, numJoints - 1 - i, "joint" + std::to_string(i), position, rotation, scale, offset);
+    }
+
+    std::vector<Matrix4> palette(numJoints);
+
+    for (int frame = 0; frame < 10; frame++){
+        //Animate some joints in both paths
+        for (int i = 0; i < numJoints; i += 3){
+            Quaternion rotation = randomRotation();
+            Vector3 position(random(2), random(2), random(2));
+            bones[i]->setRotation(rotation);
+            bones[i]->setPosition(position);
+            skeleton.setRotation(i, rotation);
+            skeleton.setPosition(i, position);
+        }
+
+        S_CHECK(skeleton.isDirty());
+
+        scene.update();
+        skeleton.update(&palette.front(), palette.size());
+
+        S_CHECK(!skeleton.isDirty());
+
+        bool equal = true;
+        bool equalWorld = true;
+        for (int i = 0; i < numJoints; i++){
+            Matrix4 skinning = bones[i]->getModelMatrix() * bones[i]->getOffsetMatrix();
+            if (!matrixNear(skinning, palette[numJoints - 1 - i], 0.001))
+                equal = false;
+            if (!matrixNear(bones[i]->getModelMatrix(), skeleton.getWorldMatrix(i), 0.001))
+                equalWorld = false;
+        }
+        S_CHECK(equal);
+        S_CHECK(equalWorld);
+    }
+
+    //Bind pose restores first transforms
+    skeleton.moveToBind();
+    for (int i = 0; i < numJoints; i++)
+        bones[i]->moveToBind();
+
+    scene.update();
+    skeleton.update(&palette.front(), palette.size());
+
+    bool bindEqual = true;
+    for (int i = 0; i < numJoints; i++){
+        Matrix4 skinning = bones[i]->getModelMatrix() * bones[i]->getOffsetMatrix();
+        if (!matrixNear(skinning, palette[numJoints - 1 - i], 0.001))
+            bindEqual = false;
+    }
+    S_CHECK(bindEqual);
+
+    //Bounds used by culling follow evaluated joints
+    AlignedBox jointsBounds;
+    for (int i = 0; i < numJoints; i++)
+        jointsBounds.merge(bones[i]->getModelMatrix() * Vector3(0, 0, 0));
+    AlignedBox skeletonBounds = skeleton.getJointsBounds();
+    S_CHECK_NEAR((skeletonBounds.getMinimum() - jointsBounds.getMinimum()).length(), 0, 0.001);
+    S_CHECK_NEAR((skeletonBounds.getMaximum() - jointsBounds.getMaximum()).length(), 0, 0.001);
+
+    S_CHECK(skeleton.findJoint("joint7") == 7);
+
+    for (int i = numJoints - 1; i >= 0; i--)
+        delete bones[i];
+    delete root;
+
+    return S_TEST_RESULT();
+}
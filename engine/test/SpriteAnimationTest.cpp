@@ -0,0 +1,122 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Scene.h"
+#include "Sprite.h"
+#include "action/SpriteAnimation.h"
+#include <vector>
+
+using namespace Supernova;
+
+//Invalid frame times stop animation on run, batched callbacks see late subscriptions and removed animations
+
+static Sprite* createSprite(){
+    Sprite* sprite = new Sprite();
+    sprite->addFrame(0, 0, 16, 16);
+    sprite->addFrame(16, 0, 16, 16);
+    sprite->addFrame(32, 0, 16, 16);
+    return sprite;
+}
+
+static SpriteAnimation* addAnimation(Sprite* sprite){
+    SpriteAnimation* animation = new SpriteAnimation(std::vector<int>{100}, std::vector<int>{0, 1, 2}, true);
+    sprite->addAction(animation);
+    animation->run();
+    return animation;
+}
+
+static bool runAnimation(Sprite* sprite, std::vector<int> framesTime){
+    SpriteAnimation* animation = new SpriteAnimation(framesTime, std::vector<int>{0, 1, 2}, true);
+    sprite->addAction(animation);
+    animation->run();
+
+    bool running = animation->isRunning();
+
+    sprite->removeAction(animation);
+    delete animation;
+
+    return running;
+}
+
+int main(){
+    Sprite* sprite = new Sprite();
+    sprite->addFrame(0, 0, 16, 16);
+    sprite->addFrame(16, 0, 16, 16);
+    sprite->addFrame(32, 0, 16, 16);
+
+    S_CHECK(runAnimation(sprite, std::vector<int>{100, 50}));
+    S_CHECK(!runAnimation(sprite, std::vector<int>()));
+    S_CHECK(!runAnimation(sprite, std::vector<int>{100, -50}));
+    S_CHECK(!runAnimation(sprite, std::vector<int>{0, 0}));
+
+    delete sprite;
+
+    Scene scene;
+    Sprite* spriteA = createSprite();
+    Sprite* spriteB = createSprite();
+    Sprite* spriteC = createSprite();
+    scene.addObject(spriteA);
+    scene.addObject(spriteB);
+    scene.addObject(spriteC);
+
+    SpriteAnimation* animationA = addAnimation(spriteA);
+    SpriteAnimation* animationB = addAnimation(spriteB);
+    SpriteAnimation* animationC = addAnimation(spriteC);
+
+    //First update is in object, then animations are batched
+    scene.update();
+    S_CHECK(scene.getBatchedSpriteAnimations() == 3);
+
+    int updatesA = 0;
+    animationA->onUpdate = [&updatesA](Object* object, float interval){
+        updatesA++;
+    };
+
+    scene.update();
+    S_CHECK(updatesA == 1);
+    S_CHECK(scene.getBatchedSpriteAnimations() == 3);
+
+    //First called callback deletes the other animation
+    int callbacks = 0;
+    animationB->onUpdate = [&](Object* object, float interval){
+        callbacks++;
+        if (animationC){
+            spriteC->removeAction(animationC);
+            delete animationC;
+            animationC = NULL;
+        }
+    };
+    animationC->onUpdate = [&](Object* object, float interval){
+        callbacks++;
+        if (animationB){
+            spriteB->removeAction(animationB);
+            delete animationB;
+            animationB = NULL;
+        }
+    };
+
+    scene.update();
+    S_CHECK(callbacks == 1);
+    S_CHECK(scene.getBatchedSpriteAnimations() == 2);
+    S_CHECK(updatesA == 2);
+
+    scene.update();
+    S_CHECK(callbacks == 2);
+
+    spriteA->removeAction(animationA);
+    delete animationA;
+    if (animationB)
+        spriteB->removeAction(animationB);
+    delete animationB;
+    if (animationC)
+        spriteC->removeAction(animationC);
+    delete animationC;
+
+    delete spriteA;
+    delete spriteB;
+    delete spriteC;
+
+    return S_TEST_RESULT();
+}
@@ -0,0 +1,20 @@
+#include "SupernovaTest.h"
+
+#include "Supernova.h"
+
+//Tests build their objects in main, there is no project to start
+void init(){
+
+}
+
+SupernovaTest::SupernovaTest(){
+
+}
+
+int SupernovaTest::getScreenWidth(){
+    return 1000;
+}
+
+int SupernovaTest::getScreenHeight(){
+    return 480;
+}
@@ -0,0 +1,19 @@
+#ifndef SupernovaTest_h
+#define SupernovaTest_h
+
+#include "system/System.h"
+
+//Headless system used by engine tests, there is no window or render context
+class SupernovaTest: public Supernova::System{
+
+public:
+
+    SupernovaTest();
+
+    virtual int getScreenWidth();
+    virtual int getScreenHeight();
+
+};
+
+
+#endif /* SupernovaTest_h */
@@ -0,0 +1,35 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+#include <math.h>
+
+//Minimal checks for engine tests, main returns number of failures
+
+static int testFailures = 0;
+
+#define S_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            testFailures++; \
+        } \
+    } while (0)
+
+#define S_CHECK_NEAR(a, b, tolerance) \
+    do { \
+        double testA = (a); double testB = (b); \
+        if (fabs(testA - testB) > (tolerance)) { \
+            printf("%s:%d: check failed: %s (%f) near %s (%f)\n", __FILE__, __LINE__, #a, testA, #b, testB); \
+            testFailures++; \
+        } \
+    } while (0)
+
+#define S_TEST_RESULT() \
+    (printf("%s\n", (testFailures == 0) ? "passed" : "FAILED"), testFailures)
+
+#endif //TEST_H
@@ -0,0 +1,8 @@
+#ifndef TEST_MACROS_H_
+#define TEST_MACROS_H_
+
+#ifndef SUPERNOVA_TEST
+#define SUPERNOVA_TEST
+#endif
+
+#endif /* TEST_MACROS_H_ */
@@ -0,0 +1,86 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Scene.h"
+#include "Object.h"
+#include "util/JobSystem.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Scene update of whole moving hierarchies, serial path against parallel path by tree level
+
+static void createTree(Object* parent, int depth, int fanOut, std::vector<Object*>& objects){
+    if (depth == 0)
+        return;
+
+    for (int i = 0; i < fanOut; i++){
+        Object* object = new Object();
+        object->setPosition(1, 0, 0);
+        object->setRotation(0, 0, 10);
+        parent->addObject(object);
+        objects.push_back(object);
+
+        createTree(object, depth - 1, fanOut, objects);
+    }
+}
+
+static double benchmark(Scene* scene, Object* root, bool parallel){
+    const int frames = 20;
+
+    scene->setParallelTransforms(parallel);
+    scene->update();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < frames; f++){
+        //Moving root makes all hierarchy dirty
+        root->setPosition((float)f, 0, 0);
+        scene->update();
+    }
+
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+}
+
+int main(){
+    //Depth and fan-out pairs of about 50k objects
+    int trees[][2] = {{1, 50000}, {2, 224}, {3, 37}, {4, 15}, {8, 4}, {15, 2}, {1000, 1}};
+
+    JobSystem::init();
+
+    for (int t = 0; t < 7; t++){
+        int depth = trees[t][0];
+        int fanOut = trees[t][1];
+
+        Scene scene;
+        Object* root = new Object();
+        scene.addObject(root);
+
+        std::vector<Object*> objects;
+        if (fanOut == 1){
+            //Deep chains, 50 chains of given depth
+            for (int c = 0; c < 50; c++)
+                createTree(root, depth, fanOut, objects);
+        }else{
+            createTree(root, depth, fanOut, objects);
+        }
+
+        double serial = benchmark(&scene, root, false);
+        double parallel = benchmark(&scene, root, true);
+
+        printf("Transforms depth %4d fan-out %5d (%zu objects, %u threads): serial %8.3f ms, parallel %8.3f ms\n",
+               depth, fanOut, objects.size(), JobSystem::getNumThreads() + 1, serial, parallel);
+
+        //Children first
+        for (size_t i = objects.size(); i > 0; i--)
+            delete objects[i - 1];
+        delete root;
+    }
+
+    JobSystem::deInit();
+
+    return 0;
+}
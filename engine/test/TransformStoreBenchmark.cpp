@@ -0,0 +1,76 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Scene.h"
+#include "Object.h"
+#include "util/JobSystem.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Scene update of 100k objects moved each frame by setters, serial path against scene TransformStore
+
+#define NUM_GROUPS 100
+#define OBJECTS_PER_GROUP 1000
+
+static double benchmark(bool parallel){
+    const int frames = 20;
+
+    Scene scene;
+    scene.setParallelTransforms(parallel);
+
+    std::vector<Object*> groups;
+    std::vector<Object*> objects;
+    for (int g = 0; g < NUM_GROUPS; g++){
+        Object* group = new Object();
+        group->setPosition((float)g, 0, 0);
+        scene.addObject(group);
+        groups.push_back(group);
+
+        for (int i = 0; i < OBJECTS_PER_GROUP; i++){
+            Object* object = new Object();
+            object->setPosition(0, (float)i, 0);
+            group->addObject(object);
+            objects.push_back(object);
+        }
+    }
+
+    scene.update();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < frames; f++){
+        for (size_t i = 0; i < objects.size(); i++){
+            objects[i]->setPosition((float)f, (float)i, 0);
+            objects[i]->setRotation(0, 0, (float)(f + i));
+        }
+        scene.update();
+    }
+
+    double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    for (size_t i = 0; i < objects.size(); i++)
+        delete objects[i];
+    for (size_t g = 0; g < groups.size(); g++)
+        delete groups[g];
+
+    return elapsed;
+}
+
+int main(){
+    JobSystem::init();
+
+    double serial = benchmark(false);
+    double store = benchmark(true);
+
+    printf("Objects: %i, threads: %u\n", NUM_GROUPS * OBJECTS_PER_GROUP, JobSystem::getNumThreads() + 1);
+    printf("Serial update: %.3f ms per frame\n", serial);
+    printf("TransformStore update: %.3f ms per frame\n", store);
+
+    JobSystem::deInit();
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Scene.h"
+#include "Object.h"
+#include "action/Action.h"
+
+using namespace Supernova;
+
+//Action callbacks deleting objects while scene store is updating actions
+
+int main(){
+    Scene scene;
+    scene.setParallelTransforms(true);
+
+    Object* first = new Object();
+    Object* second = new Object();
+    Object* third = new Object();
+    scene.addObject(first);
+    scene.addObject(second);
+    scene.addObject(third);
+
+    int firstUpdates = 0;
+    int thirdUpdates = 0;
+
+    Action firstAction;
+    firstAction.onUpdate = [&](Object* object, float interval){
+        firstUpdates++;
+        //Removing an object invalidates store in the middle of updateActions
+        if (second){
+            delete second;
+            second = NULL;
+        }
+    };
+    first->addAction(&firstAction);
+    firstAction.run();
+
+    Action thirdAction;
+    thirdAction.onUpdate = [&](Object* object, float interval){
+        thirdUpdates++;
+    };
+    third->addAction(&thirdAction);
+    thirdAction.run();
+
+    for (int i = 0; i < 3; i++){
+        scene.update();
+
+        //Each action runs once per update, by store or by Object::update
+        S_CHECK(firstUpdates == i + 1);
+        S_CHECK(thirdUpdates == i + 1);
+    }
+
+    S_CHECK(second == NULL);
+    S_CHECK(scene.getObjects().size() == 2);
+
+    first->removeAction(&firstAction);
+    third->removeAction(&thirdAction);
+    delete first;
+    delete third;
+
+    return S_TEST_RESULT();
+}
@@ -0,0 +1,74 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Scene.h"
+#include "Object.h"
+#include "action/MoveAction.h"
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+
+using namespace Supernova;
+
+//Scene update of 100k running move tweens, batched in tween system against update of each action
+
+#define NUM_TWEENS 100000
+
+static double benchmark(bool batched, int callbackEach){
+    const int frames = 20;
+
+    Scene scene;
+    scene.setBatchedTweens(batched);
+
+    std::vector<Object*> objects;
+    std::vector<MoveAction*> actions;
+    int callbacks = 0;
+
+    for (int i = 0; i < NUM_TWEENS; i++){
+        Object* object = new Object();
+        scene.addObject(object);
+
+        MoveAction* action = new MoveAction(Vector3(10, 0, 0), 2, true);
+        if (callbackEach > 0 && i % callbackEach == 0){
+            action->onUpdate = [&callbacks](Object* object, float interval){
+                callbacks++;
+            };
+        }
+        object->addAction(action);
+        action->run();
+
+        objects.push_back(object);
+        actions.push_back(action);
+    }
+
+    scene.update();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int f = 0; f < frames; f++)
+        scene.update();
+
+    double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / frames;
+
+    for (size_t i = 0; i < objects.size(); i++){
+        delete objects[i];
+        delete actions[i];
+    }
+
+    return time;
+}
+
+int main(){
+    int callbackEach[] = {0, 100, 1};
+
+    for (int c = 0; c < 3; c++){
+        double single = benchmark(false, callbackEach[c]);
+        double batched = benchmark(true, callbackEach[c]);
+
+        printf("Tweens %d (onUpdate in %s): each action %8.3f ms, batched %8.3f ms\n",
+               NUM_TWEENS, (callbackEach[c] == 0) ? "none" : (callbackEach[c] == 1) ? "all" : "1%", single, batched);
+    }
+
+    return 0;
+}
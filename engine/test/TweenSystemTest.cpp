@@ -0,0 +1,88 @@
+//
+// (c) 2020 Eduardo Doria.
+//
+
+#include "Test.h"
+#include "Scene.h"
+#include "Object.h"
+#include "action/MoveAction.h"
+
+using namespace Supernova;
+
+//Batched tween callbacks: functions subscribed while scheduled and actions deleted by other callbacks
+
+static MoveAction* addMove(Object* object){
+    MoveAction* action = new MoveAction(Vector3(10, 0, 0), 10);
+    object->addAction(action);
+    action->run();
+    return action;
+}
+
+int main(){
+    Scene scene;
+    Object* objectA = new Object();
+    Object* objectB = new Object();
+    Object* objectC = new Object();
+    scene.addObject(objectA);
+    scene.addObject(objectB);
+    scene.addObject(objectC);
+
+    MoveAction* actionA = addMove(objectA);
+    MoveAction* actionB = addMove(objectB);
+    MoveAction* actionC = addMove(objectC);
+
+    //First update is in object, then actions are batched
+    scene.update();
+    S_CHECK(scene.getBatchedTweens() == 3);
+
+    int updatesA = 0;
+    actionA->onUpdate = [&updatesA](Object* object, float interval){
+        updatesA++;
+    };
+
+    scene.update();
+    S_CHECK(updatesA == 1);
+    S_CHECK(scene.getBatchedTweens() == 3);
+
+    //First called callback deletes the other action
+    int callbacks = 0;
+    actionB->onUpdate = [&](Object* object, float interval){
+        callbacks++;
+        if (actionC){
+            objectC->removeAction(actionC);
+            delete actionC;
+            actionC = NULL;
+        }
+    };
+    actionC->onUpdate = [&](Object* object, float interval){
+        callbacks++;
+        if (actionB){
+            objectB->removeAction(actionB);
+            delete actionB;
+            actionB = NULL;
+        }
+    };
+
+    scene.update();
+    S_CHECK(callbacks == 1);
+    S_CHECK(scene.getBatchedTweens() == 2);
+    S_CHECK(updatesA == 2);
+
+    scene.update();
+    S_CHECK(callbacks == 2);
+
+    objectA->removeAction(actionA);
+    delete actionA;
+    if (actionB)
+        objectB->removeAction(actionB);
+    delete actionB;
+    if (actionC)
+        objectC->removeAction(actionC);
+    delete actionC;
+
+    delete objectA;
+    delete objectB;
+    delete objectC;
+
+    return S_TEST_RESULT();
+}
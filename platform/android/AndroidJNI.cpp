@@ -105,6 +105,12 @@ JNIEXPORT void JNICALL Java_com_deslon_supernova_JNIWrapper_system_1resume(JNIEn
 	Supernova::Engine::systemResume();
 }
 
+JNIEXPORT void JNICALL Java_com_deslon_supernova_JNIWrapper_system_1shutdown(JNIEnv * env, jclass cls){
+	UNUSED(env);
+	UNUSED(cls);
+	Supernova::Engine::systemShutdown();
+}
+
 JNIEXPORT void JNICALL Java_com_deslon_supernova_JNIWrapper_system_1touch_1start(JNIEnv * env, jclass cls, jint pointer, jfloat x, jfloat y) {
 	UNUSED(env);
 	UNUSED(cls);
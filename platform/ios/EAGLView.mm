@@ -90,9 +90,8 @@
 
 - (void)render:(CADisplayLink*)displayLink {
 
-    Supernova::Engine::systemDraw();
-    
-    [_context presentRenderbuffer:GL_RENDERBUFFER];
+    if (Supernova::Engine::systemDraw())
+        [_context presentRenderbuffer:GL_RENDERBUFFER];
     
 }
 
@@ -141,6 +140,7 @@
 
 - (void)dealloc
 {
+    Supernova::Engine::systemShutdown();
     
     if ([EAGLContext currentContext] == _context) {
         [EAGLContext setCurrentContext:nil];
@@ -22,6 +22,8 @@ public class JNIWrapper {
 	public static native void system_pause();
 
 	public static native void system_resume();
+
+	public static native void system_shutdown();
 	
 	public static native void system_touch_start(int pointer, float x, float y);
 	
@@ -221,6 +221,13 @@ public class MainActivity extends Activity {
 		JNIWrapper.system_resume();
 	}
 
+	@Override
+	protected void onDestroy() {
+		JNIWrapper.system_shutdown();
+
+		super.onDestroy();
+	}
+
 	public void showSoftKeyboard(){
 		edittext.showKeyboard();
 	}